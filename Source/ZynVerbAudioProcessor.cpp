@@ -20,9 +20,17 @@
 
 
 
+static_assert(static_cast<int>(ZynVerbAudioProcessor::numReverbAlgorithms) <= static_cast<int>(ZynVerbParameters::algorithmSlots),
+			  "Out of Engine parameter slots, which can't grow without moving every stored engine");
+
+constexpr Zen::ParameterSpec ZynVerbParameters::specs[];
+
 //==============================================================================
 ZynVerbAudioProcessor::ZynVerbAudioProcessor()
-	//:rootTree("Root")
+	: presetBank(params.getIds(), params.getDefaultValues(), params.size()),
+	  pendingProgram(-1),
+	  modulation(ZynVerbParameters::numParameters)
+	//,rootTree("Root")
 {
 //	DBGM("In ZynVerbAudioProcessor::ZynVerbAudioProcessor() ");
 
@@ -32,10 +40,21 @@ ZynVerbAudioProcessor::ZynVerbAudioProcessor()
 	//_crtBreakAlloc = 307;	//Break on this memory allocation number (When Debug)
 #endif
 
-	addParameter(audioGainParam = new DecibelParameter(
-		"Gain", true, 0.01f, -96.0f, 12.0f, 0.0f, 0.0f, 1.0f, 0.5f, 0.5f, 0.01f, "dB"));
-	addParameter(muteParam = new BooleanParameter("Mute", false));
-	addParameter(bypassParam = new BooleanParameter("Bypass", false));
+	params.createParameters(*this);
+
+	// From here on every change reaches the audio thread as a timestamped event
+	for (auto zenParam : params)
+		zenParam->setEventQueue(&parameterEvents);
+
+	blockEvents.malloc(Zen::ParameterEventQueue::capacity);
+
+	// Stepped parameters would switch engine, bypass or latency at control rate, so only continuous ones are targets
+	for (int i = 0; i < ZynVerbParameters::numParameters; ++i)
+		modulation.setTargetAllowed(i, ZynVerbParameters::Registry::isContinuous(i));
+
+	// Reading the library is file I/O, so it waits for the message loop rather than holding up instantiation
+	defaultPresetLibraryPending = true;
+	triggerAsyncUpdate();
 
 #ifdef ZEN_DEBUG
 	rootTree = createParameterTree();
@@ -50,9 +69,7 @@ ZynVerbAudioProcessor::ZynVerbAudioProcessor()
 ZynVerbAudioProcessor::~ZynVerbAudioProcessor()
 {
 //	DBGM("In ZynVerbAudioProcessor::~ZynVerbAudioProcessor() ");	
-	audioGainParam = nullptr;
-	muteParam = nullptr;
-	bypassParam = nullptr;
+	cancelPendingUpdate();
 
 	rootTree.removeAllChildren(nullptr);
 	debugWindow = nullptr;
@@ -70,76 +87,273 @@ void ZynVerbAudioProcessor::processBlock(AudioSampleBuffer& buffer, MidiBuffer&
 {
 	setCurrentSampleRate(getSampleRate());
 
-#pragma region MIDI Example
-	/* MIDI handling example
-	MidiMessage mm;
-	MidiBuffer processedMidi;
-	int samplePos;
-
-	for (MidiBuffer::Iterator mbi(midiMessages); mbi.getNextEvent(mm, samplePos); )
+	// Learned CCs take the same timestamped path as host automation, so each lands on its own sample below
+	midiControllers.dispatchControllers(midiMessages, [this](int parameterIndex, float value, int samplePosition)
 	{
+		if (parameterIndex < params.size())
+			params[parameterIndex]->setValueAtSample(value, samplePosition);
+	});
 
-		if (mm.isNoteOnOrOff())
-		{
-			//ZEN_LABEL_TRACE("MidiBuffer.isNoteOnOrOff", S(mm.isNoteOnOrOff()));
-		} 
-		if (mm.isNoteOn())
-		{
-			uint8 newVel = static_cast<uint8>(mm.getVelocity());
+	jassert(currentSampleRate >= 0);
 
-			// Changing output buffer
-			mm = MidiMessage::noteOn(mm.getChannel(), mm.getNoteNumber(), newVel);
-		} else if (mm.isNoteOff())
-		{
-			ZEN_REMOVE_LABEL_TRACE("MidiBuffer.getNoteNumber(" + S(noteNumber) + "):");
-		} else if (mm.isAftertouch())
+	const int numSamples = buffer.getNumSamples();
+	beginPendingProgramChange();
+	const int numEvents = collectParameterEvents(numSamples);
+	int eventIndex = 0;
+
+	// With no route active there are no control ticks to split at, only events
+	const bool modulating = modulation.hasActiveRoutes();
+
+	if (!modulating && modulationActive)
+		clearModulation();
+
+	modulationActive = modulating;
+
+	// The block is split at every event offset, so a change lands on its own sample whatever the host's block size,
+	// and at every modulation control tick.  Each event or tick retargets its parameters' smoothers, and the next
+	// segment's ramp starts from where they had got to
+	for (int segmentStart = 0; segmentStart < numSamples;)
+	{
+		while (eventIndex < numEvents && blockEvents[eventIndex].sampleOffset <= segmentStart)
 		{
-		} else if (mm.isPitchWheel())
+			const Zen::ParameterEvent& event = blockEvents[eventIndex++];
+			params[event.parameterIndex]->applyEvent(event.value);
+		}
+
+		int segmentEnd = numSamples;
+
+		if (modulating)
 		{
+			if (modulationCountdown == 0)
+			{
+				updateModulation(buffer, segmentStart, jmin(static_cast<int>(Zen::ModulationMatrix::controlInterval), numSamples - segmentStart));
+				modulationCountdown = Zen::ModulationMatrix::controlInterval;
+			}
+
+			segmentEnd = jmin(numSamples, segmentStart + modulationCountdown);
 		}
-		//add the newly calculated event to new buffer
-		processedMidi.addEvent(mm, samplePos);
+
+		if (eventIndex < numEvents)
+			segmentEnd = jmin(segmentEnd, blockEvents[eventIndex].sampleOffset);
+
+		processSegment(buffer, segmentStart, segmentEnd - segmentStart);
+
+		if (modulating)
+			modulationCountdown -= segmentEnd - segmentStart;
+
+		segmentStart = segmentEnd;
 	}
-	//put the new midi msg buffer onto the buffer to be exported
-	midiMessages.swapWith(processedMidi);
-	*/
-#pragma endregion
 
-	jassert(currentSampleRate >= 0);
+	// Only reached by events in an empty block
+	for (; eventIndex < numEvents; ++eventIndex)
+		params[blockEvents[eventIndex].parameterIndex]->applyEvent(blockEvents[eventIndex].value);
 
-	if (bypassParam->isOn()) return;
+	applyProgramFade(buffer);
+}
+
+void ZynVerbAudioProcessor::updateModulation(const AudioSampleBuffer& buffer, int startSample, int numSamples)
+{
+	const int numChannels = buffer.getNumChannels();
 
-	float* leftData = buffer.getWritePointer(0);	//leftData references left channel now
-	float* rightData = buffer.getWritePointer(1); //right data references right channel now
+	if (numChannels > 0)
+		modulation.advance(buffer.getReadPointer(0, startSample), buffer.getReadPointer(jmin(1, numChannels - 1), startSample), numSamples);
+	else
+		modulation.advance(nullptr, nullptr, 0);
 
-	//Audio buffer visualization
-	ZEN_DEBUG_BUFFER("Left Buffer Pre", leftData, buffer.getNumSamples(), -1, 1);
-	ZEN_DEBUG_BUFFER("Right Buffer Pre", rightData, buffer.getNumSamples(), -1, 1);
+	const float* const offsets = modulation.getOffsets();
+
+	for (int i = 0; i < ZynVerbParameters::numParameters; ++i)
+		params[i]->setModulation(offsets[i]);
+}
+
+void ZynVerbAudioProcessor::clearModulation()
+{
+	// The smoothers glide back from the last offsets, and the next route to be switched on starts with a fresh tick
+	for (auto zenParam : params)
+		zenParam->setModulation(0.0f);
+
+	modulation.reset();
+	modulationCountdown = 0;
+}
+
+void ZynVerbAudioProcessor::beginPendingProgramChange()
+{
+	if (programFadeRemaining > 0)
+		return;
+
+	const int program = pendingProgram.exchange(-1);
+
+	if (program < 0)
+		return;
+
+	programFadingIn = false;
+	programFadeRemaining = programFadeSamples;
+}
+
+void ZynVerbAudioProcessor::applyProgramFade(AudioSampleBuffer& buffer)
+{
+	if (programFadeRemaining <= 0)
+		return;
+
+	const int numSamples = buffer.getNumSamples();
+	const int numToFade = jmin(numSamples, programFadeRemaining);
+	const float startGain = static_cast<float>(programFadeRemaining) / programFadeSamples;
+	const float endGain = static_cast<float>(programFadeRemaining - numToFade) / programFadeSamples;
+
+	programFadeRemaining -= numToFade;
+
+	if (programFadingIn)
+	{
+		buffer.applyGainRamp(0, numToFade, 1.0f - startGain, 1.0f - endGain);
+
+		if (programFadeRemaining == 0)
+			programFadingIn = false;
+
+		return;
+	}
+
+	buffer.applyGainRamp(0, numToFade, startGain, endGain);
+
+	if (programFadeRemaining > 0)
+		return;
+
+	// Silent from here until the next block, which starts fading the new program in
+	if (numToFade < numSamples)
+		buffer.clear(numToFade, numSamples - numToFade);
+
+	applyProgramSnapshot();
+	programFadingIn = true;
+	programFadeRemaining = programFadeSamples;
+}
+
+void ZynVerbAudioProcessor::applyProgramSnapshot()
+{
+	// setCurrentProgram() stored the snapshot in the parameters' atomics, and automation since then has landed on
+	// top of it there.  That includes events applied during the fade out, which would be lost if the snapshot
+	// itself were applied now, so the new program starts from the atomics
+	for (auto zenParam : params)
+		zenParam->syncProcessingValue();
+
+	resetEngines();
+}
+
+void ZynVerbAudioProcessor::resetEngines()
+{
+	fdnReverb.reset();
+	convolutionReverb.reset();
+	roomReverb.reset();
+	plateReverb.reset();
+	earlyReflections.reset();
+}
 
-	if (muteParam->isOn())
+int ZynVerbAudioProcessor::collectParameterEvents(int numSamples)
+{
+	// Lost events can't be replayed, but the parameters' atomics still hold their latest values
+	if (parameterEvents.checkAndClearOverflow())
 	{
-		buffer.applyGain(0.0f);
+		for (auto zenParam : params)
+			zenParam->syncProcessingValue();
+	}
+
+	const int lastSample = jmax(0, numSamples - 1);
+	int numEvents = 0;
+	Zen::ParameterEvent event;
+
+	while (numEvents < Zen::ParameterEventQueue::capacity && parameterEvents.pop(event))
+	{
+		if (!isPositiveAndBelow(event.parameterIndex, params.size()))
+			continue;
+
+		event.sampleOffset = jlimit(0, lastSample, event.sampleOffset);
+
+		// Insertion sort: events mostly arrive in order, and equal offsets keep their arrival order
+		int position = numEvents++;
+
+		for (; position > 0 && blockEvents[position - 1].sampleOffset > event.sampleOffset; --position)
+			blockEvents[position] = blockEvents[position - 1];
+
+		blockEvents[position] = event;
+	}
+
+	return numEvents;
+}
+
+void ZynVerbAudioProcessor::processSegment(AudioSampleBuffer& buffer, int startSample, int numSamples)
+{
+	if (params.get<ZynVerbParameters::bypass>()->isProcessingOn() || buffer.getNumChannels() == 0) return;
+
+	if (params.get<ZynVerbParameters::mute>()->isProcessingOn())
+	{
+		buffer.applyGain(startSample, numSamples, 0.0f);
 		return;
 	}
 
-	//Main Processing Loop
-	for (long i = 0; i < buffer.getNumSamples(); i++)
+	if (buffer.getNumChannels() >= 2)
 	{
-		//Make sure screwups don't blow up speakers
-		float audioGainRaw = getClamped(audioGainParam->getSmoothedRawDecibelGainValue(), 0, 4.0f); 
-		jassert(audioGainRaw >= 0);
-		ZEN_LABEL_TRACE("audioGainRaw", S(audioGainRaw));
-		ZEN_LABEL_TRACE("Left", S(leftData[i]));
-		ZEN_LABEL_TRACE("Right", S(rightData[i]));
-
-		BufferSampleProcesses::processGain(&leftData[i], &rightData[i], audioGainRaw);
+		// Mono in, stereo out: both reverb inputs get the one input channel
+		if (getNumInputChannels() == 1)
+			buffer.copyFrom(1, startSample, buffer, 0, startSample, numSamples);
+
+		processStereo(buffer.getWritePointer(0, startSample), buffer.getWritePointer(1, startSample), numSamples);
+		return;
 	}
 
-	//Audio buffer visualization 
+	// Mono bus: the reverbs always run stereo, so the right side lives in scratch and is folded back
+	float* const monoData = buffer.getWritePointer(0, startSample);
+	float* const rightData = monoScratch.getWritePointer(0);
+	const int scratchSize = monoScratch.getNumSamples();
 
-	ZEN_DEBUG_BUFFER("Left Buffer Post", leftData, buffer.getNumSamples(), -1, 1);
-	ZEN_DEBUG_BUFFER("Right Buffer Post", rightData, buffer.getNumSamples(), -1, 1);
+	for (int position = 0; position < numSamples; position += scratchSize)
+	{
+		const int numToDo = jmin(scratchSize, numSamples - position);
 
+		FloatVectorOperations::copy(rightData, monoData + position, numToDo);
+		processStereo(monoData + position, rightData, numToDo);
+		FloatVectorOperations::add(monoData + position, rightData, numToDo);
+		FloatVectorOperations::multiply(monoData + position, 0.5f, numToDo);
+	}
+}
+
+void ZynVerbAudioProcessor::processStereo(float* leftData, float* rightData, int numSamples)
+{
+	//Audio buffer visualization
+	ZEN_DEBUG_BUFFER("Left Buffer Pre", leftData, numSamples, -1, 1);
+	ZEN_DEBUG_BUFFER("Right Buffer Pre", rightData, numSamples, -1, 1);
+
+	//Reverb runs on the whole block, parameters are picked up once per block
+	processReverb(leftData, rightData, numSamples);
+
+	//Gain is smoothed a block at a time: a vector multiply by the ramp while it moves, by a constant otherwise
+	float* const gains = gainRamp.getWritePointer(0);
+	const int rampSize = gainRamp.getNumSamples();
+	Zen::DecibelParameter* const gainParam = params.get<ZynVerbParameters::gain>();
+
+	for (int position = 0; position < numSamples; position += rampSize)
+	{
+		const int numToDo = jmin(rampSize, numSamples - position);
+
+		if (gainParam->getSmoothedRawDecibelGainBlock(gains, numToDo))
+		{
+			//Make sure screwups don't blow up speakers
+			FloatVectorOperations::min(gains, gains, 4.0f, numToDo);
+			FloatVectorOperations::multiply(leftData + position, gains, numToDo);
+			FloatVectorOperations::multiply(rightData + position, gains, numToDo);
+		}
+		else
+		{
+			const float audioGainRaw = getClamped(gainParam->getSmoothedRawDecibelGainTarget(), 0, 4.0f);
+			jassert(audioGainRaw >= 0);
+			ZEN_LABEL_TRACE("audioGainRaw", S(audioGainRaw));
+
+			FloatVectorOperations::multiply(leftData + position, audioGainRaw, numToDo);
+			FloatVectorOperations::multiply(rightData + position, audioGainRaw, numToDo);
+		}
+	}
+
+	//Audio buffer visualization 
+
+	ZEN_DEBUG_BUFFER("Left Buffer Post", leftData, numSamples, -1, 1);
+	ZEN_DEBUG_BUFFER("Right Buffer Post", rightData, numSamples, -1, 1);
 }
 
 // You should use this method to store your parameterSet in the memory block.
@@ -147,15 +361,23 @@ void ZynVerbAudioProcessor::getStateInformation(MemoryBlock& destData)
 {
 //	DBGM("In ZynVerbAudioProcessor::getStateInformation() ");
 
-	XmlElement rootXML("Root");
+	MemoryBlock controllerState, modulationState;
+	midiControllers.writeState(controllerState, params.getIds(), params.size());
+	modulation.writeState(modulationState, params.getIds(), params.size());
 
-	for (auto param : getParameters())
-	{
-		ZenParameter* zenParam = dynamic_cast<ZenParameter*>(param);
-		zenParam->writeToXML(rootXML);
-	}
-	//DBG(rootXML.createDocument("", false, false, "UTF-8", 120));
-	copyXmlToBinary(rootXML, destData);
+	// The path is stored as UTF-8, which is how String holds it, so nothing is converted or copied
+	Zen::ParameterState::Blob blobs[3];
+	int numBlobs = 0;
+
+	if (impulsePath.isNotEmpty())
+		blobs[numBlobs++] = { impulsePathTag, impulsePath.toRawUTF8(), static_cast<uint32>(impulsePath.getNumBytesAsUTF8()) };
+
+	if (controllerState.getSize() > 0)
+		blobs[numBlobs++] = { midiControllersTag, controllerState.getData(), static_cast<uint32>(controllerState.getSize()) };
+
+	blobs[numBlobs++] = { modulationTag, modulationState.getData(), static_cast<uint32>(modulationState.getSize()) };
+
+	Zen::ParameterStateWriter::write(destData, params.begin(), params.getIds(), params.size(), blobs, numBlobs);
 }
 
 // You should use this method to restore your parameters from this memory block,
@@ -164,28 +386,242 @@ void ZynVerbAudioProcessor::setStateInformation(const void* data, int sizeInByte
 {
 //	DBGM("In ZynVerbAudioProcessor::setStateInformation() ");
 
+	const Zen::ParameterStateReader state(data, sizeInBytes);
+
+	if (state.isValid())
+	{
+		state.applyTo(params.begin(), params.getIds(), params.size());
+
+		const uint32 legacyAlgorithmId = ZynVerbParameters::legacyAlgorithmId;
+		float legacyAlgorithm;
+
+		if (state.readValues(&legacyAlgorithm, &legacyAlgorithmId, 1) == 1)
+			restoreLegacyAlgorithm(legacyAlgorithm);
+
+		// Hosts restore state for every undo step, so only reload the impulse when it's actually a different file
+		Zen::ParameterState::Blob impulseBlob;
+
+		if (state.findBlob(impulsePathTag, impulseBlob))
+		{
+			const String path(String::fromUTF8(static_cast<const char*>(impulseBlob.data), static_cast<int>(impulseBlob.size)));
+
+			if (path != impulsePath)
+				loadImpulseResponse(File(path));
+		}
+
+		// A state without the blob had no mappings
+		Zen::ParameterState::Blob controllerBlob = { midiControllersTag, nullptr, 0 };
+		state.findBlob(midiControllersTag, controllerBlob);
+		midiControllers.restoreState(controllerBlob.data, controllerBlob.size, params.getIds(), params.size());
+
+		// Nor modulation routes
+		Zen::ParameterState::Blob modulationBlob = { modulationTag, nullptr, 0 };
+		state.findBlob(modulationTag, modulationBlob);
+		modulation.restoreState(modulationBlob.data, modulationBlob.size, params.getIds(), params.size());
+
+		return;
+	}
+
+	// A binary state from a newer version can't be read, and isn't XML either
+	if (Zen::ParameterStateReader::isBinaryState(data, sizeInBytes))
+		return;
+
+	// Sessions saved before the binary format
 	ScopedPointer<XmlElement> theXML = this->getXmlFromBinary(data, sizeInBytes);
 	//DBG(theXML->createDocument("", false, false, "UTF-8", 120));
 
 	if (theXML != nullptr)
 	{
-		for (auto param : getParameters())
-		{
-			ZenParameter* zenParam = dynamic_cast<ZenParameter*>(param);
-			if(zenParam != nullptr) zenParam->setFromXML(*theXML);
-		}
+		for (auto zenParam : params)
+			zenParam->setFromXML(*theXML);
+
+		if (const XmlElement* legacyAlgorithm = theXML->getChildByName("Algorithm"))
+			restoreLegacyAlgorithm(static_cast<float>(legacyAlgorithm->getDoubleAttribute("parameterValue")));
 	}
 }
 
-ValueTree ZynVerbAudioProcessor::createParameterTree()
+void ZynVerbAudioProcessor::processReverb(float* leftData, float* rightData, int numSamples)
 {
-	ValueTree valTree("Parameters");
+	const ReverbAlgorithm selectedAlgorithm = getSelectedAlgorithm();
+
+	if (selectedAlgorithm != currentAlgorithm)
+	{
+		// Don't let a stale tail from the last time this engine ran leak out
+		currentAlgorithm = selectedAlgorithm;
+		resetEngines();
+		updateLatencyForAlgorithm();
+	}
+
+	if (currentAlgorithm == convolutionAlgorithm)
+	{
+		// The impulse carries its own early reflections, and the engine mixes its own latency-matched dry path.
+		// Switching modes rebuilds the convolvers, which can't happen here.  Posted once per change, not every block
+		// until the message thread gets to it
+		if (params.get<ZynVerbParameters::zeroLatency>()->isOn() != convolutionReverb.isZeroLatency()
+			&& !zeroLatencyChangeRequested.exchange(true))
+			triggerAsyncUpdate();
+
+		// Hosts may switch to an offline bounce between any two blocks, not only in prepareToPlay
+		convolutionReverb.setNonRealtime(isNonRealtime());
+		convolutionReverb.setMix(params.get<ZynVerbParameters::mix>()->getProcessingValue());
+		convolutionReverb.processStereo(leftData, rightData, numSamples);
+		return;
+	}
+
+	processAlgorithmicReverb(leftData, rightData, numSamples);
+}
+
+void ZynVerbAudioProcessor::processAlgorithmicReverb(float* leftData, float* rightData, int numSamples)
+{
+	const float size = params.get<ZynVerbParameters::size>()->getProcessingValue();
+	const float decay = params.get<ZynVerbParameters::decay>()->getProcessingValue();
+	const float damping = params.get<ZynVerbParameters::damping>()->getProcessingValue();
+	const float mix = params.get<ZynVerbParameters::mix>()->getProcessingValue();
+
+	earlyReflections.setParameters(size, params.get<ZynVerbParameters::earlyDensity>()->getProcessingValue());
+
+	switch (currentAlgorithm)
+	{
+		case roomAlgorithm:		roomReverb.setParameters(size, decay, damping, 1.0f);	break;
+		case plateAlgorithm:	plateReverb.setParameters(size, decay, damping, 1.0f);	break;
+		case fdnAlgorithm:
+		default:
+			fdnReverb.setParameters(size, decay, damping, 1.0f);
+			fdnReverb.setDecayBands(params.get<ZynVerbParameters::lowDecay>()->getProcessingValue(), params.get<ZynVerbParameters::highDecay>()->getProcessingValue(),
+									params.get<ZynVerbParameters::lowCrossover>()->getProcessingValue(), params.get<ZynVerbParameters::highCrossover>()->getProcessingValue());
+			break;
+	}
+
+	float* const dryLeft = dryBuffer.getWritePointer(0);
+	float* const dryRight = dryBuffer.getWritePointer(1);
+	float* const earlyLeft = earlyBuffer.getWritePointer(0);
+	float* const earlyRight = earlyBuffer.getWritePointer(1);
+	const int scratchSize = earlyBuffer.getNumSamples();
+
+	for (int position = 0; position < numSamples; position += scratchSize)
+	{
+		float* const left = leftData + position;
+		float* const right = rightData + position;
+		const int numToDo = jmin(scratchSize, numSamples - position);
+
+		FloatVectorOperations::copy(dryLeft, left, numToDo);
+		FloatVectorOperations::copy(dryRight, right, numToDo);
+
+		// The tail hears the reflections as well as the direct sound
+		earlyReflections.process(dryLeft, dryRight, earlyLeft, earlyRight, numToDo);
+		FloatVectorOperations::add(left, earlyLeft, numToDo);
+		FloatVectorOperations::add(right, earlyRight, numToDo);
+
+		processTail(left, right, numToDo);
+
+		FloatVectorOperations::add(left, earlyLeft, numToDo);
+		FloatVectorOperations::multiply(left, mix, numToDo);
+		FloatVectorOperations::addWithMultiply(left, dryLeft, 1.0f - mix, numToDo);
+
+		FloatVectorOperations::add(right, earlyRight, numToDo);
+		FloatVectorOperations::multiply(right, mix, numToDo);
+		FloatVectorOperations::addWithMultiply(right, dryRight, 1.0f - mix, numToDo);
+	}
+}
+
+void ZynVerbAudioProcessor::processTail(float* leftData, float* rightData, int numSamples)
+{
+	switch (currentAlgorithm)
+	{
+		case roomAlgorithm:		roomReverb.processStereo(leftData, rightData, numSamples);	break;
+		case plateAlgorithm:	plateReverb.processStereo(leftData, rightData, numSamples);	break;
+		case fdnAlgorithm:
+		default:				fdnReverb.processStereo(leftData, rightData, numSamples);	break;
+	}
+}
+
+ZynVerbAudioProcessor::ReverbAlgorithm ZynVerbAudioProcessor::getSelectedAlgorithm() const
+{
+	const int index = params.get<ZynVerbParameters::algorithm>()->getProcessingIndex();
+	return static_cast<ReverbAlgorithm>(jlimit(0, numReverbAlgorithms - 1, index));
+}
+
+void ZynVerbAudioProcessor::restoreLegacyAlgorithm(float legacyValue)
+{
+	const int legacyNumAlgorithms = 4;
+	const int index = jlimit(0, legacyNumAlgorithms - 1, roundToInt(legacyValue * (legacyNumAlgorithms - 1)));
+	params.get<ZynVerbParameters::algorithm>()->setValue(Zen::ChoiceParameter::getValueForIndex(index, ZynVerbParameters::algorithmSlots));
+}
+
+void ZynVerbAudioProcessor::updateLatencyForAlgorithm()
+{
+	setLatencySamples(currentAlgorithm == convolutionAlgorithm ? convolutionReverb.getLatencySamples() : 0);
+}
+
+void ZynVerbAudioProcessor::handleAsyncUpdate()
+{
+	if (defaultPresetLibraryPending)
+	{
+		defaultPresetLibraryPending = false;
+		const File presetLibrary(getDefaultPresetLibraryFile());
 
-	for (auto param : getParameters())
+		if (presetLibrary.existsAsFile())
+			loadPresetLibrary(presetLibrary);
+	}
+
+	// Cleared first, so the audio thread can ask again if the parameter moves while the convolvers rebuild
+	if (zeroLatencyChangeRequested.exchange(false))
 	{
-		ZenParameter* zenParam = dynamic_cast<ZenParameter*>(param);
-		if(zenParam != nullptr) valTree.addChild(zenParam->getValueTree(), -1, nullptr);
+		convolutionReverb.setZeroLatency(params.get<ZynVerbParameters::zeroLatency>()->isOn(), getCallbackLock());
+		updateLatencyForAlgorithm();
 	}
+}
+
+bool ZynVerbAudioProcessor::loadImpulseResponse(const File& impulseFile)
+{
+	if (!convolutionReverb.loadImpulseResponse(impulseFile, getCallbackLock()))
+		return false;
+
+	impulsePath = impulseFile.getFullPathName();
+	return true;
+}
+
+bool ZynVerbAudioProcessor::loadPresetLibrary(const File& libraryFile)
+{
+	// A library loaded any other way replaces the default one, which mustn't then load over it
+	defaultPresetLibraryPending = false;
+
+	if (!presetBank.loadLibrary(libraryFile))
+		return false;
+
+	currentProgram = 0;
+	updateHostDisplay();
+	return true;
+}
+
+bool ZynVerbAudioProcessor::saveCurrentAsPreset(const String& presetName)
+{
+	MemoryBlock state;
+	Zen::ParameterStateWriter::write(state, params.begin(), params.getIds(), params.size());
+
+	const File libraryFile(getDefaultPresetLibraryFile());
+
+	if (!libraryFile.getParentDirectory().createDirectory().wasOk()
+		|| !Zen::PresetBank::appendToLibrary(libraryFile, presetName, state)
+		|| !loadPresetLibrary(libraryFile))
+		return false;
+
+	currentProgram = presetBank.getNumPresets() - 1;
+	updateHostDisplay();
+	return true;
+}
+
+File ZynVerbAudioProcessor::getDefaultPresetLibraryFile()
+{
+	return File::getSpecialLocation(File::userApplicationDataDirectory).getChildFile("Zentropia/ZynVerb/Presets.znpl");
+}
+
+ValueTree ZynVerbAudioProcessor::createParameterTree()
+{
+	ValueTree valTree("Parameters");
+
+	for (auto zenParam : params)
+		valTree.addChild(zenParam->getValueTree(), -1, nullptr);
 	//DBG("Value Tree result from createParameterTree() : " + valTree.toXmlString());
 	return valTree;
 }
@@ -198,18 +634,42 @@ void ZynVerbAudioProcessor::prepareToPlay(double inSampleRate, int samplesPerBlo
 	// Use this method as the place to do any pre-playback
 	// initialisation that you need..
 
+	// Audio isn't running, so anything still queued is already reflected in the parameters' own values,
+	// and so is a program change that never got its fade
+	parameterEvents.clear();
+	pendingProgram.store(-1);
+	programFadeRemaining = 0;
+	programFadingIn = false;
+	programFadeSamples = jmax(1, roundToInt(0.02 * inSampleRate));
+	modulation.prepare(inSampleRate);
+	modulationCountdown = 0;
+
 	// Iterates over parameters and resets Smooth for the ones who need it
-	for (auto param : getParameters())
+	for (auto zenParam : params)
 	{
-		ZenParameter* zenParam = dynamic_cast<ZenParameter*>(param);
-		if (zenParam != nullptr)
+		zenParam->setModulation(0.0f);
+		zenParam->syncProcessingValue();
+
+		if (zenParam->checkShouldBeSmoothed())
 		{
-			if (zenParam->checkShouldBeSmoothed())
-			{
-				zenParam->resetSmoothedValue(inSampleRate);
-			}
+			zenParam->resetSmoothedValue(inSampleRate);
 		}
 	}
+
+	// All reverb delay memory and FFT plans are allocated here and nowhere else
+	monoScratch.setSize(1, jmax(1, samplesPerBlock));
+	gainRamp.setSize(1, jmax(1, samplesPerBlock));
+	dryBuffer.setSize(2, jmax(1, samplesPerBlock));
+	earlyBuffer.setSize(2, jmax(1, samplesPerBlock));
+	fdnReverb.prepare(inSampleRate, 8);
+	roomReverb.prepare(inSampleRate);
+	plateReverb.prepare(inSampleRate);
+	earlyReflections.prepare(inSampleRate);
+	convolutionReverb.setZeroLatency(params.get<ZynVerbParameters::zeroLatency>()->isOn(), getCallbackLock());
+	convolutionReverb.prepare(inSampleRate, samplesPerBlock);
+
+	currentAlgorithm = getSelectedAlgorithm();
+	updateLatencyForAlgorithm();
 }
 
 //==============================================================================
@@ -264,27 +724,48 @@ bool ZynVerbAudioProcessor::silenceInProducesSilenceOut() const
 
 double ZynVerbAudioProcessor::getTailLengthSeconds() const
 {
-	return 0.0;
+	switch (currentAlgorithm)
+	{
+		case convolutionAlgorithm:	return convolutionReverb.getTailLengthSeconds();
+		case roomAlgorithm:			return roomReverb.getTailLengthSeconds();
+		case plateAlgorithm:		return plateReverb.getTailLengthSeconds();
+		case fdnAlgorithm:
+		default:					return fdnReverb.getTailLengthSeconds();
+	}
 }
 
 int ZynVerbAudioProcessor::getNumPrograms()
 {
-	return 1;	// NB: some hosts don't cope very well if you tell them there are 0 programs,
+	return jmax(1, presetBank.getNumPresets());	// NB: some hosts don't cope very well if you tell them there are 0 programs,
 		// so this should be at least 1, even if you're not really implementing programs.
 }
 
 int ZynVerbAudioProcessor::getCurrentProgram()
 {
-	return 0;
+	return currentProgram;
 }
 
 void ZynVerbAudioProcessor::setCurrentProgram(int index)
 {
+	float snapshot[ZynVerbParameters::numParameters];
+
+	// Copied under the bank's lock, so a library loading on the message thread can't swap it out from under us
+	if (!presetBank.copySnapshot(index, snapshot))
+		return;
+
+	// The host and GUI see the new values straight away; the audio thread applies them once it has faded out.
+	// Nothing here allocates, so it doesn't matter which thread the host calls from
+	currentProgram = index;
+
+	for (int i = 0; i < params.size(); ++i)
+		params[i]->storeValue(snapshot[i]);
+
+	pendingProgram.store(index);
 }
 
 const String ZynVerbAudioProcessor::getProgramName(int index)
 {
-	return String();
+	return presetBank.getPresetName(index);
 }
 
 void ZynVerbAudioProcessor::changeProgramName(int index, const String& newName)
@@ -295,6 +776,15 @@ void ZynVerbAudioProcessor::releaseResources()
 {
 	// When playback stops, you can use this as an opportunity to free up any
 	// spare memory, etc.
+	fdnReverb.release();
+	convolutionReverb.release();
+	roomReverb.release();
+	plateReverb.release();
+	earlyReflections.release();
+	monoScratch.setSize(1, 1);
+	gainRamp.setSize(1, 1);
+	dryBuffer.setSize(2, 1);
+	earlyBuffer.setSize(2, 1);
 }
 
 
@@ -16,16 +16,35 @@
 #define PLUGINPROCESSOR_H_INCLUDED
 
 #include "JuceHeader.h"
-#include "zen_utils/parameters/DecibelParameter.hpp"
-#include "zen_utils/parameters/BooleanParameter.hpp"
+#include "ZynVerbParameters.h"
+#include "zen_utils/parameters/ParameterState.hpp"
+#include "zen_utils/parameters/PresetBank.h"
+#include "zen_utils/parameters/MidiControllerMap.h"
+#include "zen_utils/processing/ModulationMatrix.h"
+#include "zen_utils/processing/reverb/FDNReverb.h"
+#include "zen_utils/processing/reverb/ConvolutionReverb.h"
+#include "zen_utils/processing/reverb/VectorFreeverb.h"
+#include "zen_utils/processing/reverb/PlateReverb.h"
+#include "zen_utils/processing/reverb/EarlyReflections.h"
 #include "zen_utils/debug/ZenDebugEditor.h"
 
 using Zen::ZenDebugEditor;
 
 
-class ZynVerbAudioProcessor : public AudioProcessor
+class ZynVerbAudioProcessor : public AudioProcessor, private AsyncUpdater
 {
 public:
+	/// <summary> Selectable reverb engines, chosen by the Engine parameter, which stores the enum value.  New engines
+	/// go on the end so saved sessions keep their engine. </summary>
+	enum ReverbAlgorithm
+	{
+		fdnAlgorithm = 0,
+		convolutionAlgorithm,
+		roomAlgorithm,	///< Freeverb-class comb/allpass bank, the cheap per-track room
+		plateAlgorithm,	///< Dattorro figure-eight plate with a modulated tank
+		numReverbAlgorithms
+	};
+
 	//==============================================================================
 	ZynVerbAudioProcessor();
 	~ZynVerbAudioProcessor();
@@ -36,10 +55,40 @@ public:
 	void setStateInformation(const void* data, int sizeInBytes) override;
 	//==============================================================================
 		
-	//DO NOT USE SCOPED POINTERS FOR PARAMETERS, they're deleted by the managedParam OwnedArray
-	Zen::DecibelParameter* audioGainParam;		
-	Zen::BooleanParameter* muteParam;
-	Zen::BooleanParameter* bypassParam;
+	/// <summary> Typed access by ZynVerbParameters index, e.g. getParameterRegistry().get<ZynVerbParameters::gain>() </summary>
+	const ZynVerbParameters::Registry& getParameterRegistry() const { return params; }
+
+	/// <summary> The engine the Engine parameter selects, for the audio thread </summary>
+	ReverbAlgorithm getSelectedAlgorithm() const;
+
+	/// <summary> Loads an impulse response file into the convolution engine and remembers it for the saved state.
+	/// Message thread only. </summary>
+	bool loadImpulseResponse(const File& impulseFile);
+
+	/// <summary> Queue every parameter change goes through on its way to the audio thread.  Producers that know the
+	/// sample a change belongs on should use ZenParameter::setValueAtSample() rather than pushing here directly. </summary>
+	Zen::ParameterEventQueue& getParameterEventQueue() { return parameterEvents; }
+
+	/// <summary> Replaces the program list with the presets in libraryFile.  Message thread only. </summary>
+	bool loadPresetLibrary(const File& libraryFile);
+
+	/// <summary> Adds the current parameter values to the default preset library as a new last preset, creating the
+	/// library if there isn't one, and makes it the current program.  Message thread only. </summary>
+	bool saveCurrentAsPreset(const String& presetName);
+
+	/// <summary> Where the preset library is looked for once the message loop first runs after construction, and
+	/// where saveCurrentAsPreset() writes </summary>
+	static File getDefaultPresetLibraryFile();
+
+	/// <summary> LFO, envelope follower and routing setup.  Its setters are message thread only; routes target
+	/// parameters by ZynVerbParameters index. </summary>
+	Zen::ModulationMatrix& getModulationMatrix() { return modulation; }
+
+	/// <summary> CC learn and mappings.  Message thread only; mappings are saved with the state. </summary>
+	Zen::MidiControllerMap& getMidiControllerMap() { return midiControllers; }
+
+	/// <summary> Read-only access for partition layout, worker schedule and timing diagnostics </summary>
+	const Zen::ConvolutionReverb& getConvolutionReverb() const { return convolutionReverb; }
 
 		
 
@@ -85,10 +134,79 @@ private:
 	float currSampleRate = 44100.0f;	
 	ValueTree rootTree;
 	ScopedPointer<ZenDebugEditor> debugWindow;
+	Zen::FDNReverb fdnReverb;
+	Zen::ConvolutionReverb convolutionReverb;
+	Zen::VectorFreeverb roomReverb;
+	Zen::PlateReverb plateReverb;
+	Zen::EarlyReflections earlyReflections;
+	ReverbAlgorithm currentAlgorithm = fdnAlgorithm;
+	AudioSampleBuffer monoScratch;	///< Right channel stand-in when the host runs a mono bus
+	AudioSampleBuffer gainRamp;		///< Smoothed output gain for one block
+	AudioSampleBuffer dryBuffer, earlyBuffer;	///< Stereo scratch for the algorithmic engines' mix
+	ZynVerbParameters::Registry params;
+	String impulsePath;	///< Last impulse loaded, saved as a state blob
+	std::atomic<bool> zeroLatencyChangeRequested{ false };	///< Set by the audio thread, cleared by handleAsyncUpdate()
+	Zen::PresetBank presetBank;
+	bool defaultPresetLibraryPending = false;	///< Message thread only, loaded by handleAsyncUpdate()
+
+	// Program changes fade the output out, apply the preset's snapshot in silence and fade back in
+	int currentProgram = 0;
+	std::atomic<int> pendingProgram;	///< Set by setCurrentProgram(), taken by the audio thread, -1 when none
+	int programFadeSamples = 1, programFadeRemaining = 0;
+	bool programFadingIn = false;
+	static const uint32 impulsePathTag = Zen::makeStateTag('I', 'R', 'p', 't');
+	static const uint32 midiControllersTag = Zen::makeStateTag('M', 'C', 'C', 'm');
+	static const uint32 modulationTag = Zen::makeStateTag('M', 'o', 'd', 'm');
+	Zen::MidiControllerMap midiControllers;
+	Zen::ParameterEventQueue parameterEvents;
+	HeapBlock<Zen::ParameterEvent> blockEvents;	///< This block's events in sample order
+	Zen::ModulationMatrix modulation;	///< Routes target params by their ZynVerbParameters index
+	int modulationCountdown = 0;		///< Samples left until the next control tick, carried across blocks
+	bool modulationActive = false;		///< Any route was active last block, audio thread only
 
 	//Private Methods=======================================================================
 	ValueTree createParameterTree();
 
+	/// <summary> Drains the event queue into blockEvents, sorted by sample offset and clamped into the block.
+	/// Returns the number of events. </summary>
+	int collectParameterEvents(int numSamples);
+
+	/// <summary> Starts a program change fade if one was requested and none is running </summary>
+	void beginPendingProgramChange();
+
+	/// <summary> Applies the program change fade to a processed block, switching programs at its silent midpoint </summary>
+	void applyProgramFade(AudioSampleBuffer& buffer);
+
+	/// <summary> Makes the new program's values current on the audio thread and clears the engines' old tails </summary>
+	void applyProgramSnapshot();
+	void resetEngines();
+
+	/// <summary> Runs a modulation control tick over the input from startSample and hands the new offsets to the
+	/// parameters, whose smoothers then glide to them </summary>
+	void updateModulation(const AudioSampleBuffer& buffer, int startSample, int numSamples);
+
+	/// <summary> Zeroes every parameter's modulation once the last route is switched off </summary>
+	void clearModulation();
+
+	/// <summary> Processes numSamples from startSample with the parameters fixed as they are now </summary>
+	void processSegment(AudioSampleBuffer& buffer, int startSample, int numSamples);
+	void processStereo(float* leftData, float* rightData, int numSamples);
+	void processReverb(float* leftData, float* rightData, int numSamples);
+
+	/// <summary> Early reflections feed the selected algorithmic tail engine, which runs fully wet.
+	/// Dry, early and tail are mixed here. </summary>
+	void processAlgorithmicReverb(float* leftData, float* rightData, int numSamples);
+	void processTail(float* leftData, float* rightData, int numSamples);
+	void updateLatencyForAlgorithm();
+
+	/// <summary> Carries a session's pre-choice Algorithm value over to Engine.  It was spread over the engines of
+	/// the day, so it is read as it was last stored, with four. </summary>
+	void restoreLegacyAlgorithm(float legacyValue);
+
+	/// <summary> Loads the default preset library after construction, and applies convolution mode changes, which
+	/// reallocate, on the message thread </summary>
+	void handleAsyncUpdate() override;
+
 	//JUCE Internal=========================================================================
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ZynVerbAudioProcessor)
 	
@@ -23,6 +23,7 @@ ZynVerbAudioProcessorEditor::ZynVerbAudioProcessorEditor(ZynVerbAudioProcessor&
 //	DBGM("In ZynVerbAudioProcessorEditor::ZynVerbAudioProcessorEditor() ");
 	processor = &ownerFilter;
 	setName("ZynVerbMainComponent");
+	const ZynVerbParameters::Registry& params = processor->getParameterRegistry();
 
 	mainTabsComponent = new TabbedComponent(TabbedButtonBar::TabsAtTop);
 	mainTabsComponent->setName("Main Tabs");
@@ -30,7 +31,7 @@ ZynVerbAudioProcessorEditor::ZynVerbAudioProcessorEditor(ZynVerbAudioProcessor&
 	addAndMakeVisible(mainTabsComponent);
 
 	mainTabsComponent->getTabContentComponent(0)->addAndMakeVisible (
-		muteButton = new AssociatedTextButton("Mute Button", processor->muteParam));
+		muteButton = new AssociatedTextButton("Mute Button", params.get<ZynVerbParameters::mute>()));
     muteButton->setTooltip ("Mute all audio");
     muteButton->setButtonText ("MUTE");
 	muteButton->setClickingTogglesState(true);
@@ -38,7 +39,7 @@ ZynVerbAudioProcessorEditor::ZynVerbAudioProcessorEditor(ZynVerbAudioProcessor&
 
 	
 	mainTabsComponent->getTabContentComponent(0)->addAndMakeVisible (
-		gainSlider = new AssociatedSlider ("Gain Slider", processor->audioGainParam, "dB"));
+		gainSlider = new AssociatedSlider ("Gain Slider", params.get<ZynVerbParameters::gain>(), "dB"));
     gainSlider->setTooltip ("Adjusts audio gain");
     gainSlider->setRange (-96, 12, 0.01);
     gainSlider->setSliderStyle (Slider::LinearHorizontal);
@@ -46,13 +47,56 @@ ZynVerbAudioProcessorEditor::ZynVerbAudioProcessorEditor(ZynVerbAudioProcessor&
 	gainSlider->setTextValueSuffix("dB");
 	gainSlider->setDoubleClickReturnValue(true, 0.0);
 	gainSlider->addListener (this);
+	gainSlider->onPopupMenu = [this](AssociatedSlider& slider) { showMidiLearnMenu(slider); };
 	
 	mainTabsComponent->getTabContentComponent(0)->addAndMakeVisible (
-		bypassButton = new AssociatedTextButton ("Bypass Button", processor->bypassParam));
+		bypassButton = new AssociatedTextButton ("Bypass Button", params.get<ZynVerbParameters::bypass>()));
     bypassButton->setTooltip ("Bypass Plugin");
     bypassButton->setButtonText ("Bypass");
 	bypassButton->setClickingTogglesState(true);
     bypassButton->addListener (this);
+
+	mainTabsComponent->getTabContentComponent(0)->addAndMakeVisible(
+		savePresetButton = new TextButton("Save Preset Button"));
+	savePresetButton->setTooltip("Save the current settings as a new preset");
+	savePresetButton->setButtonText("Save Preset");
+	savePresetButton->addListener(this);
+
+	mainTabsComponent->addTab("Reverb", Colours::darkgrey, new Component("Reverb"), true, 1);
+	sizeSlider = addReverbSlider("Size Slider", params.get<ZynVerbParameters::size>(), "Room size");
+	decaySlider = addReverbSlider("Decay Slider", params.get<ZynVerbParameters::decay>(), "Reverb decay time");
+	dampingSlider = addReverbSlider("Damping Slider", params.get<ZynVerbParameters::damping>(), "High frequency damping");
+	mixSlider = addReverbSlider("Mix Slider", params.get<ZynVerbParameters::mix>(), "Dry/Wet mix");
+	algorithmSlider = addReverbSlider("Algorithm Slider", params.get<ZynVerbParameters::algorithm>(), "Reverb engine: FDN, convolution, room or plate");
+	// Only the slots that have an engine behind them
+	algorithmSlider->setRange(0.0, ChoiceParameter::getValueForIndex(ZynVerbAudioProcessor::numReverbAlgorithms - 1, ZynVerbParameters::algorithmSlots),
+							  ChoiceParameter::getValueForIndex(1, ZynVerbParameters::algorithmSlots));
+	earlyDensitySlider = addReverbSlider("Early Density Slider", params.get<ZynVerbParameters::earlyDensity>(), "Early reflection density, off at 0 (algorithmic engines only)");
+	lowDecaySlider = addReverbSlider("Low Decay Slider", params.get<ZynVerbParameters::lowDecay>(), "Low band decay relative to Decay, 0.25x - 4x (FDN only)");
+	highDecaySlider = addReverbSlider("High Decay Slider", params.get<ZynVerbParameters::highDecay>(), "High band decay relative to Decay, 0.25x - 4x (FDN only)");
+	lowCrossoverSlider = addReverbSlider("Low Crossover Slider", params.get<ZynVerbParameters::lowCrossover>(), "Low / mid decay crossover, 100Hz - 1kHz (FDN only)");
+	highCrossoverSlider = addReverbSlider("High Crossover Slider", params.get<ZynVerbParameters::highCrossover>(), "Mid / high decay crossover, 1kHz - 12kHz (FDN only)");
+
+	mainTabsComponent->getTabContentComponent(1)->addAndMakeVisible(
+		loadImpulseButton = new TextButton("Load IR Button"));
+	loadImpulseButton->setTooltip("Load an impulse response file for the convolution engine");
+	loadImpulseButton->setButtonText("Load IR");
+	loadImpulseButton->addListener(this);
+
+	mainTabsComponent->getTabContentComponent(1)->addAndMakeVisible(
+		zeroLatencyButton = new AssociatedTextButton("Zero Latency Button", params.get<ZynVerbParameters::zeroLatency>()));
+	zeroLatencyButton->setTooltip("Convolve the start of the impulse directly for zero latency, at extra CPU cost");
+	zeroLatencyButton->setButtonText("Zero Latency");
+	zeroLatencyButton->setClickingTogglesState(true);
+	zeroLatencyButton->addListener(this);
+
+	StringArray parameterNames;
+
+	for (auto zenParam : params)
+		parameterNames.add(zenParam->getName(32));
+
+	mainTabsComponent->addTab("Modulation", Colours::darkgrey,
+		new ModulationMatrixComponent(processor->getModulationMatrix(), parameterNames), true, 2);
 	
 	ZEN_COMPONENT_DEBUG_ATTACH(this);
 
@@ -68,6 +112,19 @@ ZynVerbAudioProcessorEditor::~ZynVerbAudioProcessorEditor()
     muteButton = nullptr;
     gainSlider = nullptr;
     bypassButton = nullptr;		
+	savePresetButton = nullptr;
+	sizeSlider = nullptr;
+	decaySlider = nullptr;
+	dampingSlider = nullptr;
+	mixSlider = nullptr;
+	algorithmSlider = nullptr;
+	earlyDensitySlider = nullptr;
+	lowDecaySlider = nullptr;
+	highDecaySlider = nullptr;
+	lowCrossoverSlider = nullptr;
+	highCrossoverSlider = nullptr;
+	loadImpulseButton = nullptr;
+	zeroLatencyButton = nullptr;
 	
 //#ifdef ZEN_DEBUG
 	ZenDebugEditor::removeComponentDebugger();
@@ -87,12 +144,92 @@ void ZynVerbAudioProcessorEditor::resized()
     muteButton->setBounds (10, 6, 74, 24);
     gainSlider->setBounds (158, 8, 150, 24);
     bypassButton->setBounds (10, 38, 74, 24);
+	savePresetButton->setBounds (10, 68, 100, 24);
+	sizeSlider->setBounds (10, 8, 300, 24);
+	decaySlider->setBounds (10, 38, 300, 24);
+	dampingSlider->setBounds (10, 68, 300, 24);
+	mixSlider->setBounds (10, 98, 300, 24);
+	algorithmSlider->setBounds (10, 128, 300, 24);
+	earlyDensitySlider->setBounds (10, 158, 300, 24);
+	lowDecaySlider->setBounds (10, 188, 300, 24);
+	highDecaySlider->setBounds (10, 218, 300, 24);
+	lowCrossoverSlider->setBounds (10, 248, 300, 24);
+	highCrossoverSlider->setBounds (10, 278, 300, 24);
+	loadImpulseButton->setBounds (10, 308, 74, 24);
+	zeroLatencyButton->setBounds (94, 308, 100, 24);
+}
+
+AssociatedSlider* ZynVerbAudioProcessorEditor::addReverbSlider(const String& componentName, ZenParameter* associatedParam, const String& tooltip)
+{
+	AssociatedSlider* slider = new AssociatedSlider(componentName, associatedParam, 0.0f, 1.0f, 0.01f);
+	mainTabsComponent->getTabContentComponent(1)->addAndMakeVisible(slider);
+	slider->setTooltip(tooltip);
+	slider->setSliderStyle(Slider::LinearHorizontal);
+	slider->setTextBoxStyle(Slider::TextBoxLeft, false, 80, 20);
+	slider->addListener(this);
+	slider->onPopupMenu = [this](AssociatedSlider& clickedSlider) { showMidiLearnMenu(clickedSlider); };
+	return slider;
+}
+
+void ZynVerbAudioProcessorEditor::showMidiLearnMenu(AssociatedSlider& slider)
+{
+	MidiControllerMap& controllers = processor->getMidiControllerMap();
+	const int parameterIndex = slider.getAssociatedParameter()->getParameterIndex();
+	const bool learning = controllers.getLearningParameter() == parameterIndex;
+	const int slot = controllers.findSlotFor(parameterIndex);
+
+	enum { learnItem = 1, stopLearningItem, clearItem };
+
+	PopupMenu menu;
+
+	if (slot >= 0)
+		menu.addSectionHeader("MIDI Ch " + String((slot >> 7) + 1) + " CC " + String(slot & 0x7f));
+
+	if (learning)
+		menu.addItem(stopLearningItem, "Stop Learning");
+	else
+		menu.addItem(learnItem, "Learn MIDI CC");
+
+	menu.addItem(clearItem, "Clear MIDI CC", slot >= 0);
+
+	switch (menu.showAt(&slider))
+	{
+		case learnItem:			controllers.startLearning(parameterIndex); break;
+		case stopLearningItem:	controllers.stopLearning(); break;
+		case clearItem:			controllers.clearParameter(parameterIndex); break;
+		default:				break;
+	}
 }
 
 
 void ZynVerbAudioProcessorEditor::buttonClicked(Button* buttonThatWasClicked)
 {	
 //	 DBGM("In ZynVerbAudioProcessorEditor::buttonClicked() ");
+	if (buttonThatWasClicked == loadImpulseButton)
+	{
+		FileChooser chooser("Select an impulse response", File::nonexistent, "*.wav;*.aif;*.aiff");
+		if (chooser.browseForFileToOpen())
+			processor->loadImpulseResponse(chooser.getResult());
+		return;
+	}
+
+	if (buttonThatWasClicked == savePresetButton)
+	{
+		AlertWindow nameWindow("Save Preset", "Name for the new preset", AlertWindow::NoIcon, this);
+		nameWindow.addTextEditor("name", "Preset " + String(processor->getNumPrograms() + 1));
+		nameWindow.addButton("Save", 1, KeyPress(KeyPress::returnKey));
+		nameWindow.addButton("Cancel", 0, KeyPress(KeyPress::escapeKey));
+
+		if (nameWindow.runModalLoop() != 1)
+			return;
+
+		const String presetName(nameWindow.getTextEditorContents("name").trim());
+
+		if (presetName.isNotEmpty() && !processor->saveCurrentAsPreset(presetName))
+			AlertWindow::showMessageBoxAsync(AlertWindow::WarningIcon, "Save Preset", "The preset library could not be written");
+		return;
+	}
+
 	 dynamic_cast<AssociatedButton*>(buttonThatWasClicked)->setAssociatedParameterValueNotifyingHost();
 }
 
@@ -43,6 +43,11 @@ public:
     void sliderValueChanged (Slider* sliderThatWasMoved) override;
 
 private:
+	AssociatedSlider* addReverbSlider(const String& componentName, ZenParameter* associatedParam, const String& tooltip);
+
+	/// <summary> Right click menu on a parameter slider: learn the next MIDI CC for its parameter, or clear it </summary>
+	void showMidiLearnMenu(AssociatedSlider& slider);
+
 	ZynVerbAudioProcessor* processor;
     
     //==============================================================================
@@ -50,6 +55,19 @@ private:
     ScopedPointer<AssociatedTextButton> muteButton;
     ScopedPointer<AssociatedSlider> gainSlider;
     ScopedPointer<AssociatedTextButton> bypassButton;
+    ScopedPointer<TextButton> savePresetButton;
+    ScopedPointer<AssociatedSlider> sizeSlider;
+    ScopedPointer<AssociatedSlider> decaySlider;
+    ScopedPointer<AssociatedSlider> dampingSlider;
+    ScopedPointer<AssociatedSlider> mixSlider;
+    ScopedPointer<AssociatedSlider> algorithmSlider;
+    ScopedPointer<AssociatedSlider> earlyDensitySlider;
+    ScopedPointer<AssociatedSlider> lowDecaySlider;
+    ScopedPointer<AssociatedSlider> highDecaySlider;
+    ScopedPointer<AssociatedSlider> lowCrossoverSlider;
+    ScopedPointer<AssociatedSlider> highCrossoverSlider;
+    ScopedPointer<TextButton> loadImpulseButton;
+    ScopedPointer<AssociatedTextButton> zeroLatencyButton;
 	
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ZynVerbAudioProcessorEditor)
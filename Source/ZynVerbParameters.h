@@ -0,0 +1,72 @@
+/* ==============================================================================
+//  ZynVerbParameters.h
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: The processor's parameter layout, declared once
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#ifndef ZYNVERBPARAMETERS_H_INCLUDED
+#define ZYNVERBPARAMETERS_H_INCLUDED
+
+#include "zen_utils/parameters/ParameterRegistry.hpp"
+
+/// <summary> Every ZynVerb parameter.  The enum order is the host parameter order, so new parameters go on the end
+/// to keep automation in existing sessions pointing at the right thing. </summary>
+struct ZynVerbParameters
+{
+	enum Index
+	{
+		gain = 0,
+		mute,
+		bypass,
+		size,
+		decay,
+		damping,
+		mix,
+		algorithm,
+		zeroLatency,
+		earlyDensity,
+		lowDecay,
+		highDecay,
+		lowCrossover,
+		highCrossover,
+		numParameters
+	};
+
+	enum
+	{
+		algorithmSlots = 16	///< Fixed for good, so a stored Engine value always means the same engine
+	};
+
+	/// <summary> Saved state ID of the normalized float Engine replaced, whose steps moved with the engine count </summary>
+	static constexpr uint32 legacyAlgorithmId = Zen::hashParameterName("Algorithm");
+
+	static constexpr Zen::ParameterSpec specs[numParameters] =
+	{
+		Zen::decibelSpec("Gain", -96.0f, 12.0f, 0.5f),
+		Zen::booleanSpec("Mute", false),
+		Zen::booleanSpec("Bypass", false),
+		Zen::floatSpec("Size", 0.0f, 1.0f, 0.5f),
+		Zen::floatSpec("Decay", 0.0f, 1.0f, 0.4f),
+		Zen::floatSpec("Damping", 0.0f, 1.0f, 0.5f),
+		Zen::floatSpec("Mix", 0.0f, 1.0f, 0.25f),
+		Zen::choiceSpec("Engine", "FDN|Convolution|Room|Plate", algorithmSlots),
+		Zen::booleanSpec("Zero Latency", false),
+		Zen::floatSpec("Early Density", 0.0f, 1.0f, 0.5f),
+		Zen::floatSpec("Low Decay", 0.0f, 1.0f, 0.5f),
+		Zen::floatSpec("High Decay", 0.0f, 1.0f, 0.5f),
+		Zen::floatSpec("Low Crossover", 0.0f, 1.0f, 0.4f),
+		Zen::floatSpec("High Crossover", 0.0f, 1.0f, 0.55f)
+	};
+
+	typedef Zen::ParameterRegistry<ZynVerbParameters> Registry;
+};
+
+#endif // ZYNVERBPARAMETERS_H_INCLUDED
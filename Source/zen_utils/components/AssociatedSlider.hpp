@@ -18,6 +18,7 @@
 
 #include "JuceHeader.h"
 #include <sstream>
+#include <functional>
 #include "../parameters/ZenParameter.hpp"
 #include "AssociatedComponent.hpp"
 
@@ -89,6 +90,34 @@ namespace Zen
 		}		
 		
 
+		/// <summary> When set, right clicks (or ctrl clicks on the Mac) call this instead of moving the slider,
+		/// e.g. to offer a MIDI learn menu for the associated parameter </summary>
+		std::function<void(AssociatedSlider&)> onPopupMenu;
+
+		void mouseDown(const MouseEvent& e) override
+		{
+			popupMenuClick = e.mods.isPopupMenu() && onPopupMenu != nullptr;
+
+			if (popupMenuClick)
+				onPopupMenu(*this);
+			else
+				Slider::mouseDown(e);
+		}
+
+		void mouseDrag(const MouseEvent& e) override
+		{
+			if (!popupMenuClick)
+				Slider::mouseDrag(e);
+		}
+
+		void mouseUp(const MouseEvent& e) override
+		{
+			if (!popupMenuClick)
+				Slider::mouseUp(e);
+
+			popupMenuClick = false;
+		}
+
 		void setValueFromLinearNormalized(const float& inValue, NotificationType notification)
 		{
 			jassert(inValue <= 1.0f && inValue >= -1.0f);
@@ -106,6 +135,8 @@ namespace Zen
 	protected:
 
 	private:
+		bool popupMenuClick = false;	///< The current click went to onPopupMenu, so the slider ignores its drag and release
+
 		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AssociatedSlider);
 	
 	};
@@ -0,0 +1,228 @@
+/* ==============================================================================
+//  ModulationMatrixComponent.cpp
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Editor for a ModulationMatrix - LFO and envelope follower
+//  settings and one source / target / depth row per route
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#include "ModulationMatrixComponent.h"
+
+namespace Zen
+{
+
+namespace
+{
+const char* const shapeNames[ModulationMatrix::numShapes] = { "Sine", "Triangle", "Saw", "Square" };
+const char* const sourceNames[ModulationMatrix::numSources] = { "LFO 1", "LFO 2", "LFO 3", "LFO 4", "Env 1", "Env 2" };
+
+// Route source boxes: item 1 is Off, source s is item s + 2
+const int offItemId = 1;
+
+const int rowHeight = 24, rowSpacing = 26, labelWidth = 50;
+}
+
+ModulationMatrixComponent::ModulationMatrixComponent(ModulationMatrix& matrixToEdit, const StringArray& targetNames)
+	: Component("Modulation Matrix"), matrix(matrixToEdit)
+{
+	for (int i = 0; i < ModulationMatrix::numLfos; ++i)
+	{
+		addLabel("LFO " + String(i + 1));
+		lfoRates.add(addSlider("LFO " + String(i + 1) + " rate", 0.0, 20.0, 1.0, " Hz"));
+
+		ComboBox* const shape = lfoShapes.add(addComboBox("LFO " + String(i + 1) + " shape"));
+
+		for (int s = 0; s < ModulationMatrix::numShapes; ++s)
+			shape->addItem(shapeNames[s], s + 1);
+	}
+
+	for (int i = 0; i < ModulationMatrix::numEnvelopes; ++i)
+	{
+		addLabel("Env " + String(i + 1));
+		envelopeAttacks.add(addSlider("Envelope follower " + String(i + 1) + " attack", 0.001, 1.0, 0.05, " s"));
+		envelopeReleases.add(addSlider("Envelope follower " + String(i + 1) + " release", 0.001, 5.0, 0.5, " s"));
+	}
+
+	for (int i = 0; i < ModulationMatrix::maxRoutes; ++i)
+	{
+		addLabel("Route " + String(i + 1));
+
+		ComboBox* const source = routeSources.add(addComboBox("Modulation source, Off clears the route"));
+		source->addItem("Off", offItemId);
+
+		for (int s = 0; s < ModulationMatrix::numSources; ++s)
+			source->addItem(sourceNames[s], s + 2);
+
+		ComboBox* const target = routeTargets.add(addComboBox("Parameter the source modulates"));
+
+		for (int t = 0; t < targetNames.size(); ++t)
+			if (matrix.isTargetAllowed(t))
+				target->addItem(targetNames[t], t + 1);
+
+		Slider* const depth = routeDepths.add(addSlider("Modulation depth, in normalized parameter units", -1.0, 1.0, 0.0, String()));
+		depth->setDoubleClickReturnValue(true, 0.0);
+	}
+
+	updateFromMatrix();
+}
+
+ModulationMatrixComponent::~ModulationMatrixComponent()
+{
+}
+
+void ModulationMatrixComponent::updateFromMatrix()
+{
+	for (int i = 0; i < ModulationMatrix::numLfos; ++i)
+	{
+		lfoRates.getUnchecked(i)->setValue(matrix.getLfoRate(i), dontSendNotification);
+		lfoShapes.getUnchecked(i)->setSelectedId(matrix.getLfoShape(i) + 1, dontSendNotification);
+	}
+
+	for (int i = 0; i < ModulationMatrix::numEnvelopes; ++i)
+	{
+		envelopeAttacks.getUnchecked(i)->setValue(matrix.getEnvelopeAttack(i), dontSendNotification);
+		envelopeReleases.getUnchecked(i)->setValue(matrix.getEnvelopeRelease(i), dontSendNotification);
+	}
+
+	for (int i = 0; i < ModulationMatrix::maxRoutes; ++i)
+	{
+		const int target = matrix.getRouteTarget(i);
+
+		routeSources.getUnchecked(i)->setSelectedId(target >= 0 ? matrix.getRouteSource(i) + 2 : offItemId, dontSendNotification);
+		routeTargets.getUnchecked(i)->setSelectedId(target + 1, dontSendNotification);
+		routeDepths.getUnchecked(i)->setValue(target >= 0 ? matrix.getRouteDepth(i) : 0.0, dontSendNotification);
+	}
+}
+
+void ModulationMatrixComponent::resized()
+{
+	// LFOs on the left and envelopes on the right, then one full width row per route
+	const int columnWidth = getWidth() / 2 - 10;
+	int y = 8;
+
+	for (int i = 0; i < ModulationMatrix::numLfos; ++i)
+	{
+		labels.getUnchecked(i)->setBounds(10, y + i * rowSpacing, labelWidth, rowHeight);
+		lfoRates.getUnchecked(i)->setBounds(10 + labelWidth, y + i * rowSpacing, columnWidth - labelWidth - 90, rowHeight);
+		lfoShapes.getUnchecked(i)->setBounds(columnWidth - 80, y + i * rowSpacing, 80, rowHeight);
+	}
+
+	const int envelopeX = columnWidth + 20;
+	const int envelopeSliderWidth = (columnWidth - labelWidth) / 2;
+
+	for (int i = 0; i < ModulationMatrix::numEnvelopes; ++i)
+	{
+		labels.getUnchecked(ModulationMatrix::numLfos + i)->setBounds(envelopeX, y + i * rowSpacing, labelWidth, rowHeight);
+		envelopeAttacks.getUnchecked(i)->setBounds(envelopeX + labelWidth, y + i * rowSpacing, envelopeSliderWidth, rowHeight);
+		envelopeReleases.getUnchecked(i)->setBounds(envelopeX + labelWidth + envelopeSliderWidth, y + i * rowSpacing, envelopeSliderWidth, rowHeight);
+	}
+
+	y += ModulationMatrix::numLfos * rowSpacing + 10;
+
+	const int firstRouteLabel = ModulationMatrix::numLfos + ModulationMatrix::numEnvelopes;
+	const int routeWidth = getWidth() - 20 - labelWidth;
+
+	for (int i = 0; i < ModulationMatrix::maxRoutes; ++i)
+	{
+		const int rowY = y + i * rowSpacing;
+		labels.getUnchecked(firstRouteLabel + i)->setBounds(10, rowY, labelWidth, rowHeight);
+		routeSources.getUnchecked(i)->setBounds(10 + labelWidth, rowY, routeWidth / 4, rowHeight);
+		routeTargets.getUnchecked(i)->setBounds(10 + labelWidth + routeWidth / 4, rowY, routeWidth / 3, rowHeight);
+		routeDepths.getUnchecked(i)->setBounds(10 + labelWidth + routeWidth / 4 + routeWidth / 3, rowY, routeWidth - routeWidth / 4 - routeWidth / 3, rowHeight);
+	}
+}
+
+void ModulationMatrixComponent::visibilityChanged()
+{
+	if (isShowing())
+		updateFromMatrix();
+}
+
+void ModulationMatrixComponent::comboBoxChanged(ComboBox* comboBoxThatHasChanged)
+{
+	const int lfoIndex = lfoShapes.indexOf(comboBoxThatHasChanged);
+
+	if (lfoIndex >= 0)
+	{
+		matrix.setLfo(lfoIndex, matrix.getLfoRate(lfoIndex), static_cast<ModulationMatrix::Shape>(comboBoxThatHasChanged->getSelectedId() - 1));
+		return;
+	}
+
+	const int sourceIndex = routeSources.indexOf(comboBoxThatHasChanged);
+	updateRoute(sourceIndex >= 0 ? sourceIndex : routeTargets.indexOf(comboBoxThatHasChanged));
+}
+
+void ModulationMatrixComponent::sliderValueChanged(Slider* sliderThatWasMoved)
+{
+	const float value = static_cast<float>(sliderThatWasMoved->getValue());
+	int index;
+
+	if ((index = lfoRates.indexOf(sliderThatWasMoved)) >= 0)
+		matrix.setLfo(index, value, matrix.getLfoShape(index));
+	else if ((index = envelopeAttacks.indexOf(sliderThatWasMoved)) >= 0)
+		matrix.setEnvelope(index, value, matrix.getEnvelopeRelease(index));
+	else if ((index = envelopeReleases.indexOf(sliderThatWasMoved)) >= 0)
+		matrix.setEnvelope(index, matrix.getEnvelopeAttack(index), value);
+	else
+		updateRoute(routeDepths.indexOf(sliderThatWasMoved));
+}
+
+void ModulationMatrixComponent::updateRoute(int routeIndex)
+{
+	if (routeIndex < 0) return;
+
+	const int sourceId = routeSources.getUnchecked(routeIndex)->getSelectedId();
+	const int target = routeTargets.getUnchecked(routeIndex)->getSelectedId() - 1;
+
+	// A half set up row stays cleared until it has both a source and a target
+	if (sourceId <= offItemId || target < 0)
+	{
+		matrix.clearRoute(routeIndex);
+		return;
+	}
+
+	matrix.setRoute(routeIndex, static_cast<ModulationMatrix::Source>(sourceId - 2), target,
+		static_cast<float>(routeDepths.getUnchecked(routeIndex)->getValue()));
+}
+
+Slider* ModulationMatrixComponent::addSlider(const String& tooltip, double minimum, double maximum, double skewMidpoint, const String& suffix)
+{
+	Slider* const slider = new Slider();
+	addAndMakeVisible(slider);
+	slider->setTooltip(tooltip);
+	slider->setSliderStyle(Slider::LinearHorizontal);
+	slider->setTextBoxStyle(Slider::TextBoxLeft, false, 60, 20);
+	slider->setRange(minimum, maximum, 0.001);
+	slider->setTextValueSuffix(suffix);
+
+	if (skewMidpoint > minimum)
+		slider->setSkewFactorFromMidPoint(skewMidpoint);
+
+	slider->addListener(this);
+	return slider;
+}
+
+ComboBox* ModulationMatrixComponent::addComboBox(const String& tooltip)
+{
+	ComboBox* const comboBox = new ComboBox();
+	addAndMakeVisible(comboBox);
+	comboBox->setTooltip(tooltip);
+	comboBox->addListener(this);
+	return comboBox;
+}
+
+Label* ModulationMatrixComponent::addLabel(const String& text)
+{
+	Label* const label = labels.add(new Label(String(), text));
+	addAndMakeVisible(label);
+	return label;
+}
+
+} // namespace Zen
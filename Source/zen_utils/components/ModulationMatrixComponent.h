@@ -0,0 +1,64 @@
+/* ==============================================================================
+//  ModulationMatrixComponent.h
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Editor for a ModulationMatrix - LFO and envelope follower
+//  settings and one source / target / depth row per route
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#ifndef ZEN_MODULATION_MATRIX_COMPONENT_H_INCLUDED
+#define ZEN_MODULATION_MATRIX_COMPONENT_H_INCLUDED
+
+#include "JuceHeader.h"
+#include "../processing/ModulationMatrix.h"
+
+namespace Zen
+{
+
+/// <summary> Edits a ModulationMatrix directly through its message thread setters.  LFOs get a rate and a shape,
+/// envelope followers an attack and a release, and each of the matrix's routes a row of source, target and depth.
+/// A route whose source is Off is cleared.  The controls are read back from the matrix whenever the component
+/// is shown, so a state restored while it was hidden shows up. </summary>
+class ModulationMatrixComponent : public Component,
+								  private ComboBoxListener,
+								  private SliderListener
+{
+public:
+	/// <param name="targetNames"> Display names of the matrix's targets, in target index order.  Only the targets
+	/// the matrix allows are offered. </param>
+	ModulationMatrixComponent(ModulationMatrix& matrixToEdit, const StringArray& targetNames);
+	~ModulationMatrixComponent();
+
+	/// <summary> Sets every control from the matrix's current settings, without sending any changes back </summary>
+	void updateFromMatrix();
+
+	void resized() override;
+	void visibilityChanged() override;
+
+private:
+	void comboBoxChanged(ComboBox* comboBoxThatHasChanged) override;
+	void sliderValueChanged(Slider* sliderThatWasMoved) override;
+
+	Slider* addSlider(const String& tooltip, double minimum, double maximum, double skewMidpoint, const String& suffix);
+	ComboBox* addComboBox(const String& tooltip);
+	Label* addLabel(const String& text);
+	void updateRoute(int routeIndex);
+
+	ModulationMatrix& matrix;
+
+	OwnedArray<Label> labels;
+	OwnedArray<Slider> lfoRates, envelopeAttacks, envelopeReleases, routeDepths;
+	OwnedArray<ComboBox> lfoShapes, routeSources, routeTargets;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ModulationMatrixComponent);
+};
+
+} // namespace Zen
+#endif // ZEN_MODULATION_MATRIX_COMPONENT_H_INCLUDED
@@ -19,5 +19,6 @@
 #include "AssociatedComponent.hpp"
 #include "AssociatedSlider.hpp"
 #include "AssociatedTextButton.hpp"
+#include "ModulationMatrixComponent.h"
 
 #endif // ZENCOMPONENTS_H_INCLUDED
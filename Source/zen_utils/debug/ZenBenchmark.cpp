@@ -0,0 +1,651 @@
+/* ==============================================================================
+//  ZenBenchmark.cpp
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Static micro-benchmarks for the DSP engines
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+#include "JuceHeader.h"
+#include "ZenBenchmark.h"
+#include "../processing/reverb/FDNReverb.h"
+#include "../processing/reverb/ConvolutionReverb.h"
+#include "../processing/reverb/PartitionedConvolver.h"
+#include "../processing/reverb/HybridConvolver.h"
+#include "../processing/reverb/VectorFreeverb.h"
+#include "../processing/reverb/PlateReverb.h"
+#include "../processing/reverb/EarlyReflections.h"
+#include "../processing/ZenDSPFilters.h"
+#include "../processing/NewAudioProcessorGraph.h"
+#include "../parameters/FloatParameter.hpp"
+#include "../utilities/FastDecibels.h"
+#include <cmath>
+
+namespace Zen
+{
+
+void ZenBenchmark::fillWithNoise(AudioSampleBuffer& buffer)
+{
+	Random rng(0x5eed);
+
+	for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+	{
+		float* data = buffer.getWritePointer(channel);
+
+		for (int i = 0; i < buffer.getNumSamples(); ++i)
+			data[i] = rng.nextFloat() - 0.5f;
+	}
+}
+
+String ZenBenchmark::formatResult(int blockSize, double nanosecondsPerSample)
+{
+	return "  block " + String(blockSize).paddedLeft(' ', 5) + ": " + String(nanosecondsPerSample, 2) + " ns/sample\n";
+}
+
+String ZenBenchmark::benchmarkFDNReverb(double sampleRate, int numLines, bool multibandDecay)
+{
+	String report("FDN Reverb (" + String(numLines) + " lines" + (multibandDecay ? ", 3 band decay" : "") + ") @ " + String(sampleRate, 0) + "Hz\n");
+
+	FDNReverb reverb;
+	reverb.prepare(sampleRate, numLines);
+	reverb.setParameters(0.7f, 0.6f, 0.5f, 0.5f);
+
+	if (multibandDecay)
+		reverb.setDecayBands(0.7f, 0.3f, 0.4f, 0.55f);
+
+	for (int blockSize = minBlockSize; blockSize <= maxBlockSize; blockSize <<= 1)
+	{
+		reverb.reset();
+		const double ns = measureNanosecondsPerSample([&reverb](float* left, float* right, int numSamples)
+		{
+			reverb.processStereo(left, right, numSamples);
+		}, blockSize);
+
+		report << formatResult(blockSize, ns);
+	}
+
+	return report;
+}
+
+String ZenBenchmark::benchmarkPlateReverb(double sampleRate)
+{
+	String report("Plate Reverb @ " + String(sampleRate, 0) + "Hz\n");
+
+	PlateReverb reverb;
+	reverb.prepare(sampleRate);
+	reverb.setParameters(0.7f, 0.6f, 0.5f, 0.5f);
+
+	for (int blockSize = minBlockSize; blockSize <= maxBlockSize; blockSize <<= 1)
+	{
+		reverb.reset();
+		const double ns = measureNanosecondsPerSample([&reverb](float* left, float* right, int numSamples)
+		{
+			reverb.processStereo(left, right, numSamples);
+		}, blockSize);
+
+		report << formatResult(blockSize, ns);
+	}
+
+	return report;
+}
+
+String ZenBenchmark::benchmarkEarlyReflections(double sampleRate, int blockSize)
+{
+	String report("Early Reflections @ " + String(sampleRate, 0) + "Hz, block " + String(blockSize) + "\n");
+
+	EarlyReflections reflections;
+	reflections.prepare(sampleRate);
+	AudioSampleBuffer early(2, blockSize);
+
+	for (int step = 0; step <= 8; ++step)
+	{
+		const float density = step / 8.0f;
+		reflections.setParameters(1.0f, density);
+		reflections.reset();
+
+		const double ns = measureNanosecondsPerSample([&reflections, &early](float* left, float* right, int numSamples)
+		{
+			reflections.process(left, right, early.getWritePointer(0), early.getWritePointer(1), numSamples);
+		}, blockSize);
+
+		const int numTaps = reflections.getNumTaps();
+
+		report << "  density " << String(density, 3) << " (" << String(numTaps).paddedLeft(' ', 3) << " taps/channel): "
+			<< String(ns, 2) << " ns/sample";
+
+		if (numTaps > 0)
+			report << ", " << String(ns / numTaps, 3) << " ns/sample per tap";
+
+		report << "\n";
+	}
+
+	return report;
+}
+
+String ZenBenchmark::benchmarkBiquadBank(double sampleRate, int numFilters)
+{
+	String report("Biquad Bank (" + String(numFilters) + " high shelves), BiquadBank vs juce::IIRFilter @ " + String(sampleRate, 0) + "Hz\n");
+
+	const BiquadCoefficients coefficients = BiquadCoefficients::makeHighShelf(sampleRate, 4000.0, 0.7071, 0.5f);
+	const IIRCoefficients juceCoefficients(coefficients.b0, coefficients.b1, coefficients.b2, 1.0, coefficients.a1, coefficients.a2);
+
+	BiquadBank bank;
+	bank.prepare(numFilters);
+	OwnedArray<IIRFilter> juceFilters;
+
+	for (int i = 0; i < numFilters; ++i)
+	{
+		bank.setCoefficients(i, coefficients);
+		juceFilters.add(new IIRFilter())->setCoefficients(juceCoefficients);
+	}
+
+	// One channel per filter, like the lines of a delay network
+	AudioSampleBuffer channels(numFilters, maxBlockSize);
+
+	for (int blockSize = minBlockSize; blockSize <= maxBlockSize; blockSize <<= 1)
+	{
+		bank.reset();
+		const double bankNs = measureNanosecondsPerSample([&bank, &channels](float* left, float* right, int numSamples)
+		{
+			for (int i = 0; i < channels.getNumChannels(); ++i)
+				channels.copyFrom(i, 0, (i & 1) ? right : left, numSamples);
+
+			bank.process(channels.getArrayOfWritePointers(), numSamples);
+		}, blockSize);
+
+		for (int i = 0; i < numFilters; ++i)
+			juceFilters[i]->reset();
+
+		const double juceNs = measureNanosecondsPerSample([&juceFilters, &channels](float* left, float* right, int numSamples)
+		{
+			for (int i = 0; i < channels.getNumChannels(); ++i)
+			{
+				channels.copyFrom(i, 0, (i & 1) ? right : left, numSamples);
+				juceFilters[i]->processSamples(channels.getWritePointer(i), numSamples);
+			}
+		}, blockSize);
+
+		report << "  block " << String(blockSize).paddedLeft(' ', 5) << ": BiquadBank " << String(bankNs, 2)
+			<< " ns/sample, IIRFilter " << String(juceNs, 2) << " ns/sample, speedup " << String(juceNs / bankNs, 2) << "x\n";
+	}
+
+	return report;
+}
+
+String ZenBenchmark::benchmarkParameterSmoothing(double sampleRate)
+{
+	String report("Parameter smoothing (10ms ramps), per sample vs block rate @ " + String(sampleRate, 0) + "Hz\n");
+
+	FloatParameter param("Benchmark Gain", 0.0f, 1.0f, 0.5f, 0.01f, true, 0.01f);
+	param.resetSmoothedValue(static_cast<float>(sampleRate));
+	HeapBlock<float> ramp(2048);
+	int numBlocks = 0;
+
+	// Every block heads for the other end of the range, so each one is still ramping
+	auto retarget = [&param, &numBlocks]()
+	{
+		param.setValue((++numBlocks & 1) ? 0.25f : 0.75f);
+	};
+
+	auto applyPerSample = [&param, &retarget](float* left, float* right, int numSamples)
+	{
+		retarget();
+
+		for (int i = 0; i < numSamples; ++i)
+		{
+			const float gain = param.getNextSmoothedValue();
+			left[i] *= gain;
+			right[i] *= gain;
+		}
+	};
+
+	auto applyBlock = [&param, &retarget, &ramp](float* left, float* right, int numSamples)
+	{
+		retarget();
+
+		if (param.getSmoothedValueBlock(ramp, numSamples))
+		{
+			FloatVectorOperations::multiply(left, ramp, numSamples);
+			FloatVectorOperations::multiply(right, ramp, numSamples);
+		}
+		else
+		{
+			FloatVectorOperations::multiply(left, param.getSmoothedTargetValue(), numSamples);
+			FloatVectorOperations::multiply(right, param.getSmoothedTargetValue(), numSamples);
+		}
+	};
+
+	for (int blockSize = 16; blockSize <= 2048; blockSize <<= 1)
+	{
+		param.setSmoothingRampType(BlockSmoothedValue::linearRamp);
+		const double perSampleNs = measureNanosecondsPerSample(applyPerSample, blockSize);
+		const double linearNs = measureNanosecondsPerSample(applyBlock, blockSize);
+
+		param.setSmoothingRampType(BlockSmoothedValue::multiplicativeRamp);
+		const double multiplicativeNs = measureNanosecondsPerSample(applyBlock, blockSize);
+
+		report << "  block " << String(blockSize).paddedLeft(' ', 5) << ": per sample " << String(perSampleNs, 2)
+			<< " ns/sample, block linear " << String(linearNs, 2) << " ns/sample, block multiplicative "
+			<< String(multiplicativeNs, 2) << " ns/sample, speedup " << String(perSampleNs / linearNs, 2) << "x\n";
+	}
+
+	return report;
+}
+
+String ZenBenchmark::benchmarkDecibelConversion(int blockSize)
+{
+	String report("Decibel to gain, " + String(blockSize) + " values per block\n");
+
+	HeapBlock<float> decibels(blockSize), gains(blockSize);
+
+	for (int i = 0; i < blockSize; ++i)
+		decibels[i] = -90.0f + 100.0f * i / blockSize;
+
+	// The stereo block the timer hands out is only used to stop the compiler from dropping the work
+	const double powNs = measureNanosecondsPerSample([&](float* left, float*, int numSamples)
+	{
+		for (int i = 0; i < numSamples; ++i)
+			left[i] *= static_cast<float>(std::pow(10.0, decibels[i] * 0.05));
+	}, blockSize);
+
+	const double tableNs = measureNanosecondsPerSample([&](float* left, float*, int numSamples)
+	{
+		for (int i = 0; i < numSamples; ++i)
+			left[i] *= FastDecibels::decibelsToGain(decibels[i]);
+	}, blockSize);
+
+	const double blockNs = measureNanosecondsPerSample([&](float* left, float*, int numSamples)
+	{
+		FastDecibels::decibelsToGain(gains, decibels, numSamples);
+		FloatVectorOperations::multiply(left, gains, numSamples);
+	}, blockSize);
+
+	double tableError = 0.0, blockError = 0.0;
+	FastDecibels::decibelsToGain(gains, decibels, blockSize);
+
+	for (int i = 0; i < blockSize; ++i)
+	{
+		const double exact = std::pow(10.0, decibels[i] * 0.05);
+		tableError = jmax(tableError, std::abs(FastDecibels::decibelsToGain(decibels[i]) - exact) / exact);
+		blockError = jmax(blockError, std::abs(gains[i] - exact) / exact);
+	}
+
+	report << "  pow " << String(powNs, 2) << " ns/value, table " << String(tableNs, 2) << " ns/value, block "
+		<< String(blockNs, 2) << " ns/value\n  max relative error: table " << String(tableError, 9)
+		<< ", block " << String(blockError, 9) << "\n";
+
+	return report;
+}
+
+String ZenBenchmark::benchmarkRoomReverb(double sampleRate)
+{
+	String report("Room Reverb, VectorFreeverb vs juce::Reverb @ " + String(sampleRate, 0) + "Hz\n");
+
+	Reverb::Parameters parameters;
+	parameters.roomSize = 0.8f;
+	parameters.damping = 0.4f;
+
+	for (int blockSize = minBlockSize; blockSize <= maxBlockSize; blockSize <<= 1)
+	{
+		Reverb juceReverb;
+		juceReverb.setSampleRate(sampleRate);
+		juceReverb.setParameters(parameters);
+
+		VectorFreeverb vectorReverb;
+		vectorReverb.prepare(sampleRate);
+		vectorReverb.setParameters(parameters);
+
+		const double juceNs = measureNanosecondsPerSample([&juceReverb](float* left, float* right, int numSamples)
+		{
+			juceReverb.processStereo(left, right, numSamples);
+		}, blockSize);
+
+		const double vectorNs = measureNanosecondsPerSample([&vectorReverb](float* left, float* right, int numSamples)
+		{
+			vectorReverb.processStereo(left, right, numSamples);
+		}, blockSize);
+
+		// Same noise through both from a cleared state, long enough for the tail to build up
+		juceReverb.reset();
+		vectorReverb.reset();
+
+		AudioSampleBuffer juceOut(2, 1 << 15);
+		fillWithNoise(juceOut);
+		AudioSampleBuffer vectorOut(juceOut);
+		float maxDifference = 0.0f;
+
+		for (int start = 0; start + blockSize <= juceOut.getNumSamples(); start += blockSize)
+		{
+			juceReverb.processStereo(juceOut.getWritePointer(0, start), juceOut.getWritePointer(1, start), blockSize);
+			vectorReverb.processStereo(vectorOut.getWritePointer(0, start), vectorOut.getWritePointer(1, start), blockSize);
+		}
+
+		for (int channel = 0; channel < 2; ++channel)
+			for (int i = 0; i < juceOut.getNumSamples(); ++i)
+				maxDifference = jmax(maxDifference, std::abs(juceOut.getSample(channel, i) - vectorOut.getSample(channel, i)));
+
+		report << "  block " << String(blockSize).paddedLeft(' ', 5)
+			<< ": juce::Reverb " << String(juceNs, 2)
+			<< ", VectorFreeverb " << String(vectorNs, 2) << " ns/sample"
+			<< " (" << String(juceNs / jmax(vectorNs, 1.0e-9), 2) << "x)"
+			<< ", max diff " << String(maxDifference, 8) << "\n";
+	}
+
+	return report;
+}
+
+String ZenBenchmark::benchmarkConvolutionReverb(double sampleRate, double impulseSeconds)
+{
+	String report("Non-uniform Convolution Reverb (" + String(impulseSeconds, 1) + "s IR) @ " + String(sampleRate, 0) + "Hz\n");
+	CriticalSection unusedLock;
+
+	for (int blockSize = minBlockSize; blockSize <= maxBlockSize; blockSize <<= 1)
+	{
+		// Partition size follows the host block size, so each block size needs its own prepare
+		// The benchmark runs faster than real time, so the tail is computed inline and included in the cost
+		ConvolutionReverb reverb;
+		reverb.setUseWorkerThread(false);
+		reverb.setImpulseResponse(ConvolutionReverb::createDefaultImpulseResponse(sampleRate, impulseSeconds), sampleRate, unusedLock);
+		reverb.prepare(sampleRate, blockSize);
+		reverb.setMix(0.5f);
+
+		const double ns = measureNanosecondsPerSample([&reverb](float* left, float* right, int numSamples)
+		{
+			reverb.processStereo(left, right, numSamples);
+		}, blockSize);
+
+		report << formatResult(blockSize, ns);
+
+		if (blockSize == minBlockSize)
+			report << reverb.getConvolver(0)->getTailConvolver().getScheduleDescription();
+	}
+
+	return report;
+}
+
+/// Runs a mono convolver over the test signal and returns the output shifted back by its latency
+template <typename Convolver>
+static void renderAligned(Convolver& convolver, int latency, const AudioSampleBuffer& signal, AudioSampleBuffer& result, int blockSize)
+{
+	const int numSamples = signal.getNumSamples();
+	HeapBlock<float> rendered;
+	rendered.allocate(static_cast<size_t>(numSamples + latency), true);
+
+	for (int start = 0; start < numSamples + latency; start += blockSize)
+	{
+		const int numToDo = jmin(blockSize, numSamples + latency - start);
+
+		if (start < numSamples)
+			FloatVectorOperations::copy(rendered + start, signal.getReadPointer(0, start), jmin(numToDo, numSamples - start));
+
+		convolver.process(rendered + start, rendered + start, numToDo);
+	}
+
+	result.setSize(1, numSamples);
+	result.copyFrom(0, 0, rendered + latency, numSamples);
+}
+
+static float getMaxDifference(const AudioSampleBuffer& a, const AudioSampleBuffer& b)
+{
+	float maxDifference = 0.0f;
+
+	for (int i = 0; i < a.getNumSamples(); ++i)
+		maxDifference = jmax(maxDifference, std::abs(a.getSample(0, i) - b.getSample(0, i)));
+
+	return maxDifference;
+}
+
+String ZenBenchmark::benchmarkConvolutionModes(double sampleRate, double impulseSeconds)
+{
+	String report("Convolution modes (" + String(impulseSeconds, 1) + "s IR, mono, tail inline) @ " + String(sampleRate, 0) + "Hz\n");
+
+	const AudioSampleBuffer impulse(ConvolutionReverb::createDefaultImpulseResponse(sampleRate, impulseSeconds));
+	const float* const ir = impulse.getReadPointer(0);
+	const int irLength = impulse.getNumSamples();
+
+	AudioSampleBuffer signal(1, 1 << 16);
+	fillWithNoise(signal);
+
+	for (int blockSize = minBlockSize; blockSize <= maxBlockSize; blockSize <<= 1)
+	{
+		PartitionedConvolver uniform;
+		NonUniformConvolver nonUniform;
+		HybridConvolver hybrid;
+
+		uniform.prepare(blockSize, ir, irLength);
+		nonUniform.prepare(sampleRate, blockSize, ir, irLength, nullptr);
+		hybrid.prepare(sampleRate, blockSize, ir, irLength, nullptr, true);
+
+		const double uniformNs = measureNanosecondsPerSample([&uniform](float* left, float*, int numSamples)
+		{
+			uniform.process(left, left, numSamples);
+		}, blockSize, 1 << 18);
+
+		const double nonUniformNs = measureNanosecondsPerSample([&nonUniform](float* left, float*, int numSamples)
+		{
+			nonUniform.process(left, left, numSamples);
+		}, blockSize, 1 << 18);
+
+		const double hybridNs = measureNanosecondsPerSample([&hybrid](float* left, float*, int numSamples)
+		{
+			hybrid.process(left, left, numSamples);
+		}, blockSize, 1 << 18);
+
+		uniform.reset();
+		nonUniform.reset();
+		hybrid.reset();
+
+		AudioSampleBuffer uniformOut, nonUniformOut, hybridOut;
+		renderAligned(uniform, uniform.getLatencySamples(), signal, uniformOut, blockSize);
+		renderAligned(nonUniform, nonUniform.getLatencySamples(), signal, nonUniformOut, blockSize);
+		renderAligned(hybrid, hybrid.getLatencySamples(), signal, hybridOut, blockSize);
+
+		report << "  block " << String(blockSize).paddedLeft(' ', 5)
+			<< ": uniform " << String(uniformNs, 2) << " (latency " << uniform.getLatencySamples() << ")"
+			<< ", non-uniform " << String(nonUniformNs, 2) << " (latency " << nonUniform.getLatencySamples() << ")"
+			<< ", hybrid " << String(hybridNs, 2) << " (latency " << hybrid.getLatencySamples() << ") ns/sample"
+			<< ", max diff vs uniform " << String(getMaxDifference(uniformOut, nonUniformOut), 8)
+			<< " / " << String(getMaxDifference(uniformOut, hybridOut), 8) << "\n";
+	}
+
+	return report;
+}
+
+String ZenBenchmark::benchmarkTrueStereoConvolution(double sampleRate, double impulseSeconds)
+{
+	String report("True stereo convolution (" + String(impulseSeconds, 1) + "s IR, uniform) @ " + String(sampleRate, 0) + "Hz\n");
+
+	const AudioSampleBuffer impulse(ConvolutionReverb::createDefaultImpulseResponse(sampleRate, impulseSeconds, 4));
+	const int irLength = impulse.getNumSamples();
+	const float* impulses[4];
+
+	for (int path = 0; path < 4; ++path)
+		impulses[path] = impulse.getReadPointer(path);
+
+	for (int blockSize = minBlockSize; blockSize <= maxBlockSize; blockSize <<= 1)
+	{
+		PartitionedConvolver shared;
+		shared.prepare(blockSize, impulses, irLength, 2, 2);
+
+		OwnedArray<PartitionedConvolver> paths;
+
+		for (int path = 0; path < 4; ++path)
+			paths.add(new PartitionedConvolver())->prepare(blockSize, impulses[path], irLength);
+
+		AudioSampleBuffer pathOutputs(4, blockSize);
+
+		auto processShared = [&shared](float* left, float* right, int numSamples)
+		{
+			const float* const inputs[2] = { left, right };
+			float* const outputs[2] = { left, right };
+			shared.process(inputs, outputs, numSamples);
+		};
+
+		// Naive version: every path transforms its own input and runs its own inverse FFT
+		auto processPaths = [&paths, &pathOutputs](float* left, float* right, int numSamples)
+		{
+			for (int path = 0; path < 4; ++path)
+				paths.getUnchecked(path)->process(path < 2 ? left : right, pathOutputs.getWritePointer(path), numSamples);
+
+			// Paths are LL, LR, RL, RR
+			FloatVectorOperations::add(pathOutputs.getWritePointer(0), pathOutputs.getReadPointer(2), numSamples);
+			FloatVectorOperations::add(pathOutputs.getWritePointer(1), pathOutputs.getReadPointer(3), numSamples);
+			FloatVectorOperations::copy(left, pathOutputs.getReadPointer(0), numSamples);
+			FloatVectorOperations::copy(right, pathOutputs.getReadPointer(1), numSamples);
+		};
+
+		const double sharedNs = measureNanosecondsPerSample(processShared, blockSize, 1 << 18);
+		const double pathsNs = measureNanosecondsPerSample(processPaths, blockSize, 1 << 18);
+
+		// Same noise through both from a cleared state
+		shared.reset();
+
+		for (int path = 0; path < 4; ++path)
+			paths.getUnchecked(path)->reset();
+
+		AudioSampleBuffer sharedOut(2, 1 << 14);
+		fillWithNoise(sharedOut);
+		AudioSampleBuffer pathsOut(sharedOut);
+		float maxDifference = 0.0f;
+
+		for (int start = 0; start < sharedOut.getNumSamples(); start += blockSize)
+		{
+			processShared(sharedOut.getWritePointer(0, start), sharedOut.getWritePointer(1, start), blockSize);
+			processPaths(pathsOut.getWritePointer(0, start), pathsOut.getWritePointer(1, start), blockSize);
+		}
+
+		for (int channel = 0; channel < 2; ++channel)
+			for (int i = 0; i < sharedOut.getNumSamples(); ++i)
+				maxDifference = jmax(maxDifference, std::abs(sharedOut.getSample(channel, i) - pathsOut.getSample(channel, i)));
+
+		report << "  block " << String(blockSize).paddedLeft(' ', 5)
+			<< ": shared spectra " << String(sharedNs, 2)
+			<< ", four mono paths " << String(pathsNs, 2) << " ns/sample"
+			<< " (" << String(pathsNs / jmax(sharedNs, 1.0e-9), 2) << "x)"
+			<< ", max diff " << String(maxDifference, 8) << "\n";
+	}
+
+	return report;
+}
+
+/// Stereo node for the graph benchmark that leaves its block as it is
+class PassThroughProcessor : public AudioProcessor
+{
+public:
+	PassThroughProcessor() { setPlayConfigDetails(2, 2, 44100.0, 512); }
+
+	void processBlock(AudioSampleBuffer&, MidiBuffer&) override {}
+
+	const String getName() const override { return "Pass Through"; }
+	void prepareToPlay(double, int) override {}
+	void releaseResources() override {}
+	const String getInputChannelName(int) const override { return String(); }
+	const String getOutputChannelName(int) const override { return String(); }
+	bool isInputChannelStereoPair(int) const override { return true; }
+	bool isOutputChannelStereoPair(int) const override { return true; }
+	bool silenceInProducesSilenceOut() const override { return true; }
+	double getTailLengthSeconds() const override { return 0.0; }
+	bool acceptsMidi() const override { return false; }
+	bool producesMidi() const override { return false; }
+	AudioProcessorEditor* createEditor() override { return nullptr; }
+	bool hasEditor() const override { return false; }
+	int getNumPrograms() override { return 0; }
+	int getCurrentProgram() override { return 0; }
+	void setCurrentProgram(int) override {}
+	const String getProgramName(int) override { return String(); }
+	void changeProgramName(int, const String&) override {}
+	void getStateInformation(juce::MemoryBlock&) override {}
+	void setStateInformation(const void*, int) override {}
+
+private:
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PassThroughProcessor)
+};
+
+String ZenBenchmark::benchmarkGraphPlanning(double sampleRate, int blockSize)
+{
+	String report("Graph planning, stereo pass-through nodes, block " + String(blockSize) + " @ " + String(sampleRate, 0) + "Hz\n");
+
+	for (int numNodes = 100; numNodes <= 10000; numNodes *= 10)
+	{
+		NewAudioProcessorGraph graph;
+		Random rng(0x5eed);
+		Array<uint32> nodeIds;
+
+		// Every connection runs from an earlier node to a later one, so the edits never have to reorder much
+		const int64 editStart = Time::getHighResolutionTicks();
+
+		{
+			const NewAudioProcessorGraph::ScopedUpdate batch(graph);
+
+			for (int i = 0; i < numNodes; ++i)
+			{
+				const uint32 nodeId = graph.addNode(new PassThroughProcessor())->nodeId;
+
+				for (int source = 0; i > 0 && source < 1 + (i & 1); ++source)
+				{
+					const uint32 sourceId = nodeIds.getUnchecked(rng.nextInt(i));
+					graph.addConnection(sourceId, 0, nodeId, 0);
+					graph.addConnection(sourceId, 1, nodeId, 1);
+				}
+
+				nodeIds.add(nodeId);
+			}
+		}
+
+		const double editSeconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - editStart);
+
+		// Plans and builds the program on this thread before returning
+		graph.setPlayConfigDetails(2, 2, sampleRate, blockSize);
+		const int64 planStart = Time::getHighResolutionTicks();
+		graph.prepareToPlay(sampleRate, blockSize);
+		const double planSeconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - planStart);
+
+		int numFound = 0;
+		const int64 queryStart = Time::getHighResolutionTicks();
+
+		for (int i = 0; i < numNodes; ++i)
+		{
+			const uint32 sourceId = nodeIds.getUnchecked(rng.nextInt(numNodes));
+			const uint32 destId = nodeIds.getUnchecked(rng.nextInt(numNodes));
+
+			if (graph.isConnected(sourceId, destId) || graph.getConnectionBetween(sourceId, 0, destId, 0) != nullptr)
+				++numFound;
+		}
+
+		const double querySeconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - queryStart);
+		graph.releaseResources();
+
+		report << "  " << String(numNodes).paddedLeft(' ', 5) << " nodes, " << graph.getNumConnections() << " connections"
+			<< ": edits " << String(editSeconds * 1.0e6, 0) << " us (" << String(editSeconds * 1.0e9 / numNodes, 0)
+			<< " ns/node), plan " << String(planSeconds * 1.0e6, 0) << " us (" << String(planSeconds * 1.0e9 / numNodes, 0)
+			<< " ns/node), queries " << String(querySeconds * 1.0e9 / numNodes, 0) << " ns/query (" << numFound << " hits)\n";
+	}
+
+	return report;
+}
+
+String ZenBenchmark::runAllBenchmarks(double sampleRate)
+{
+	String report;
+	report << benchmarkFDNReverb(sampleRate, 8);
+	report << benchmarkFDNReverb(sampleRate, 16);
+	report << benchmarkFDNReverb(sampleRate, 8, true);
+	report << benchmarkRoomReverb(sampleRate);
+	report << benchmarkPlateReverb(sampleRate);
+	report << benchmarkEarlyReflections(sampleRate, 256);
+	report << benchmarkBiquadBank(sampleRate, 8);
+	report << benchmarkParameterSmoothing(sampleRate);
+	report << benchmarkDecibelConversion(512);
+	report << benchmarkConvolutionReverb(sampleRate, 4.0);
+	report << benchmarkConvolutionModes(sampleRate, 2.0);
+	report << benchmarkTrueStereoConvolution(sampleRate, 2.0);
+	report << benchmarkGraphPlanning(sampleRate, 512);
+	return report;
+}
+
+} // Namespace Zen
@@ -0,0 +1,129 @@
+/* ==============================================================================
+//  ZenBenchmark.h
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Static micro-benchmarks for the DSP engines.  Each benchmark returns
+//  a printable report, e.g. DBG(ZenBenchmark::benchmarkFDNReverb());
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#ifndef ZEN_BENCHMARK_H_INCLUDED
+#define ZEN_BENCHMARK_H_INCLUDED
+#include "JuceHeader.h"
+
+namespace Zen
+{
+
+	/// <summary> Static method container for engine benchmarks </summary>
+	class ZenBenchmark
+	{
+	public:
+		enum
+		{
+			minBlockSize = 32,
+			maxBlockSize = 1024
+		};
+
+		/// <summary> Times a block processing function and returns the cost in nanoseconds per sample.
+		/// The input block is refilled from noise before every call so engines never settle into denormals
+		/// or silence.  The (tiny) cost of that copy is included in the result. </summary>
+		/// <param name="processBlock"> Callable taking (float* left, float* right, int numSamples) </param>
+		/// <param name="blockSize">    Number of samples per call </param>
+		/// <param name="totalSamples"> Approximate number of samples to process in total </param>
+		/// <returns> Nanoseconds per sample (per channel pair) </returns>
+		template <typename BlockProcessor>
+		static double measureNanosecondsPerSample(BlockProcessor&& processBlock, int blockSize, int totalSamples = 1 << 20)
+		{
+			AudioSampleBuffer noise(2, blockSize), work(2, blockSize);
+			fillWithNoise(noise);
+
+			const int numBlocks = jmax(1, totalSamples / blockSize);
+
+			// Warm up caches and let the tail build up before timing
+			for (int i = 0; i < jmin(numBlocks, 64); ++i)
+			{
+				work.copyFrom(0, 0, noise, 0, 0, blockSize);
+				work.copyFrom(1, 0, noise, 1, 0, blockSize);
+				processBlock(work.getWritePointer(0), work.getWritePointer(1), blockSize);
+			}
+
+			const int64 startTicks = Time::getHighResolutionTicks();
+
+			for (int i = 0; i < numBlocks; ++i)
+			{
+				work.copyFrom(0, 0, noise, 0, 0, blockSize);
+				work.copyFrom(1, 0, noise, 1, 0, blockSize);
+				processBlock(work.getWritePointer(0), work.getWritePointer(1), blockSize);
+			}
+
+			const double seconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - startTicks);
+			return seconds * 1.0e9 / (static_cast<double>(numBlocks) * blockSize);
+		}
+
+		/// <summary> Reports ns/sample for the FDN reverb at block sizes 32 - 1024, optionally with the three band
+		/// decay crossover running in the feedback loop </summary>
+		static String benchmarkFDNReverb(double sampleRate = 48000.0, int numLines = 8, bool multibandDecay = false);
+
+		/// <summary> Reports ns/sample for the Dattorro plate reverb at block sizes 32 - 1024 </summary>
+		static String benchmarkPlateReverb(double sampleRate = 48000.0);
+
+		/// <summary> Reports ns/sample for the velvet-noise early reflections at their largest size across the density
+		/// range, with the cost per tap, which should stay flat since the work is linear in the tap count. </summary>
+		static String benchmarkEarlyReflections(double sampleRate = 48000.0, int blockSize = 256);
+
+		/// <summary> Runs numFilters high shelves over one channel each, through the lane-packed BiquadBank and through
+		/// one juce::IIRFilter per channel.  Reports ns/sample (per stereo frame) for both at block sizes 32 - 1024. </summary>
+		static String benchmarkBiquadBank(double sampleRate = 48000.0, int numFilters = 8);
+
+		/// <summary> Applies a smoothed gain parameter to a stereo block through the per sample getNextSmoothedValue()
+		/// loop and through the block rate getSmoothedValueBlock() with linear and multiplicative ramps.  Reports
+		/// ns/sample for each at block sizes 16 - 2048, with the parameter retargeted every block so it never settles. </summary>
+		static String benchmarkParameterSmoothing(double sampleRate = 48000.0);
+
+		/// <summary> Converts a block of decibel values to gains with pow(10, dB / 20), FastDecibels' interpolated table
+		/// and FastDecibels' vectorised block conversion.  Reports ns per value for each and the largest relative error
+		/// of both fast paths against pow in double precision. </summary>
+		static String benchmarkDecibelConversion(int blockSize = 512);
+
+		/// <summary> Compares the vectorised room engine (VectorFreeverb) with juce::Reverb::processStereo on the same
+		/// parameters: ns/sample for each at block sizes 32 - 1024, the speedup, and the largest output difference. </summary>
+		static String benchmarkRoomReverb(double sampleRate = 48000.0);
+
+		/// <summary> Reports ns/sample for the convolution reverb (tail computed inline) plus the partition layout at the smallest block size </summary>
+		static String benchmarkConvolutionReverb(double sampleRate = 48000.0, double impulseSeconds = 4.0);
+
+		/// <summary> Compares the uniform, non-uniform and zero latency hybrid convolvers on the same mono impulse:
+		/// ns/sample at block sizes 32 - 1024, and the largest output difference from the uniform convolver
+		/// once each output is realigned by its reported latency. </summary>
+		static String benchmarkConvolutionModes(double sampleRate = 48000.0, double impulseSeconds = 2.0);
+
+		/// <summary> True stereo (LL, LR, RL, RR) on one 2 x 2 PartitionedConvolver, which shares each input's spectra
+		/// between both outputs, against four independent mono convolvers summed per output.  Reports ns/sample at
+		/// block sizes 32 - 1024 and the largest output difference between the two. </summary>
+		static String benchmarkTrueStereoConvolution(double sampleRate = 48000.0, double impulseSeconds = 2.0);
+
+		/// <summary> Builds graphs of 100, 1000 and 10000 stereo pass-through nodes, each fed by one or two earlier nodes,
+		/// and reports the cost of the edits, of planning and building a rendering program in prepareToPlay(), and of
+		/// connection queries.  Costs are also given per node, which should stay roughly flat as the graph grows. </summary>
+		static String benchmarkGraphPlanning(double sampleRate = 48000.0, int blockSize = 512);
+
+		/// <summary> Runs every benchmark and concatenates the reports </summary>
+		static String runAllBenchmarks(double sampleRate = 48000.0);
+
+		/// <summary> Fills every channel of the buffer with uniform noise in -0.5 to 0.5 </summary>
+		static void fillWithNoise(AudioSampleBuffer& buffer);
+
+	private:
+		static String formatResult(int blockSize, double nanosecondsPerSample);
+
+		ZenBenchmark() {};
+		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ZenBenchmark);
+	};
+}
+#endif  // ZEN_BENCHMARK_H_INCLUDED
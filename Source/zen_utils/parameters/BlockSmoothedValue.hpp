@@ -0,0 +1,199 @@
+/*==============================================================================
+//  BlockSmoothedValue.hpp
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Parameter smoother that produces a whole block of ramp values at
+//  once, with linear or multiplicative (exponential) ramps
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+#ifndef BLOCKSMOOTHEDVALUE_H_INCLUDED
+#define BLOCKSMOOTHEDVALUE_H_INCLUDED
+
+#include "JuceHeader.h"
+#include <cmath>
+
+namespace Zen
+{
+
+/// <summary> Smooths a value towards its target over a fixed number of samples.
+///
+/// getNextBlock() fills a caller provided buffer with a whole block of the ramp, or returns false when the value
+/// holds still for the block so the caller can apply getTargetValue() with one scalar vector multiply.  The per
+/// sample getNextValue() walks the same ramp (to float rounding), so the two can be mixed freely.  Multiplicative
+/// ramps step by a constant ratio, which sounds even for gains; they need a positive start and target and fall
+/// back to a linear ramp for any ramp that touches zero. </summary>
+class BlockSmoothedValue
+{
+public:
+	enum RampType
+	{
+		linearRamp = 0,
+		multiplicativeRamp
+	};
+
+	BlockSmoothedValue() noexcept
+		: currentValue(0), target(0), step(0), countdown(0), stepsToTarget(0), rampType(linearRamp), isMultiplicative(false)
+	{
+	}
+
+	/// <summary> Sets the ramp length and jumps straight to the current target </summary>
+	void reset(double sampleRate, double rampLengthSeconds) noexcept
+	{
+		jassert(sampleRate > 0 && rampLengthSeconds >= 0);
+		stepsToTarget = static_cast<int>(std::floor(rampLengthSeconds * sampleRate));
+		currentValue = target;
+		countdown = 0;
+	}
+
+	/// <summary> Takes effect from the next target change </summary>
+	void setRampType(RampType newType) noexcept { rampType = newType; }
+	RampType getRampType() const noexcept { return rampType; }
+
+	void setCurrentAndTargetValue(float newValue) noexcept
+	{
+		currentValue = target = newValue;
+		countdown = 0;
+	}
+
+	void setTargetValue(float newValue) noexcept
+	{
+		if (newValue == target) return;
+
+		target = newValue;
+		countdown = stepsToTarget;
+
+		if (countdown <= 0)
+		{
+			currentValue = target;
+			return;
+		}
+
+		isMultiplicative = (rampType == multiplicativeRamp) && currentValue > 0.0f && target > 0.0f;
+
+		if (isMultiplicative)
+			step = std::exp((std::log(target) - std::log(currentValue)) / static_cast<float>(countdown));
+		else
+			step = (target - currentValue) / static_cast<float>(countdown);
+	}
+
+	float getTargetValue() const noexcept { return target; }
+	float getCurrentValue() const noexcept { return currentValue; }
+	bool isSmoothing() const noexcept { return countdown > 0; }
+
+	/// <summary> Advances one sample and returns its value </summary>
+	float getNextValue() noexcept
+	{
+		if (countdown <= 0)
+			return target;
+
+		if (--countdown == 0)
+			currentValue = target;
+		else if (isMultiplicative)
+			currentValue *= step;
+		else
+			currentValue += step;
+
+		return currentValue;
+	}
+
+	/// <summary> Advances numSamples samples.  Fills ramp with their values and returns true while ramping, returns
+	/// false without touching ramp when the whole block sits at getTargetValue(). </summary>
+	bool getNextBlock(float* ramp, int numSamples) noexcept
+	{
+		if (countdown <= 0 || numSamples <= 0)
+			return false;
+
+		const int numRamped = jmin(numSamples, countdown);
+
+		if (isMultiplicative)
+			fillMultiplicative(ramp, numRamped);
+		else
+			fillLinear(ramp, numRamped);
+
+		countdown -= numRamped;
+
+		if (countdown == 0)
+			currentValue = ramp[numRamped - 1] = target;
+		else
+			currentValue = ramp[numRamped - 1];
+
+		if (numRamped < numSamples)
+			FloatVectorOperations::fill(ramp + numRamped, target, numSamples - numRamped);
+
+		return true;
+	}
+
+	/// <summary> Advances numSamples samples without producing them </summary>
+	void skip(int numSamples) noexcept
+	{
+		if (countdown <= 0 || numSamples <= 0)
+			return;
+
+		if (numSamples >= countdown)
+		{
+			currentValue = target;
+			countdown = 0;
+		}
+		else
+		{
+			currentValue = isMultiplicative ? currentValue * std::pow(step, static_cast<float>(numSamples))
+											: currentValue + step * static_cast<float>(numSamples);
+			countdown -= numSamples;
+		}
+	}
+
+private:
+	void fillLinear(float* ramp, int numSamples) const noexcept
+	{
+		// Each value comes from the start of the block rather than the previous sample, so it vectorises
+		const float start = currentValue;
+
+		for (int i = 0; i < numSamples; ++i)
+			ramp[i] = start + step * static_cast<float>(i + 1);
+	}
+
+	void fillMultiplicative(float* ramp, int numSamples) const noexcept
+	{
+		// Four interleaved geometric sequences, each stepping by step^4, break the multiply dependency chain
+		float lanes[4];
+		lanes[0] = currentValue * step;
+		lanes[1] = lanes[0] * step;
+		lanes[2] = lanes[1] * step;
+		lanes[3] = lanes[2] * step;
+
+		const float laneStep = (step * step) * (step * step);
+		int i = 0;
+
+		for (; i + 4 <= numSamples; i += 4)
+		{
+			ramp[i] = lanes[0];
+			ramp[i + 1] = lanes[1];
+			ramp[i + 2] = lanes[2];
+			ramp[i + 3] = lanes[3];
+
+			lanes[0] *= laneStep;
+			lanes[1] *= laneStep;
+			lanes[2] *= laneStep;
+			lanes[3] *= laneStep;
+		}
+
+		for (int lane = 0; i < numSamples; ++i, ++lane)
+			ramp[i] = lanes[lane];
+	}
+
+	float currentValue, target, step;
+	int countdown, stepsToTarget;
+	RampType rampType;
+	bool isMultiplicative;	///< Ramp type of the ramp in progress
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BlockSmoothedValue)
+};
+}
+
+#endif // BLOCKSMOOTHEDVALUE_H_INCLUDED
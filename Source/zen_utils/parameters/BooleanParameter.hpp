@@ -32,7 +32,7 @@
 namespace Zen
 {
 
-class BooleanParameter : public ZenParameter
+class BooleanParameter final : public ZenParameter
 {
 
 public:
@@ -54,8 +54,7 @@ public:
 
 	virtual void BooleanParameter::setValue(bool newBool)
 	{	
-		value = convertBooleanToFloat(newBool);
-		requestUIUpdate = true;
+		ZenParameter::setValue(convertBooleanToFloat(newBool));
 	}
 
 	virtual void BooleanParameter::setValueNotifyingHost(bool newBoolValue) 
@@ -67,7 +66,13 @@ public:
 
 	virtual bool isOn() const
 	{
-		return convertFloatToBoolean(value.getValue());
+		return convertFloatToBoolean(getValue());
+	}
+
+	/// <summary> isOn() for the audio thread, follows getProcessingValue() </summary>
+	bool isProcessingOn() const noexcept
+	{
+		return convertFloatToBoolean(getProcessingValue());
 	}
 
 protected:
@@ -0,0 +1,79 @@
+/* ==============================================================================
+//  ChoiceParameter.hpp
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Derived AudioProcessorParameter selecting one of a fixed number
+//  of index slots, e.g. a reverb engine
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+#ifndef ZEN_CHOICE_PARAMETER_H_INCLUDED
+#define ZEN_CHOICE_PARAMETER_H_INCLUDED
+
+#include "JuceHeader.h"
+#include "ZenParameter.hpp"
+
+namespace Zen
+{
+
+/// <summary> Picks one of numSlots indices.  The host still sees a normalized 0 - 1 value, but it is spread over
+/// numSlots, not over the choices that exist today, so slot i is always stored as i / (numSlots - 1).  Reserve more
+/// slots than there are choices and new choices can be added without saved sessions or automation moving to a
+/// different one.  Slots past the last named choice select the last one. </summary>
+class ChoiceParameter final : public ZenParameter
+{
+public:
+	/// <param name="choiceNames"> Names of the choices that exist, separated by '|' </param>
+	ChoiceParameter(const String& parameterName, const String& choiceNames, int numSlots_, int defaultIndex)
+		: ZenParameter(parameterName, 0.0f, 1.0f, getValueForIndex(defaultIndex, numSlots_), 1.0f / (numSlots_ - 1), false),
+		  choices(StringArray::fromTokens(choiceNames, "|", String())), numSlots(numSlots_)
+	{
+		jassert(numSlots > 1 && choices.size() <= numSlots);
+	}
+
+	/// <summary> The normalized value that selects index out of numSlots </summary>
+	static constexpr float getValueForIndex(int index, int numSlots)
+	{
+		return static_cast<float>(index) / (numSlots - 1);
+	}
+
+	/// <summary> The selected choice, as the host and GUI see it </summary>
+	int getIndex() const noexcept { return getIndexForValue(getValue()); }
+
+	/// <summary> getIndex() for the audio thread, follows getProcessingValue() </summary>
+	int getProcessingIndex() const noexcept { return getIndexForValue(getProcessingValue()); }
+
+	int getNumChoices() const noexcept { return choices.size(); }
+
+	int getNumSteps() const override { return numSlots; }
+
+	String getText(float inValue, int maxStringLength) const override
+	{
+		return choices[getIndexForValue(inValue)].substring(0, maxStringLength);
+	}
+
+	float getValueForText(const String& text) const override
+	{
+		const int index = choices.indexOf(text.trim(), true);
+		return index >= 0 ? getValueForIndex(index, numSlots) : text.getFloatValue();
+	}
+
+private:
+	int getIndexForValue(float normalizedValue) const noexcept
+	{
+		return jlimit(0, jmax(0, choices.size() - 1), roundToInt(normalizedValue * (numSlots - 1)));
+	}
+
+	const StringArray choices;
+	const int numSlots;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ChoiceParameter);
+};
+
+}//namespace
+#endif   // ZEN_CHOICE_PARAMETER_H_INCLUDED
@@ -17,11 +17,12 @@
 
 #include "FloatParameter.hpp"
 #include "..\utilities\DecibelConversions.hpp"
+#include "..\utilities\FastDecibels.h"
 
 namespace Zen
 {
 using juce::String;
-class DecibelParameter : public FloatParameter
+class DecibelParameter final : public FloatParameter
 {
 
 public:
@@ -70,13 +71,15 @@ public:
 	{
 //		DBGM("In DecibelParameter::setFromXML(inXML) ");
 		XmlElement* thisXML = inXML.getChildByName(this->name);
-		setValue(thisXML->getDoubleAttribute("parameterValue", -9876.5));
-		setDefaultValue(thisXML->getDoubleAttribute("defaultValue", -9876.5));
-		setShouldBeSmoothed(thisXML->getBoolAttribute("isSmoothed", false));
-		setMinDecibels(thisXML->getDoubleAttribute("minDecibels", -9876.5));
-		setMaxDecibels(thisXML->getDoubleAttribute("maxDecibels", -9876.5));
-		setUnityDecibels(thisXML->getDoubleAttribute("unityDecibels", -9876.5));
-		setMidValue(thisXML->getDoubleAttribute("midValue", -9876.5));
+		if (thisXML == nullptr) return;	// Added since the session was saved, keep the default
+
+		setValue(thisXML->getDoubleAttribute("parameterValue", getValue()));
+		setDefaultValue(thisXML->getDoubleAttribute("defaultValue", getDefaultValue()));
+		setShouldBeSmoothed(thisXML->getBoolAttribute("isSmoothed", getShouldBeSmoothed()));
+		setMinDecibels(thisXML->getDoubleAttribute("minDecibels", getMinDecibels()));
+		setMaxDecibels(thisXML->getDoubleAttribute("maxDecibels", getMaxDecibels()));
+		setUnityDecibels(thisXML->getDoubleAttribute("unityDecibels", getUnityDecibels()));
+		setMidValue(thisXML->getDoubleAttribute("midValue", getMidValue()));
 	}
 
 	virtual void setValueTree() override
@@ -90,20 +93,17 @@ public:
 
 		paramValueTree->setProperty("parameterValue", getValue(), nullptr);
 		paramValueTree->setProperty("defaultValue", getDefaultValue(), nullptr);*/
+		static const Identifier isSmoothedId("isSmoothed"), minDecibelsId("minDecibels"), maxDecibelsId("maxDecibels"),
+			unityDecibelsId("unityDecibels"), midValueId("midValue");
+
 		ZenParameter::setValueTree();
-		paramValueTree->setProperty("isSmoothed", getShouldBeSmoothed(), nullptr);
-		paramValueTree->setProperty("minDecibels", getMinDecibels(), nullptr);
-		paramValueTree->setProperty("maxDecibels", getMaxDecibels(), nullptr);
-		paramValueTree->setProperty("unityDecibels", getUnityDecibels(), nullptr);
-		paramValueTree->setProperty("midValue", getMidValue(), nullptr);
+		setMirrorProperty(isSmoothedId, getShouldBeSmoothed());
+		setMirrorProperty(minDecibelsId, getMinDecibels());
+		setMirrorProperty(maxDecibelsId, getMaxDecibels());
+		setMirrorProperty(unityDecibelsId, getUnityDecibels());
+		setMirrorProperty(midValueId, getMidValue());
 	}
 
-	virtual void valueChanged(Value& value) override
-	{
-		//		DBGM("In ZenParameter::valueChanged(value) ");
-		setValueTree();
-	}
-	
 	virtual float convertDecibelsToLinearWithSetMidpoint(const float& decibels)
 	{
 //		DBGM("In DecibelParameter::convertDecibelsToLinearWithSetMidpoint() with result: " + String(result));
@@ -128,8 +128,29 @@ public:
 	/// <returns> The smoothed raw decibel gain value. </returns>
 	virtual float getSmoothedRawDecibelGainValue()
 	{
-		
-		return DecibelConversions::decibelRangeGainToRawDecibelGain(getNextSmoothedValue(), minDecibels, maxDecibels);
+		const float smoothedDecibels = ZenParamUtils::convertMidpointWarpedLinearNormalizedValueToRawRangeValue(getNextSmoothedValue(), minDecibels, maxDecibels, 0.0f);
+		return FastDecibels::decibelsToGain(smoothedDecibels, minDecibels);
+	}
+
+	/// <summary> Block rate version of getSmoothedRawDecibelGainValue().  Fills gains with numSamples smoothed raw
+	/// gains and returns true while the parameter is moving, returns false and leaves gains alone when the
+	/// gain holds at getSmoothedRawDecibelGainTarget() for the whole block. </summary>
+	virtual bool getSmoothedRawDecibelGainBlock(float* gains, int numSamples)
+	{
+		if (!getSmoothedValueBlock(gains, numSamples))
+			return false;
+
+		// The whole ramp goes normalized -> decibels -> gain in two vector passes, no pow per sample
+		FastDecibels::convertNormalizedToRange(gains, gains, numSamples, minDecibels, maxDecibels, 0.0f);
+		FastDecibels::decibelsToGain(gains, gains, numSamples, minDecibels);
+		return true;
+	}
+
+	/// <summary> The raw gain a non-ramping block holds at </summary>
+	virtual float getSmoothedRawDecibelGainTarget() const
+	{
+		const float targetDecibels = ZenParamUtils::convertMidpointWarpedLinearNormalizedValueToRawRangeValue(getSmoothedTargetValue(), minDecibels, maxDecibels, 0.0f);
+		return FastDecibels::decibelsToGain(targetDecibels, minDecibels);
 	}
 
 	virtual void setValueNotifyingHost(float newValue) override
@@ -0,0 +1,195 @@
+/*==============================================================================
+//  MidiControllerMap.cpp
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: MIDI CC learn and the lock-free controller table
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#include "MidiControllerMap.h"
+
+namespace Zen
+{
+
+namespace
+{
+const int learnPollRateHz = 20;
+const size_t stateRecordSize = 6;
+}
+
+MidiControllerMap::MidiControllerMap()
+	: learnTarget(-1), learnedAssignment(-1)
+{
+	clearAll();
+}
+
+MidiControllerMap::~MidiControllerMap()
+{
+	stopTimer();
+}
+
+void MidiControllerMap::assign(int channel, int controller, int parameterIndex)
+{
+	jassert(isPositiveAndBelow(parameterIndex, 0x7fff));
+	const int slot = getSlot(channel, controller);
+
+	if (isChannelModeSlot(slot))
+	{
+		jassertfalse;	// Channel mode messages can't drive parameters
+		return;
+	}
+
+	const ScopedLock sl(editLock);
+	editedTable.targets[slot] = static_cast<int16>(parameterIndex);
+	publish();
+}
+
+void MidiControllerMap::clearParameter(int parameterIndex)
+{
+	const ScopedLock sl(editLock);
+
+	for (int i = 0; i < numSlots; ++i)
+	{
+		if (editedTable.targets[i] == parameterIndex)
+			editedTable.targets[i] = -1;
+	}
+
+	publish();
+}
+
+void MidiControllerMap::clearAll()
+{
+	const ScopedLock sl(editLock);
+
+	for (int i = 0; i < numSlots; ++i)
+		editedTable.targets[i] = -1;
+
+	publish();
+}
+
+int MidiControllerMap::findSlotFor(int parameterIndex) const
+{
+	const ScopedLock sl(editLock);
+
+	for (int i = 0; i < numSlots; ++i)
+		if (editedTable.targets[i] == parameterIndex)
+			return i;
+
+	return -1;
+}
+
+int MidiControllerMap::getParameterFor(int channel, int controller) const
+{
+	const ScopedLock sl(editLock);
+	return editedTable.targets[getSlot(channel, controller)];
+}
+
+void MidiControllerMap::startLearning(int parameterIndex)
+{
+	jassert(isPositiveAndBelow(parameterIndex, 0x7fff));
+	learnedAssignment.store(-1);
+	learnTarget.store(parameterIndex);
+	startTimerHz(learnPollRateHz);
+}
+
+void MidiControllerMap::stopLearning()
+{
+	learnTarget.store(-1);
+	learnedAssignment.store(-1);
+	stopTimer();
+}
+
+void MidiControllerMap::claimForLearning(int slot) noexcept
+{
+	// The exchange makes sure only one CC is claimed, however many arrive before the timer picks it up
+	const int parameterIndex = learnTarget.exchange(-1, std::memory_order_acq_rel);
+
+	if (parameterIndex >= 0)
+		learnedAssignment.store((parameterIndex << 16) | slot, std::memory_order_release);
+}
+
+void MidiControllerMap::timerCallback()
+{
+	const int assignment = learnedAssignment.exchange(-1, std::memory_order_acquire);
+
+	if (assignment < 0)
+		return;
+
+	// Learning moves a parameter to the new controller rather than adding a second one
+	const int parameterIndex = assignment >> 16;
+	const ScopedLock sl(editLock);
+
+	for (int i = 0; i < numSlots; ++i)
+	{
+		if (editedTable.targets[i] == parameterIndex)
+			editedTable.targets[i] = -1;
+	}
+
+	editedTable.targets[assignment & 0xffff] = static_cast<int16>(parameterIndex);
+	publish();
+
+	stopTimer();
+	sendChangeMessage();
+}
+
+void MidiControllerMap::publish()
+{
+	// Callers hold editLock, which keeps publishedTable to one writer at a time
+	publishedTable.publish(editedTable);
+}
+
+//==============================================================================
+void MidiControllerMap::writeState(MemoryBlock& destData, const uint32* parameterIds, int numParameters) const
+{
+	MemoryOutputStream output(destData, false);
+	const ScopedLock sl(editLock);
+
+	for (int i = 0; i < numSlots; ++i)
+	{
+		const int target = editedTable.targets[i];
+
+		if (isPositiveAndBelow(target, numParameters))
+		{
+			output.writeInt(static_cast<int>(parameterIds[target]));
+			output.writeShort(static_cast<short>(i));
+		}
+	}
+}
+
+void MidiControllerMap::restoreState(const void* data, size_t size, const uint32* parameterIds, int numParameters)
+{
+	const uint8* const bytes = static_cast<const uint8*>(data);
+	const ScopedLock sl(editLock);
+
+	for (int i = 0; i < numSlots; ++i)
+		editedTable.targets[i] = -1;
+
+	for (size_t position = 0; position + stateRecordSize <= size; position += stateRecordSize)
+	{
+		const uint32 id = ByteOrder::littleEndianInt(bytes + position);
+		const int slot = ByteOrder::littleEndianShort(bytes + position + 4);
+
+		if (!isPositiveAndBelow(slot, static_cast<int>(numSlots)) || isChannelModeSlot(slot))
+			continue;
+
+		// Mappings onto parameters this version doesn't have are dropped
+		for (int parameter = 0; parameter < numParameters; ++parameter)
+		{
+			if (parameterIds[parameter] == id)
+			{
+				editedTable.targets[slot] = static_cast<int16>(parameter);
+				break;
+			}
+		}
+	}
+
+	publish();
+}
+
+} // namespace Zen
@@ -0,0 +1,137 @@
+/*==============================================================================
+//  MidiControllerMap.h
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: MIDI CC learn, and the lock-free channel x controller table the
+//  audio thread dispatches incoming CCs through
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#ifndef MIDICONTROLLERMAP_H_INCLUDED
+#define MIDICONTROLLERMAP_H_INCLUDED
+
+#include "JuceHeader.h"
+#include "../utilities/TripleBuffer.hpp"
+#include <atomic>
+
+namespace Zen
+{
+
+/// <summary> Which parameter, if any, each of the 16 x 128 MIDI channel/controller pairs drives.
+///
+/// The map is edited under a lock and published whole through a TripleBuffer, so the audio thread looks a CC up with
+/// one array index into a table nobody else is writing, and never takes the lock.  Edits normally come from the
+/// message thread, but restoring and writing state may come from whichever thread the host saves and loads on.
+/// Learning works the same way round: startLearning() arms a parameter, the audio thread claims the next CC it
+/// sees for it and hands the pair back through an atomic, and a message thread timer assigns it, publishes, and
+/// sends a change message.
+///
+/// Controllers 120 to 127 are channel mode messages (All Sound Off, All Notes Off and the like), so they are
+/// never learned, mapped or dispatched. </summary>
+class MidiControllerMap : public ChangeBroadcaster, private Timer
+{
+public:
+	enum
+	{
+		numChannels = 16,
+		numControllers = 128,
+		numSlots = numChannels * numControllers,
+		firstChannelModeController = 120	///< This and above are channel mode messages, not controllers
+	};
+
+	MidiControllerMap();
+	~MidiControllerMap();
+
+	//==============================================================================
+	// Message thread only, apart from the state calls
+
+	/// <summary> Makes controller (0 to 119) on channel (1 to 16) drive parameterIndex, taking it from whatever it
+	/// drove before </summary>
+	void assign(int channel, int controller, int parameterIndex);
+
+	/// <summary> Removes every mapping onto parameterIndex </summary>
+	void clearParameter(int parameterIndex);
+	void clearAll();
+
+	/// <summary> The next CC the audio thread receives is assigned to parameterIndex </summary>
+	void startLearning(int parameterIndex);
+	void stopLearning();
+	bool isLearning() const noexcept { return learnTarget.load(std::memory_order_relaxed) >= 0; }
+
+	/// <summary> Parameter waiting for a CC, or -1 </summary>
+	int getLearningParameter() const noexcept { return learnTarget.load(std::memory_order_relaxed); }
+
+	/// <summary> The first channel/controller slot driving parameterIndex, as (channel - 1) * 128 + controller, or -1 </summary>
+	int findSlotFor(int parameterIndex) const;
+
+	/// <summary> Parameter a channel/controller pair drives, or -1 </summary>
+	int getParameterFor(int channel, int controller) const;
+
+	/// <summary> Saved state form: one { uint32 parameter ID, uint16 slot } record per mapping, little endian.
+	/// Parameters are stored by ID rather than index so mappings survive parameters being added.  Any thread: both
+	/// take the edit lock, so a host saving or loading off the message thread can't race an edit. </summary>
+	void writeState(MemoryBlock& destData, const uint32* parameterIds, int numParameters) const;
+	void restoreState(const void* data, size_t size, const uint32* parameterIds, int numParameters);
+
+	//==============================================================================
+	/// <summary> Calls dispatch(parameterIndex, normalizedValue, samplePosition) for every mapped CC in midi, in buffer
+	/// order, and claims the first CC for learning if a parameter is armed.  Reads the raw bytes so nothing is copied
+	/// or allocated.  Audio thread only. </summary>
+	template <typename Dispatch>
+	void dispatchControllers(const MidiBuffer& midi, Dispatch&& dispatch) noexcept
+	{
+		const Table& table = publishedTable.read();
+		const uint8* data;
+		int numBytes, samplePosition;
+
+		for (MidiBuffer::Iterator iterator(midi); iterator.getNextEvent(data, numBytes, samplePosition);)
+		{
+			if (numBytes < 3 || (data[0] & 0xf0) != 0xb0 || (data[1] & 0x7f) >= firstChannelModeController)
+				continue;
+
+			const int slot = ((data[0] & 0x0f) << 7) | (data[1] & 0x7f);
+
+			if (learnTarget.load(std::memory_order_relaxed) >= 0)
+				claimForLearning(slot);
+
+			const int target = table.targets[slot];
+
+			if (target >= 0)
+				dispatch(target, (data[2] & 0x7f) * (1.0f / 127.0f), samplePosition);
+		}
+	}
+
+private:
+	struct Table
+	{
+		int16 targets[numSlots];	///< Parameter index per slot, -1 when unmapped
+	};
+
+	static int getSlot(int channel, int controller) noexcept
+	{
+		jassert(channel >= 1 && channel <= numChannels && isPositiveAndBelow(controller, static_cast<int>(numControllers)));
+		return ((channel - 1) << 7) | controller;
+	}
+
+	static bool isChannelModeSlot(int slot) noexcept { return (slot & 0x7f) >= firstChannelModeController; }
+
+	void claimForLearning(int slot) noexcept;
+	void publish();
+	void timerCallback() override;
+
+	CriticalSection editLock;	///< Held by everything that reads or writes editedTable, and by publish()
+	Table editedTable;
+	TripleBuffer<Table> publishedTable;
+	std::atomic<int> learnTarget, learnedAssignment;	///< learnedAssignment packs (parameterIndex << 16) | slot, -1 when empty
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MidiControllerMap)
+};
+
+} // namespace Zen
+#endif // MIDICONTROLLERMAP_H_INCLUDED
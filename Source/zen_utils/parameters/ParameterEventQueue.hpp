@@ -0,0 +1,133 @@
+/*==============================================================================
+//  ParameterEventQueue.hpp
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Lock-free queue of timestamped parameter changes, written by the
+//  host, GUI and MIDI and read once per block by the audio thread
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+#ifndef PARAMETEREVENTQUEUE_H_INCLUDED
+#define PARAMETEREVENTQUEUE_H_INCLUDED
+
+#include "JuceHeader.h"
+#include <atomic>
+
+namespace Zen
+{
+
+/// <summary> One parameter change, to take effect sampleOffset samples into the next block the audio thread processes </summary>
+struct ParameterEvent
+{
+	int parameterIndex;
+	int sampleOffset;
+	float value;
+};
+
+/// <summary> Fixed capacity ring of ParameterEvents with a single consumer, the audio thread.
+///
+/// push() never locks or allocates.  Each slot carries a sequence number that says whether it is free or published,
+/// so a push from the host's automation thread can overlap one from the GUI thread without either waiting on the
+/// other.  pop() stops at the first slot that isn't published yet; whatever is behind it is picked up next block.
+/// A push that finds the ring full is dropped and flagged, so the consumer can resynchronise from the parameters'
+/// own atomic values instead of silently missing a change. </summary>
+class ParameterEventQueue
+{
+public:
+	enum
+	{
+		capacity = 512	///< Must be a power of two
+	};
+
+	ParameterEventQueue() noexcept
+		: writePosition(0), readPosition(0), overflowed(false)
+	{
+		static_assert((capacity & (capacity - 1)) == 0, "ParameterEventQueue capacity must be a power of two");
+
+		for (uint32 i = 0; i < capacity; ++i)
+			slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	/// <summary> Queues an event from any thread.  Returns false, and flags the overflow, when the ring is full. </summary>
+	bool push(const ParameterEvent& event) noexcept
+	{
+		uint32 position = writePosition.load(std::memory_order_relaxed);
+
+		for (;;)
+		{
+			Slot& slot = slots[position & mask];
+			const int32 difference = static_cast<int32>(slot.sequence.load(std::memory_order_acquire) - position);
+
+			if (difference == 0)
+			{
+				if (writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				{
+					slot.event = event;
+					slot.sequence.store(position + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (difference < 0)
+			{
+				overflowed.store(true, std::memory_order_relaxed);
+				return false;
+			}
+			else
+			{
+				position = writePosition.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	/// <summary> Takes the oldest published event.  Consumer thread only. </summary>
+	bool pop(ParameterEvent& event) noexcept
+	{
+		Slot& slot = slots[readPosition & mask];
+
+		if (slot.sequence.load(std::memory_order_acquire) != readPosition + 1)
+			return false;
+
+		event = slot.event;
+		slot.sequence.store(readPosition + capacity, std::memory_order_release);
+		++readPosition;
+		return true;
+	}
+
+	/// <summary> True once after any push has been dropped.  Consumer thread only. </summary>
+	bool checkAndClearOverflow() noexcept
+	{
+		return overflowed.exchange(false, std::memory_order_relaxed);
+	}
+
+	/// <summary> Throws away everything queued so far.  Consumer thread only. </summary>
+	void clear() noexcept
+	{
+		ParameterEvent discarded;
+		while (pop(discarded)) {}
+		checkAndClearOverflow();
+	}
+
+private:
+	struct Slot
+	{
+		std::atomic<uint32> sequence;
+		ParameterEvent event;
+	};
+
+	static const uint32 mask = capacity - 1;
+
+	Slot slots[capacity];
+	std::atomic<uint32> writePosition;
+	uint32 readPosition;
+	std::atomic<bool> overflowed;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterEventQueue)
+};
+}
+
+#endif // PARAMETEREVENTQUEUE_H_INCLUDED
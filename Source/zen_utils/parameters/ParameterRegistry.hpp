@@ -0,0 +1,190 @@
+/*==============================================================================
+//  ParameterRegistry.hpp
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Compile-time parameter layout: every parameter declared once with
+//  its type, range and smoothing, then created, indexed and iterated without RTTI
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+#ifndef PARAMETERREGISTRY_H_INCLUDED
+#define PARAMETERREGISTRY_H_INCLUDED
+
+#include "JuceHeader.h"
+#include "FloatParameter.hpp"
+#include "DecibelParameter.hpp"
+#include "BooleanParameter.hpp"
+#include "ChoiceParameter.hpp"
+
+namespace Zen
+{
+
+enum class ParameterKind
+{
+	floatParameter,
+	decibelParameter,
+	booleanParameter,
+	choiceParameter
+};
+
+/// <summary> Maps a ParameterKind onto the class that implements it </summary>
+template <ParameterKind Kind> struct ParameterClass;
+template <> struct ParameterClass<ParameterKind::floatParameter>	{ typedef FloatParameter type; };
+template <> struct ParameterClass<ParameterKind::decibelParameter>	{ typedef DecibelParameter type; };
+template <> struct ParameterClass<ParameterKind::booleanParameter>	{ typedef BooleanParameter type; };
+template <> struct ParameterClass<ParameterKind::choiceParameter>	{ typedef ChoiceParameter type; };
+
+/// <summary> FNV-1a hash of a parameter name, one single-return constexpr step per character.  Used as the
+/// parameter's ID in saved state, so it must never change for a shipped parameter. </summary>
+constexpr uint32 hashParameterName(const char* name, uint32 hash = 2166136261u)
+{
+	return (*name == 0) ? hash : hashParameterName(name + 1, (hash ^ static_cast<uint8>(*name)) * 16777619u);
+}
+
+/// <summary> Everything needed to construct one parameter.  Build these with floatSpec(), decibelSpec(),
+/// booleanSpec() and choiceSpec() rather than by hand.  Decibel parameters keep their normalized 0 - 1 range and put
+/// the decibel range in minDecibels and maxDecibels. </summary>
+struct ParameterSpec
+{
+	ParameterKind kind;
+	const char* name;
+	uint32 id;	///< hashParameterName(name)
+	float minValue, maxValue, defaultValue, step;
+	bool shouldBeSmoothed;
+	float smoothingTime;
+	const char* label;
+	float minDecibels, maxDecibels;
+	const char* choiceNames;	///< '|' separated, choice parameters only
+	int numSlots;
+};
+
+constexpr ParameterSpec floatSpec(const char* name, float minValue, float maxValue, float defaultValue, float step = 0.01f,
+								  bool shouldBeSmoothed = false, float smoothingTime = 0.01f, const char* label = "")
+{
+	return { ParameterKind::floatParameter, name, hashParameterName(name), minValue, maxValue, defaultValue, step, shouldBeSmoothed, smoothingTime, label, 0.0f, 0.0f, nullptr, 0 };
+}
+
+constexpr ParameterSpec decibelSpec(const char* name, float minDecibels, float maxDecibels, float defaultValue, float step = 0.01f,
+									bool shouldBeSmoothed = true, float smoothingTime = 0.01f, const char* label = "dB")
+{
+	return { ParameterKind::decibelParameter, name, hashParameterName(name), 0.0f, 1.0f, defaultValue, step, shouldBeSmoothed, smoothingTime, label, minDecibels, maxDecibels, nullptr, 0 };
+}
+
+constexpr ParameterSpec booleanSpec(const char* name, bool defaultValue)
+{
+	return { ParameterKind::booleanParameter, name, hashParameterName(name), 0.0f, 1.0f, defaultValue ? 1.0f : 0.0f, 1.0f, false, 0.0f, "", 0.0f, 0.0f, nullptr, 0 };
+}
+
+/// <summary> numSlots fixes what every stored value means, so it must never change for a shipped parameter:
+/// reserve room for the choices still to come. </summary>
+constexpr ParameterSpec choiceSpec(const char* name, const char* choiceNames, int numSlots, int defaultIndex = 0)
+{
+	return { ParameterKind::choiceParameter, name, hashParameterName(name), 0.0f, 1.0f, ChoiceParameter::getValueForIndex(defaultIndex, numSlots),
+			 1.0f / (numSlots - 1), false, 0.0f, "", 0.0f, 0.0f, choiceNames, numSlots };
+}
+
+/// <summary> Creates and indexes the parameters declared by Layout, which provides:
+///   enum { ..., numParameters }	- one enumerator per parameter, in host index order
+///   static constexpr ParameterSpec specs[numParameters]
+///
+/// get<Layout::someParameter>() returns the concrete parameter class, so the audio thread calls it without a cast
+/// and, for final classes, without a virtual dispatch.  Iteration and operator[] give ZenParameter* by host
+/// index, which is also the index a ParameterEvent carries. </summary>
+template <typename Layout>
+class ParameterRegistry
+{
+public:
+	enum
+	{
+		numParameters = Layout::numParameters
+	};
+
+	template <int Index>
+	using ParameterType = typename ParameterClass<Layout::specs[Index].kind>::type;
+
+	ParameterRegistry() noexcept
+	{
+		for (int i = 0; i < numParameters; ++i)
+		{
+			parameters[i] = nullptr;
+			ids[i] = Layout::specs[i].id;
+			defaultValues[i] = Layout::specs[i].defaultValue;
+		}
+	}
+
+	/// <summary> Creates every parameter and hands it to processor, which owns it from then on.  Call once, from the
+	/// processor's constructor, before any other parameters are added so host indices match Layout's. </summary>
+	void createParameters(AudioProcessor& processor)
+	{
+		for (int i = 0; i < numParameters; ++i)
+		{
+			parameters[i] = createParameter(Layout::specs[i]);
+			processor.addParameter(parameters[i]);
+			jassert(parameters[i]->getParameterIndex() == i);
+		}
+	}
+
+	template <int Index>
+	ParameterType<Index>* get() const noexcept
+	{
+		static_assert(Index >= 0 && Index < numParameters, "Parameter index out of range");
+		return static_cast<ParameterType<Index>*>(parameters[Index]);
+	}
+
+	ZenParameter* operator[](int index) const noexcept	{ return parameters[index]; }
+	int size() const noexcept							{ return numParameters; }
+
+	/// <summary> Saved state IDs, in the same order as the parameters </summary>
+	const uint32* getIds() const noexcept				{ return ids; }
+
+	/// <summary> Layout's default values, in the same order as the parameters </summary>
+	const float* getDefaultValues() const noexcept		{ return defaultValues; }
+
+	/// <summary> Whether parameter index sweeps a continuous range, as float and decibel parameters do, rather than
+	/// switching between steps like boolean and choice parameters </summary>
+	static bool isContinuous(int index) noexcept
+	{
+		const ParameterKind kind = Layout::specs[index].kind;
+		return kind == ParameterKind::floatParameter || kind == ParameterKind::decibelParameter;
+	}
+
+	ZenParameter* const* begin() const noexcept	{ return parameters; }
+	ZenParameter* const* end() const noexcept	{ return parameters + numParameters; }
+
+private:
+	static ZenParameter* createParameter(const ParameterSpec& spec)
+	{
+		switch (spec.kind)
+		{
+			case ParameterKind::decibelParameter:
+				return new DecibelParameter(spec.name, spec.shouldBeSmoothed, spec.smoothingTime, spec.minDecibels, spec.maxDecibels,
+											0.0f, spec.minValue, spec.maxValue, 0.5f, spec.defaultValue, spec.step, spec.label);
+
+			case ParameterKind::booleanParameter:
+				return new BooleanParameter(spec.name, spec.defaultValue != 0.0f);
+
+			case ParameterKind::choiceParameter:
+				return new ChoiceParameter(spec.name, spec.choiceNames, spec.numSlots, roundToInt(spec.defaultValue * (spec.numSlots - 1)));
+
+			case ParameterKind::floatParameter:
+			default:
+				return new FloatParameter(spec.name, spec.minValue, spec.maxValue, spec.defaultValue, spec.step,
+										  spec.shouldBeSmoothed, spec.smoothingTime, spec.label);
+		}
+	}
+
+	//DO NOT DELETE, the processor's managedParameters owns these
+	ZenParameter* parameters[numParameters];
+	uint32 ids[numParameters];
+	float defaultValues[numParameters];
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterRegistry)
+};
+}
+
+#endif // PARAMETERREGISTRY_H_INCLUDED
@@ -0,0 +1,310 @@
+/*==============================================================================
+//  ParameterState.hpp
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Versioned fixed-layout binary plugin state: parameter values by ID
+//  plus tagged blobs for engine data, read and written without allocating
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+#ifndef PARAMETERSTATE_H_INCLUDED
+#define PARAMETERSTATE_H_INCLUDED
+
+#include "JuceHeader.h"
+#include "ZenParameter.hpp"
+#include <cstring>
+
+namespace Zen
+{
+
+/// <summary> Four characters packed into a blob tag, readable in a hex dump </summary>
+constexpr uint32 makeStateTag(char a, char b, char c, char d)
+{
+	return static_cast<uint32>(static_cast<uint8>(a)) | (static_cast<uint32>(static_cast<uint8>(b)) << 8)
+		| (static_cast<uint32>(static_cast<uint8>(c)) << 16) | (static_cast<uint32>(static_cast<uint8>(d)) << 24);
+}
+
+/// <summary> Layout of the binary state, all fields little endian:
+///
+///   header		uint32 magic, uint16 version, uint16 headerSize, uint32 numParameters, uint32 numBlobs
+///   parameters	numParameters x { uint32 id, float value }
+///   blobs			numBlobs x { uint32 tag, uint32 size, size bytes padded to a multiple of 4 }
+///
+/// Readers skip headerSize bytes rather than assuming the header's length, so later versions can grow it.  Values
+/// are matched to parameters by ID, so parameters can be added or retired without breaking old sessions. </summary>
+struct ParameterState
+{
+	enum
+	{
+		currentVersion = 1,
+		headerSize = 16,
+		parameterRecordSize = 8,
+		blobHeaderSize = 8
+	};
+
+	static const uint32 magic = makeStateTag('Z', 'n', 'S', 't');
+
+	/// <summary> An engine blob: for writing, data points at the caller's bytes; after reading, into the state </summary>
+	struct Blob
+	{
+		uint32 tag;
+		const void* data;
+		uint32 size;
+	};
+
+	static uint32 paddedSize(uint32 size) noexcept { return (size + 3) & ~3u; }
+};
+
+//==============================================================================
+/// <summary> Writes a state into a MemoryBlock, sized once up front </summary>
+class ParameterStateWriter
+{
+public:
+	static void write(MemoryBlock& destData, ZenParameter* const* parameters, const uint32* ids, int numParameters,
+					  const ParameterState::Blob* blobs = nullptr, int numBlobs = 0)
+	{
+		size_t totalSize = ParameterState::headerSize + static_cast<size_t>(numParameters) * ParameterState::parameterRecordSize;
+
+		for (int i = 0; i < numBlobs; ++i)
+			totalSize += ParameterState::blobHeaderSize + ParameterState::paddedSize(blobs[i].size);
+
+		destData.setSize(totalSize, true);
+		uint8* position = static_cast<uint8*>(destData.getData());
+
+		position = writeInt(position, ParameterState::magic);
+		position = writeShort(position, ParameterState::currentVersion);
+		position = writeShort(position, ParameterState::headerSize);
+		position = writeInt(position, static_cast<uint32>(numParameters));
+		position = writeInt(position, static_cast<uint32>(numBlobs));
+
+		for (int i = 0; i < numParameters; ++i)
+		{
+			position = writeInt(position, ids[i]);
+			position = writeFloat(position, parameters[i]->getValue());
+		}
+
+		for (int i = 0; i < numBlobs; ++i)
+		{
+			position = writeInt(position, blobs[i].tag);
+			position = writeInt(position, blobs[i].size);
+
+			if (blobs[i].size > 0)
+				std::memcpy(position, blobs[i].data, blobs[i].size);
+
+			// setSize zeroed the padding
+			position += ParameterState::paddedSize(blobs[i].size);
+		}
+
+		jassert(position == static_cast<uint8*>(destData.getData()) + totalSize);
+	}
+
+private:
+	static uint8* writeInt(uint8* position, uint32 value) noexcept
+	{
+		const uint32 littleEndian = ByteOrder::swapIfBigEndian(value);
+		std::memcpy(position, &littleEndian, sizeof(littleEndian));
+		return position + sizeof(littleEndian);
+	}
+
+	static uint8* writeShort(uint8* position, uint16 value) noexcept
+	{
+		const uint16 littleEndian = ByteOrder::swapIfBigEndian(value);
+		std::memcpy(position, &littleEndian, sizeof(littleEndian));
+		return position + sizeof(littleEndian);
+	}
+
+	static uint8* writeFloat(uint8* position, float value) noexcept
+	{
+		uint32 bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		return writeInt(position, bits);
+	}
+};
+
+//==============================================================================
+/// <summary> Validates and reads a state in place.  Nothing is copied: blobs point into the caller's data, which
+/// must outlive the reader. </summary>
+class ParameterStateReader
+{
+public:
+	ParameterStateReader(const void* data, int sizeInBytes) noexcept
+		: start(static_cast<const uint8*>(data)), size(sizeInBytes > 0 ? static_cast<uint32>(sizeInBytes) : 0),
+		  numParameters(0), numBlobs(0), parametersStart(nullptr), blobsStart(nullptr), valid(false)
+	{
+		valid = parse();
+	}
+
+	/// <summary> True when the data is a binary state this version can read.  Anything else, e.g. XML from older
+	/// sessions, is left to the caller. </summary>
+	bool isValid() const noexcept { return valid; }
+
+	static bool isBinaryState(const void* data, int sizeInBytes) noexcept
+	{
+		return sizeInBytes >= 4 && readInt(static_cast<const uint8*>(data)) == ParameterState::magic;
+	}
+
+	/// <summary> Sets every parameter whose ID is in the state.  Parameters the state doesn't mention keep their
+	/// current values, and IDs no parameter has are skipped.  Returns the number of parameters set. </summary>
+	int applyTo(ZenParameter* const* parameters, const uint32* ids, int numIds) const
+	{
+		if (!valid) return 0;
+
+		int numApplied = 0;
+
+		for (uint32 record = 0; record < numParameters; ++record)
+		{
+			const uint8* const position = parametersStart + record * ParameterState::parameterRecordSize;
+			const int index = findIndex(readInt(position), static_cast<int>(record), ids, numIds);
+
+			if (index >= 0)
+			{
+				parameters[index]->setValue(readFloat(position + 4));
+				++numApplied;
+			}
+		}
+
+		return numApplied;
+	}
+
+	/// <summary> applyTo() for a plain snapshot: values[i] gets the stored value for ids[i], entries the state
+	/// doesn't mention are left alone.  Returns the number of values set. </summary>
+	int readValues(float* values, const uint32* ids, int numIds) const noexcept
+	{
+		if (!valid) return 0;
+
+		int numRead = 0;
+
+		for (uint32 record = 0; record < numParameters; ++record)
+		{
+			const uint8* const position = parametersStart + record * ParameterState::parameterRecordSize;
+			const int index = findIndex(readInt(position), static_cast<int>(record), ids, numIds);
+
+			if (index >= 0)
+			{
+				values[index] = readFloat(position + 4);
+				++numRead;
+			}
+		}
+
+		return numRead;
+	}
+
+	/// <summary> Finds the first blob with tag.  Returns false, leaving blob alone, if there isn't one. </summary>
+	bool findBlob(uint32 tag, ParameterState::Blob& blob) const noexcept
+	{
+		if (!valid) return false;
+
+		const uint8* position = blobsStart;
+
+		for (uint32 i = 0; i < numBlobs; ++i)
+		{
+			const uint32 blobSize = readInt(position + 4);
+
+			if (readInt(position) == tag)
+			{
+				blob.tag = tag;
+				blob.data = position + ParameterState::blobHeaderSize;
+				blob.size = blobSize;
+				return true;
+			}
+
+			position += ParameterState::blobHeaderSize + ParameterState::paddedSize(blobSize);
+		}
+
+		return false;
+	}
+
+private:
+	static int findIndex(uint32 id, int record, const uint32* ids, int numIds) noexcept
+	{
+		// States are normally written in the same order they're read, so try the matching index first
+		if (record < numIds && ids[record] == id)
+			return record;
+
+		for (int i = 0; i < numIds; ++i)
+			if (ids[i] == id)
+				return i;
+
+		return -1;
+	}
+
+	bool parse() noexcept
+	{
+		if (size < ParameterState::headerSize || readInt(start) != ParameterState::magic)
+			return false;
+
+		const uint32 version = readShort(start + 4);
+		const uint32 storedHeaderSize = readShort(start + 6);
+
+		if (version == 0 || version > ParameterState::currentVersion || storedHeaderSize < ParameterState::headerSize || storedHeaderSize > size)
+			return false;
+
+		numParameters = readInt(start + 8);
+		numBlobs = readInt(start + 12);
+
+		if (numParameters > (size - storedHeaderSize) / ParameterState::parameterRecordSize)
+			return false;
+
+		parametersStart = start + storedHeaderSize;
+		blobsStart = parametersStart + numParameters * ParameterState::parameterRecordSize;
+
+		// Walk the blob headers once so findBlob() never reads past the end
+		uint32 remaining = size - static_cast<uint32>(blobsStart - start);
+		const uint8* position = blobsStart;
+
+		for (uint32 i = 0; i < numBlobs; ++i)
+		{
+			if (remaining < ParameterState::blobHeaderSize)
+				return false;
+
+			const uint32 blobSize = readInt(position + 4);
+
+			if (blobSize > remaining - ParameterState::blobHeaderSize)
+				return false;
+
+			const uint32 blobSpan = jmin(remaining, ParameterState::blobHeaderSize + ParameterState::paddedSize(blobSize));
+			position += blobSpan;
+			remaining -= blobSpan;
+		}
+
+		return true;
+	}
+
+	static uint32 readInt(const uint8* position) noexcept
+	{
+		uint32 value;
+		std::memcpy(&value, position, sizeof(value));
+		return ByteOrder::swapIfBigEndian(value);
+	}
+
+	static uint32 readShort(const uint8* position) noexcept
+	{
+		uint16 value;
+		std::memcpy(&value, position, sizeof(value));
+		return ByteOrder::swapIfBigEndian(value);
+	}
+
+	static float readFloat(const uint8* position) noexcept
+	{
+		const uint32 bits = readInt(position);
+		float value;
+		std::memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	const uint8* start;
+	uint32 size, numParameters, numBlobs;
+	const uint8* parametersStart;
+	const uint8* blobsStart;
+	bool valid;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterStateReader)
+};
+}
+
+#endif // PARAMETERSTATE_H_INCLUDED
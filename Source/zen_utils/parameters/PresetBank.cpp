@@ -0,0 +1,217 @@
+/*==============================================================================
+//  PresetBank.cpp
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Preset library read through a memory-mapped file
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#include "PresetBank.h"
+#include "ParameterState.hpp"
+
+namespace Zen
+{
+
+namespace
+{
+const uint32 libraryMagic = makeStateTag('Z', 'n', 'P', 'L');
+
+uint32 readLibraryInt(const uint8* position) noexcept
+{
+	return ByteOrder::littleEndianInt(position);
+}
+
+/// Checks the header and returns where the directory starts and how many entries it has
+bool readLibraryHeader(const uint8* data, size_t size, uint32& storedHeaderSize, uint32& numStored) noexcept
+{
+	if (data == nullptr || size < PresetBank::headerSize || readLibraryInt(data) != libraryMagic)
+		return false;
+
+	const uint32 version = ByteOrder::littleEndianShort(data + 4);
+	storedHeaderSize = ByteOrder::littleEndianShort(data + 6);
+	numStored = readLibraryInt(data + 8);
+
+	return version > 0 && version <= PresetBank::currentVersion && storedHeaderSize >= PresetBank::headerSize
+		&& numStored <= (size - jmin(size, static_cast<size_t>(storedHeaderSize))) / PresetBank::directoryEntrySize;
+}
+
+/// One directory entry, false if it points outside the file
+bool readLibraryEntry(const uint8* data, size_t size, uint32 storedHeaderSize, uint32 index,
+	uint32& nameOffset, uint32& nameSize, uint32& stateOffset, uint32& stateSize) noexcept
+{
+	const uint8* const entry = data + storedHeaderSize + index * PresetBank::directoryEntrySize;
+	nameOffset = readLibraryInt(entry);
+	nameSize = readLibraryInt(entry + 4);
+	stateOffset = readLibraryInt(entry + 8);
+	stateSize = readLibraryInt(entry + 12);
+
+	return nameOffset <= size && nameSize <= size - nameOffset && stateOffset <= size && stateSize <= size - stateOffset;
+}
+}
+
+PresetBank::PresetBank(const uint32* parameterIds, const float* defaultValues, int inNumParameters)
+	: ids(parameterIds), numParameters(inNumParameters), numPresets(0)
+{
+	defaults.malloc(numParameters);
+	FloatVectorOperations::copy(defaults, defaultValues, numParameters);
+}
+
+PresetBank::~PresetBank()
+{
+}
+
+int PresetBank::getNumPresets() const
+{
+	const ScopedLock sl(lock);
+	return numPresets;
+}
+
+String PresetBank::getPresetName(int index) const
+{
+	const ScopedLock sl(lock);
+	return names[index];
+}
+
+bool PresetBank::copySnapshot(int index, float* destValues) const
+{
+	const ScopedLock sl(lock);
+
+	if (!isPositiveAndBelow(index, numPresets))
+		return false;
+
+	FloatVectorOperations::copy(destValues, snapshots + index * numParameters, numParameters);
+	return true;
+}
+
+bool PresetBank::loadLibrary(const File& libraryFile)
+{
+	const MemoryMappedFile mapping(libraryFile, MemoryMappedFile::readOnly);
+	const uint8* const data = static_cast<const uint8*>(mapping.getData());
+	const size_t size = mapping.getSize();
+
+	uint32 storedHeaderSize, numStored;
+
+	if (!readLibraryHeader(data, size, storedHeaderSize, numStored))
+		return false;
+
+	// Everything is decoded into fresh storage first, readers keep using the old bank meanwhile
+	HeapBlock<float> newSnapshots(jmax(1, static_cast<int>(numStored) * numParameters));
+	StringArray newNames;
+	int numDecoded = 0;
+
+	for (uint32 i = 0; i < numStored; ++i)
+	{
+		uint32 nameOffset, nameSize, stateOffset, stateSize;
+
+		if (!readLibraryEntry(data, size, storedHeaderSize, i, nameOffset, nameSize, stateOffset, stateSize))
+			continue;
+
+		const ParameterStateReader state(data + stateOffset, static_cast<int>(stateSize));
+
+		if (!state.isValid())
+			continue;
+
+		float* const snapshot = newSnapshots + numDecoded * numParameters;
+		FloatVectorOperations::copy(snapshot, defaults, numParameters);
+		state.readValues(snapshot, ids, numParameters);
+
+		newNames.add(String::fromUTF8(reinterpret_cast<const char*>(data + nameOffset), static_cast<int>(nameSize)));
+		++numDecoded;
+	}
+
+	const ScopedLock sl(lock);
+	snapshots.swapWith(newSnapshots);
+	numPresets = numDecoded;
+	names.swapWith(newNames);
+	return true;
+}
+
+bool PresetBank::writeLibrary(const File& libraryFile, const StringArray& names, const Array<MemoryBlock>& states)
+{
+	jassert(names.size() == states.size());
+	const int numToWrite = jmin(names.size(), states.size());
+
+	MemoryOutputStream directory, payload;
+	const uint32 dataStart = static_cast<uint32>(headerSize + numToWrite * directoryEntrySize);
+
+	for (int i = 0; i < numToWrite; ++i)
+	{
+		const uint32 nameOffset = dataStart + static_cast<uint32>(payload.getDataSize());
+		const uint32 nameSize = static_cast<uint32>(names[i].getNumBytesAsUTF8());
+		payload.write(names[i].toRawUTF8(), nameSize);
+
+		const uint32 stateOffset = dataStart + static_cast<uint32>(payload.getDataSize());
+		const uint32 stateSize = static_cast<uint32>(states.getReference(i).getSize());
+		payload.write(states.getReference(i).getData(), stateSize);
+
+		directory.writeInt(static_cast<int>(nameOffset));
+		directory.writeInt(static_cast<int>(nameSize));
+		directory.writeInt(static_cast<int>(stateOffset));
+		directory.writeInt(static_cast<int>(stateSize));
+	}
+
+	FileOutputStream output(libraryFile);
+
+	if (output.failedToOpen())
+		return false;
+
+	output.setPosition(0);
+	output.truncate();
+
+	// OutputStream writes little endian
+	output.writeInt(static_cast<int>(libraryMagic));
+	output.writeShort(static_cast<short>(currentVersion));
+	output.writeShort(static_cast<short>(headerSize));
+	output.writeInt(numToWrite);
+	output.writeInt(0);
+	output << directory << payload;
+	output.flush();
+
+	return !output.getStatus().failed();
+}
+
+bool PresetBank::readLibrary(const File& libraryFile, StringArray& names, Array<MemoryBlock>& states)
+{
+	const MemoryMappedFile mapping(libraryFile, MemoryMappedFile::readOnly);
+	const uint8* const data = static_cast<const uint8*>(mapping.getData());
+	const size_t size = mapping.getSize();
+	uint32 storedHeaderSize, numStored;
+
+	if (!readLibraryHeader(data, size, storedHeaderSize, numStored))
+		return false;
+
+	for (uint32 i = 0; i < numStored; ++i)
+	{
+		uint32 nameOffset, nameSize, stateOffset, stateSize;
+
+		if (!readLibraryEntry(data, size, storedHeaderSize, i, nameOffset, nameSize, stateOffset, stateSize))
+			continue;
+
+		names.add(String::fromUTF8(reinterpret_cast<const char*>(data + nameOffset), static_cast<int>(nameSize)));
+		states.add(MemoryBlock(data + stateOffset, stateSize));
+	}
+
+	return true;
+}
+
+bool PresetBank::appendToLibrary(const File& libraryFile, const String& name, const MemoryBlock& state)
+{
+	StringArray names;
+	Array<MemoryBlock> states;
+
+	// A file that exists but isn't a library is left alone rather than overwritten
+	if (libraryFile.existsAsFile() && !readLibrary(libraryFile, names, states))
+		return false;
+
+	names.add(name);
+	states.add(state);
+	return writeLibrary(libraryFile, names, states);
+}
+
+} // namespace Zen
@@ -0,0 +1,88 @@
+/*==============================================================================
+//  PresetBank.h
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Preset library read through a memory-mapped file and decoded up
+//  front into flat parameter snapshots, so switching programs never allocates
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#ifndef PRESETBANK_H_INCLUDED
+#define PRESETBANK_H_INCLUDED
+
+#include "JuceHeader.h"
+
+namespace Zen
+{
+
+/// <summary> A bank of presets, each a full set of parameter values.
+///
+/// The library file is a directory followed by the presets' names and their binary states (see ParameterState):
+///
+///   header		uint32 magic, uint16 version, uint16 headerSize, uint32 numPresets, uint32 reserved
+///   directory		numPresets x { uint32 nameOffset, uint32 nameSize, uint32 stateOffset, uint32 stateSize }
+///   data			UTF-8 names and ParameterState blocks, at the offsets the directory gives
+///
+/// loadLibrary() maps the file rather than reading it into memory, and decodes every preset into one contiguous
+/// block of snapshots while it's mapped.  A program change copies one snapshot of numParameters floats out under
+/// the bank's lock, which a load only holds to swap its new snapshots in. </summary>
+class PresetBank
+{
+public:
+	enum
+	{
+		currentVersion = 1,
+		headerSize = 16,
+		directoryEntrySize = 16
+	};
+
+	/// <summary> ids and defaultValues give the parameter order snapshots are stored in.  ids must outlive the bank;
+	/// the defaults are copied, and fill in any parameter a preset doesn't mention. </summary>
+	PresetBank(const uint32* parameterIds, const float* defaultValues, int numParameters);
+	~PresetBank();
+
+	/// <summary> Replaces the bank with the presets in libraryFile.  The file is decoded before the lock is taken,
+	/// so readers on other threads only ever see the whole old bank or the whole new one.  Message thread only. </summary>
+	bool loadLibrary(const File& libraryFile);
+
+	/// <summary> Writes a library of the given presets.  states are blocks written by ParameterStateWriter. </summary>
+	static bool writeLibrary(const File& libraryFile, const StringArray& names, const Array<MemoryBlock>& states);
+
+	/// <summary> Reads every preset's name and state block out of a library, as writeLibrary() takes them.
+	/// Entries that are out of bounds are skipped. </summary>
+	/// <returns> false if the file is missing or isn't a library </returns>
+	static bool readLibrary(const File& libraryFile, StringArray& names, Array<MemoryBlock>& states);
+
+	/// <summary> Rewrites libraryFile with one more preset on the end, creating it if it doesn't exist yet.
+	/// The existing presets are copied byte for byte.  Call loadLibrary() afterwards to use it. </summary>
+	static bool appendToLibrary(const File& libraryFile, const String& name, const MemoryBlock& state);
+
+	// Any thread
+	int getNumPresets() const;
+	String getPresetName(int index) const;
+
+	/// <summary> Copies preset index's numParameters values into destValues.  Doesn't allocate. </summary>
+	/// <returns> false, leaving destValues alone, if there's no such preset </returns>
+	bool copySnapshot(int index, float* destValues) const;
+
+private:
+	const uint32* const ids;
+	HeapBlock<float> defaults;
+	const int numParameters;
+
+	CriticalSection lock;	///< Guards snapshots, numPresets and names
+	HeapBlock<float> snapshots;
+	int numPresets;
+	StringArray names;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetBank)
+};
+
+} // namespace Zen
+#endif // PRESETBANK_H_INCLUDED
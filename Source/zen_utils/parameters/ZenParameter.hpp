@@ -18,11 +18,47 @@
 
 #include "JuceHeader.h"
 #include <sstream>
+#include <atomic>
 #include "../utilities/ZenParamUtils.h"
+#include "BlockSmoothedValue.hpp"
+#include "ParameterEventQueue.hpp"
 
 namespace Zen {
 using namespace juce;
-class ZenParameter : public AudioProcessorParameter, public ReferenceCountedObject, public ValueListener
+class ZenParameter;
+
+/// <summary> Message thread timer shared by every live ZenParameter, which brings dirty parameters' Value and
+/// ValueTree mirrors up to date at most updateRateHz times a second, however fast automation writes them. </summary>
+class ParameterMirrorTimer : private Timer
+{
+public:
+	enum
+	{
+		updateRateHz = 30
+	};
+
+	ParameterMirrorTimer()	{ startTimerHz(updateRateHz); }
+	~ParameterMirrorTimer()	{ stopTimer(); }
+
+	void addParameter(ZenParameter* parameter)		{ parameters.addIfNotAlreadyThere(parameter); }
+	void removeParameter(ZenParameter* parameter)	{ parameters.removeFirstMatchingValue(parameter); }
+
+private:
+	void timerCallback() override;
+
+	Array<ZenParameter*> parameters;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterMirrorTimer)
+};
+
+/// <summary> The value a parameter processes with is a lock-free atomic float, so host automation and the audio thread
+/// never touch a var.  The juce::Value and ValueTree views of it are mirrors that are only ever written on the
+/// message thread: setValue() just marks the parameter dirty and the shared ParameterMirrorTimer refreshes it,
+/// writing only the properties that changed.
+///
+/// Once attached to a processor's ParameterEventQueue, every change is also queued with its sample offset and the audio
+/// thread processes with getProcessingValue(), which only moves when the processor applies that event. </summary>
+class ZenParameter : public AudioProcessorParameter, public ReferenceCountedObject
 {
 
 public:
@@ -33,42 +69,34 @@ public:
 	}
 
 	explicit ZenParameter(const String &inName, const bool& inShouldBeSmoothed = false, const float& smoothingTime=0.01f) :
-		value(0.5), name(inName), smoothTime(smoothingTime), shouldBeSmoothed(inShouldBeSmoothed)
+		value(0.5f), defaultValue(0.0f), processingValue(0.5f), name(inName), requestUIUpdate(true), mirrorDirty(false), smoothTime(smoothingTime), shouldBeSmoothed(inShouldBeSmoothed)
 	{
 //		DBGM("In ZenParameter::ZenParameter() ");
-		setSmoothedValue(0.5);
-		paramValueTree = new ValueTree(this->name);
-		value.addListener(this);
-		defaultValue.addListener(this);
-		ZenParameter::setValueTree();
+		smoother.setCurrentAndTargetValue(0.5f);
+		initializeMirror();
 	}
 
 	ZenParameter(const String &inName, const float& inDefaultValue, const bool& inShouldBeSmoothed = false, const float& smoothingTime=0.01f, const String& inLabel = "") :
-		value(inDefaultValue), defaultValue(inDefaultValue), name(inName), unitLabel(inLabel), smoothTime(smoothingTime), shouldBeSmoothed(inShouldBeSmoothed)
+		value(inDefaultValue), defaultValue(inDefaultValue), processingValue(inDefaultValue), name(inName), unitLabel(inLabel), requestUIUpdate(true), mirrorDirty(false), smoothTime(smoothingTime), shouldBeSmoothed(inShouldBeSmoothed)
 	{
 //		DBGM("In ZenParameter::ZenParameter() ");
-		setSmoothedValue(inDefaultValue);
-		paramValueTree = new ValueTree(this->name);
-		value.addListener(this);
-		defaultValue.addListener(this);
-		ZenParameter::setValueTree();
+		smoother.setCurrentAndTargetValue(inDefaultValue);
+		initializeMirror();
 	}
 
 	ZenParameter(const String &inName, const float& inMinValue, const float& inMaxValue, const float& inDefaultValue, 
 		const float& inStep = 0.01f, const bool& inShouldBeSmoothed = false, const float& smoothingTime=0.01f, const String& inLabel = "") 
-		:value(inDefaultValue), defaultValue(inDefaultValue), minValue(inMinValue), 
-		maxValue(inMaxValue), intervalStep(inStep), name(inName), unitLabel(inLabel), smoothTime(smoothingTime), shouldBeSmoothed(inShouldBeSmoothed)
+		:value(inDefaultValue), defaultValue(inDefaultValue), processingValue(inDefaultValue), minValue(inMinValue), 
+		maxValue(inMaxValue), intervalStep(inStep), name(inName), unitLabel(inLabel), requestUIUpdate(true), mirrorDirty(false), smoothTime(smoothingTime), shouldBeSmoothed(inShouldBeSmoothed)
 	{
 //		DBGM("In ZenParameter::ZenParameter() ");
-		setSmoothedValue(inDefaultValue);
-		paramValueTree = new ValueTree(this->name);
-		value.addListener(this);
-		defaultValue.addListener(this);
-		ZenParameter::setValueTree();
+		smoother.setCurrentAndTargetValue(inDefaultValue);
+		initializeMirror();
 	}	
 
 	virtual ~ZenParameter()
 	{
+		mirrorTimer->removeParameter(this);
 		paramValueTree = nullptr;
 	};
 
@@ -87,18 +115,21 @@ public:
 	{
 //		DBGM("In ZenParameter::setFromXML(inXML) ");
 		XmlElement* thisXML = inXML.getChildByName(this->name);
-		setValue(thisXML->getDoubleAttribute("parameterValue", -9876.5));
-		setDefaultValue(thisXML->getDoubleAttribute("defaultValue", -9876.5));
-		setShouldBeSmoothed(thisXML->getBoolAttribute("isSmoothed", false));
+		if (thisXML == nullptr) return;	// Added since the session was saved, keep the default
+
+		setValue(thisXML->getDoubleAttribute("parameterValue", getValue()));
+		setDefaultValue(thisXML->getDoubleAttribute("defaultValue", getDefaultValue()));
+		setShouldBeSmoothed(thisXML->getBoolAttribute("isSmoothed", getShouldBeSmoothed()));
 	}
 
+	/// <summary> Brings the ValueTree mirror up to date with the atomic state, touching only properties whose values
+	/// changed so listeners hear about nothing else.  Message thread only. </summary>
 	virtual void setValueTree()
 	{
-		paramValueTree->removeAllChildren(nullptr);
-		paramValueTree->removeAllProperties(nullptr);
+		static const Identifier parameterValueId("parameterValue"), defaultValueId("defaultValue");
 
-		paramValueTree->setProperty("parameterValue", getValue(), nullptr);
-		paramValueTree->setProperty("defaultValue", getDefaultValue(), nullptr);
+		setMirrorProperty(parameterValueId, getValue());
+		setMirrorProperty(defaultValueId, getDefaultValue());
 	}
 
 	virtual ValueTree getValueTree()
@@ -106,18 +137,76 @@ public:
 		return *paramValueTree;
 	}
 
-	virtual void valueChanged(Value& value) override
+	/// <summary> Lock-free and allocation free, safe from the host's automation and audio threads.
+	/// The Value and ValueTree mirrors catch up on the next ParameterMirrorTimer tick, the smoother on the audio
+	/// thread's next read. </summary>
+	virtual void setValue(float inValue) override
 	{
-//		DBGM("In ZenParameter::valueChanged(value) ");
-		setValueTree();
+//		DBGM("In ZenParameter::setValue() ");
+		setValueAtSample(inValue, 0);
 	}
 
-	virtual void setValue(float inValue) override
+	/// <summary> setValue() for callers that know where in the next block the change belongs, e.g. MIDI events.
+	/// Without an event queue attached the offset is meaningless and this is a plain setValue(). </summary>
+	void setValueAtSample(float inValue, int sampleOffset)
 	{
-//		DBGM("In ZenParameter::setValue() ");
-		value = inValue;
-		setSmoothedValue(inValue);
-		requestUIUpdate = true;
+		value.store(inValue, std::memory_order_relaxed);
+		requestUIUpdate.store(true, std::memory_order_relaxed);
+
+		if (eventQueue != nullptr)
+		{
+			const ParameterEvent event = { getParameterIndex(), sampleOffset, inValue };
+			eventQueue->push(event);
+		}
+
+		mirrorDirty.store(true, std::memory_order_release);
+	}
+
+	/// <summary> Updates the value the host and GUI see without queueing an event, for changes the audio thread
+	/// applies itself with applyEvent(), such as program changes that wait for a fade. </summary>
+	void storeValue(float inValue)
+	{
+		value.store(inValue, std::memory_order_relaxed);
+		requestUIUpdate.store(true, std::memory_order_relaxed);
+		mirrorDirty.store(true, std::memory_order_release);
+	}
+
+	/// <summary> Routes every later change through queue.  Call from the processor's constructor, after the
+	/// parameter has been added, and before any audio is processed. </summary>
+	void setEventQueue(ParameterEventQueue* queue)
+	{
+		jassert(queue == nullptr || getParameterIndex() >= 0);
+		eventQueue = queue;
+		processingValue = getValue();
+	}
+
+	/// <summary> The value as of the current sample on the audio thread, plus any modulation.  With an event queue
+	/// attached it lags getValue() until the processor reaches the change's sample offset, otherwise it is getValue().
+	/// The smoothers target this, so modulation is smoothed exactly like automation. </summary>
+	float getProcessingValue() const noexcept
+	{
+		const float baseValue = (eventQueue != nullptr) ? processingValue : getValue();
+		return (modulationOffset != 0.0f) ? jlimit(minValue, maxValue, baseValue + modulationOffset) : baseValue;
+	}
+
+	/// <summary> Sets the offset a ModulationMatrix adds to the processing value, in normalized units.  The host
+	/// and GUI never see it.  Audio thread only. </summary>
+	void setModulation(float offset) noexcept
+	{
+		modulationOffset = offset;
+	}
+
+	/// <summary> Makes a queued change current.  Audio thread only, in sample order. </summary>
+	void applyEvent(float newValue) noexcept
+	{
+		processingValue = newValue;
+	}
+
+	/// <summary> Catches the processing value up with getValue() after queued changes were lost or thrown away.
+	/// Audio thread, or anywhere the audio thread is known to be stopped. </summary>
+	void syncProcessingValue() noexcept
+	{
+		processingValue = getValue();
 	}
 
 	//Juce's AudioProcessorParameter method changed to virtual
@@ -132,33 +221,29 @@ public:
 
 	virtual bool needsUIUpdate()
 	{
-		return requestUIUpdate;
+		return requestUIUpdate.load(std::memory_order_relaxed);
 	}
 
 	virtual bool checkUIUpdateAndReset()
 	{
-		bool updateSet = requestUIUpdate;
-		requestUIUpdate = false;
-		return updateSet;
+		return requestUIUpdate.exchange(false, std::memory_order_relaxed);
 	}
 
 	virtual void resetUIUpdate()
 	{
-		requestUIUpdate = false;
+		requestUIUpdate.store(false, std::memory_order_relaxed);
 	}
 
 	/// <summary> Re-initializes the smoothed value parameter configuration.  Should be called from
 	/// parameter constructors in parameters that allow smoothing.  Should also be called on any change
 	/// of sample rate or desired smoothing time.  This can all be done within the processor's prepareToPlay()</summary>
 	/// <param name="inSampleRate"> The current sample rate. </param>
-	/// <param name="inSmoothTime"> Time (in ms) to interpolate changes to this parameter </param>
+	/// <param name="inSmoothTime"> Time (in seconds) to interpolate changes to this parameter </param>
 	void resetSmoothedValue(float inSampleRate, float inSmoothTime)
 	{
 		jassert(inSampleRate > 0 && inSmoothTime >= 0);
-		stepsToTarget = static_cast<int>(std::floor(inSmoothTime * inSampleRate));
-		currentSmoothedValue = target;
-		countdown = 0;
 		smoothTime = inSmoothTime;
+		resetSmoothedValue(inSampleRate);
 	}
 
 	/// <summary> Re-initializes the smoothed value parameter configuration.  Should be called from
@@ -169,42 +254,42 @@ public:
 	void resetSmoothedValue(float inSampleRate)
 	{
 		jassert(inSampleRate > 0 && smoothTime >= 0);
-		stepsToTarget = static_cast<int>(std::floor(smoothTime * inSampleRate));
-		currentSmoothedValue = target;
-		countdown = 0;
-		
+		smoother.setCurrentAndTargetValue(getProcessingValue());
+		smoother.reset(inSampleRate, smoothTime);
 	}
 
-	/// <summary> Sets smoothed value. Should be called every time value is set/changed to a new value 
-	/// (Inside setvalue method)</summary>
+	/// <summary> Points the smoother at a new target.  Audio thread only: the getters below already pick up
+	/// every processing value change on their own, so this is only needed to smooth towards something else. </summary>
 	/// <param name="newValue"> The new value that the smoothing is TARGETING. </param>
 	void setSmoothedValue(float newValue)
 	{
-		if (!areAlmostEqual(target, newValue))
-		{
-			target = newValue;
-			countdown = stepsToTarget;
-
-			if (countdown <= 0)
-				currentSmoothedValue = target;
-			else
-				step = (target - currentSmoothedValue) / static_cast<float>(countdown);
-		}
+		smoother.setTargetValue(newValue);
 	}
 
 	/// <summary> Processes one sample worth of smoothing and returns the next (smoothed) value.
 	/// Should be called ONCE on EVERY sample's process cycle.</summary>
 	float getNextSmoothedValue() noexcept
 	{
-		
-		if (countdown <= 0)
-			return target;
+		smoother.setTargetValue(getProcessingValue());
+		return smoother.getNextValue();
+	}
 
-		--countdown;
-		currentSmoothedValue += step;
-		return currentSmoothedValue;
+	/// <summary> Block rate replacement for getNextSmoothedValue(), called once per block instead of once per sample.
+	/// Fills ramp with the next numSamples smoothed values and returns true while the value is moving.  Returns false
+	/// and leaves ramp alone when it holds at getSmoothedTargetValue() for the whole block, so the caller can apply
+	/// it with one scalar multiply. </summary>
+	bool getSmoothedValueBlock(float* ramp, int numSamples) noexcept
+	{
+		smoother.setTargetValue(getProcessingValue());
+		return smoother.getNextBlock(ramp, numSamples);
 	}
 
+	/// <summary> The value the smoother is heading for, which is what a non-ramping block holds at </summary>
+	float getSmoothedTargetValue() const noexcept { return smoother.getTargetValue(); }
+
+	/// <summary> Linear by default.  Multiplicative suits parameters that are gains themselves. </summary>
+	void setSmoothingRampType(BlockSmoothedValue::RampType newType) noexcept { smoother.setRampType(newType); }
+
 	bool checkShouldBeSmoothed() const
 	{
 //		DBGM("In ZenParameter::checkShouldBeSmoothed() ");
@@ -228,19 +313,27 @@ public:
 
 	virtual String getName() const { return name; };
 
-	virtual float getValue() const override { return value.getValue(); }
+	virtual float getValue() const override { return value.load(std::memory_order_relaxed); }
 
-	virtual float getMinValue() const {	return minValue.getValue(); }
+	virtual float getMinValue() const {	return minValue; }
 
-	virtual float getMaxValue() const {	return maxValue.getValue(); }
+	virtual float getMaxValue() const {	return maxValue; }
 
-	virtual float getDefaultValue() const override { return defaultValue.getValue(); }
+	virtual float getDefaultValue() const override { return defaultValue.load(std::memory_order_relaxed); }
 
 	virtual void setDefaultValue(float inValue)
 	{
-		defaultValue = inValue;
+		defaultValue.store(inValue, std::memory_order_relaxed);
+		mirrorDirty.store(true, std::memory_order_release);
 	}
 
+	/// <summary> Message thread mirror of the value for GUI bindings and debugging, never read it for processing.
+	/// It lags setValue() by up to one ParameterMirrorTimer tick. </summary>
+	Value& getValueObject() { return valueMirror; }
+
+	/// <summary> Message thread mirror of the default value </summary>
+	Value& getDefaultValueObject() { return defaultValueMirror; }
+
 	virtual bool getBoolFromValue() const
 	{		
 		return convertFloatToBoolean(getValue());
@@ -281,27 +374,82 @@ public:
 	
 
 protected:
-	Value value;
+	/// <summary> Builds the mirrors once, from the constructor on the message thread </summary>
+	void initializeMirror()
+	{
+		paramValueTree = new ValueTree(this->name);
+		valueMirror = getValue();
+		defaultValueMirror = getDefaultValue();
+		setValueTree();
+		mirrorTimer->addParameter(this);
+	}
+
+	/// <summary> Copies the atomic state into the Value and ValueTree mirrors.  Message thread only. </summary>
+	void updateMirror()
+	{
+		const float currentValue = getValue();
+		const float currentDefault = getDefaultValue();
+
+		if (static_cast<float>(valueMirror.getValue()) != currentValue)
+			valueMirror = currentValue;
+
+		if (static_cast<float>(defaultValueMirror.getValue()) != currentDefault)
+			defaultValueMirror = currentDefault;
+
+		setValueTree();
+	}
+
+	/// <summary> Writes one ValueTree mirror property, unless it already holds newValue </summary>
+	void setMirrorProperty(const Identifier& property, const var& newValue)
+	{
+		if (!paramValueTree->hasProperty(property) || paramValueTree->getProperty(property) != newValue)
+			paramValueTree->setProperty(property, newValue, nullptr);
+	}
+
+	std::atomic<float> value, defaultValue;
+	float processingValue;	///< Audio thread's view of value, see getProcessingValue()
+	float modulationOffset = 0.0f;
+	ParameterEventQueue* eventQueue = nullptr;
+	float minValue = 0.0f, maxValue = 1.0f;
+
+	// Message thread mirrors, see updateMirror()
+	Value valueMirror, defaultValueMirror;
 	ScopedPointer<ValueTree> paramValueTree;
 	
-	Value defaultValue, minValue, maxValue;
 	float intervalStep;
 	unsigned int precision=2;
 	String name, unitLabel = "", description = "";
-	bool requestUIUpdate = true;
+	std::atomic<bool> requestUIUpdate, mirrorDirty;
 
-	// Smoothing fields
-	double currentSmoothedValue = 0, stepsToTarget = 0, target = 0, step = 0, countdown = 0, smoothTime;
+	// Smoothing fields, the smoother belongs to the audio thread
+	BlockSmoothedValue smoother;
+	double smoothTime;
 	bool shouldBeSmoothed = false;
 
 	//==============================================================================
 	
 private:
+	friend class ParameterMirrorTimer;
+
+	/// <summary> Called on every ParameterMirrorTimer tick, does nothing unless something changed since the last one </summary>
+	void flushMirror()
+	{
+		if (mirrorDirty.exchange(false, std::memory_order_acquire))
+			updateMirror();
+	}
+
+	SharedResourcePointer<ParameterMirrorTimer> mirrorTimer;
 	
 	//JUCE_LEAK_DETECTOR(ZenParameter);
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ZenParameter);
 };
 
+inline void ParameterMirrorTimer::timerCallback()
+{
+	for (auto parameter : parameters)
+		parameter->flushMirror();
+}
+
 /// <summary> Values that represent parameter units. </summary>
 /*
 enum ParameterUnit
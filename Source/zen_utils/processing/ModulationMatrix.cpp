@@ -0,0 +1,362 @@
+/*==============================================================================
+//  ModulationMatrix.cpp
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Control-rate LFOs and envelope followers routed onto parameters
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#include "ModulationMatrix.h"
+#include "../utilities/ZenSIMD.hpp"
+#include "../utilities/ZenUtils.hpp"
+#include <cmath>
+
+namespace Zen
+{
+
+namespace
+{
+const float maxLfoRate = 20.0f;
+const float minEnvelopeTime = 0.001f;
+}
+
+ModulationMatrix::ModulationMatrix(int inNumTargets)
+	: numTargets(inNumTargets)
+{
+	offsets.allocate(static_cast<size_t>(jmax(1, numTargets)), true);
+	allowedTargets.allocate(static_cast<size_t>(jmax(1, numTargets)), false);
+
+	for (int i = 0; i < numTargets; ++i)
+		allowedTargets[i] = true;
+
+	buildWavetables();
+
+	for (int i = 0; i < numLfos; ++i)
+	{
+		editedSettings.lfoRates[i] = 0.5f;
+		editedSettings.lfoShapes[i] = sineShape;
+	}
+
+	for (int i = 0; i < numEnvelopes; ++i)
+	{
+		editedSettings.envelopeAttacks[i] = 0.01f;
+		editedSettings.envelopeReleases[i] = 0.25f;
+	}
+
+	for (int i = 0; i < maxRoutes; ++i)
+	{
+		editedSettings.routes[i].source = lfo1;
+		editedSettings.routes[i].target = -1;
+		editedSettings.routes[i].depth = 0.0f;
+	}
+
+	publish();
+	reset();
+}
+
+ModulationMatrix::~ModulationMatrix()
+{
+}
+
+void ModulationMatrix::buildWavetables()
+{
+	wavetables.allocate(static_cast<size_t>(numShapes * (tableSize + 1)), false);
+
+	for (int i = 0; i <= tableSize; ++i)
+	{
+		const float phase = static_cast<float>(i) / tableSize;
+
+		wavetables[sineShape * (tableSize + 1) + i] = static_cast<float>(std::sin(2.0 * double_Pi * phase));
+		wavetables[triangleShape * (tableSize + 1) + i] = 1.0f - 4.0f * std::abs(phase - 0.5f);
+		wavetables[sawShape * (tableSize + 1) + i] = 2.0f * phase - 1.0f;
+		wavetables[squareShape * (tableSize + 1) + i] = (phase < 0.5f) ? 1.0f : -1.0f;
+	}
+
+	// The last entry only exists for interpolation, and must repeat the first so every shape wraps cleanly
+	for (int shape = 0; shape < numShapes; ++shape)
+		wavetables[shape * (tableSize + 1) + tableSize] = wavetables[shape * (tableSize + 1)];
+}
+
+void ModulationMatrix::prepare(double inSampleRate)
+{
+	jassert(inSampleRate > 0);
+	tickSeconds = static_cast<float>(controlInterval / inSampleRate);
+	reset();
+}
+
+void ModulationMatrix::reset() noexcept
+{
+	for (int i = 0; i < numLfos; ++i)
+		lfoPhases[i] = 0.0f;
+
+	for (int i = 0; i < numEnvelopes; ++i)
+		envelopeLevels[i] = 0.0f;
+
+	for (int i = 0; i < numSources; ++i)
+		sourceValues[i] = 0.0f;
+
+	FloatVectorOperations::clear(offsets, jmax(1, numTargets));
+}
+
+//==============================================================================
+void ModulationMatrix::setLfo(int lfoIndex, float rateHz, Shape shape)
+{
+	jassert(isPositiveAndBelow(lfoIndex, static_cast<int>(numLfos)));
+	editedSettings.lfoRates[lfoIndex] = getClamped(rateHz, 0.0f, maxLfoRate);
+	editedSettings.lfoShapes[lfoIndex] = jlimit(0, numShapes - 1, static_cast<int>(shape));
+	publish();
+}
+
+void ModulationMatrix::setEnvelope(int envelopeIndex, float attackSeconds, float releaseSeconds)
+{
+	jassert(isPositiveAndBelow(envelopeIndex, static_cast<int>(numEnvelopes)));
+	editedSettings.envelopeAttacks[envelopeIndex] = jmax(minEnvelopeTime, attackSeconds);
+	editedSettings.envelopeReleases[envelopeIndex] = jmax(minEnvelopeTime, releaseSeconds);
+	publish();
+}
+
+void ModulationMatrix::setTargetAllowed(int targetIndex, bool canBeModulated)
+{
+	jassert(isPositiveAndBelow(targetIndex, numTargets));
+	allowedTargets[targetIndex] = canBeModulated;
+
+	if (canBeModulated)
+		return;
+
+	for (int i = 0; i < maxRoutes; ++i)
+		if (editedSettings.routes[i].target == targetIndex)
+			editedSettings.routes[i].target = -1;
+
+	publish();
+}
+
+void ModulationMatrix::setRoute(int routeIndex, Source source, int targetIndex, float depth)
+{
+	jassert(isPositiveAndBelow(routeIndex, static_cast<int>(maxRoutes)) && isPositiveAndBelow(targetIndex, numTargets));
+
+	if (!isTargetAllowed(targetIndex))
+	{
+		jassertfalse;	// Offer only allowed targets
+		clearRoute(routeIndex);
+		return;
+	}
+
+	Route& route = editedSettings.routes[routeIndex];
+	route.source = jlimit(0, numSources - 1, static_cast<int>(source));
+	route.target = targetIndex;
+	route.depth = getClamped(depth, -1.0f, 1.0f);
+	publish();
+}
+
+void ModulationMatrix::clearRoute(int routeIndex)
+{
+	jassert(isPositiveAndBelow(routeIndex, static_cast<int>(maxRoutes)));
+	editedSettings.routes[routeIndex].target = -1;
+	publish();
+}
+
+void ModulationMatrix::publish()
+{
+	int numActive = 0;
+
+	for (int i = 0; i < maxRoutes; ++i)
+	{
+		const Route& route = editedSettings.routes[i];
+
+		if (isPositiveAndBelow(route.target, numTargets) && route.depth != 0.0f)
+			++numActive;
+	}
+
+	editedSettings.numActiveRoutes = numActive;
+	publishedSettings.publish(editedSettings);
+}
+
+void ModulationMatrix::writeState(MemoryBlock& destData, const uint32* parameterIds, int numParameters) const
+{
+	MemoryOutputStream output(destData, false);
+	output.writeShort(static_cast<short>(numLfos));
+	output.writeShort(static_cast<short>(numEnvelopes));
+
+	for (int i = 0; i < numLfos; ++i)
+	{
+		output.writeFloat(editedSettings.lfoRates[i]);
+		output.writeShort(static_cast<short>(editedSettings.lfoShapes[i]));
+	}
+
+	for (int i = 0; i < numEnvelopes; ++i)
+	{
+		output.writeFloat(editedSettings.envelopeAttacks[i]);
+		output.writeFloat(editedSettings.envelopeReleases[i]);
+	}
+
+	for (int i = 0; i < maxRoutes; ++i)
+	{
+		const Route& route = editedSettings.routes[i];
+
+		if (isPositiveAndBelow(route.target, numParameters))
+		{
+			output.writeInt(static_cast<int>(parameterIds[route.target]));
+			output.writeShort(static_cast<short>(i));
+			output.writeShort(static_cast<short>(route.source));
+			output.writeFloat(route.depth);
+		}
+	}
+}
+
+void ModulationMatrix::restoreState(const void* data, size_t size, const uint32* parameterIds, int numParameters)
+{
+	for (int i = 0; i < maxRoutes; ++i)
+		editedSettings.routes[i].target = -1;
+
+	MemoryInputStream input(data, size, false);
+	const int numStoredLfos = (input.getNumBytesRemaining() >= 4) ? input.readShort() : 0;
+	const int numStoredEnvelopes = (input.getNumBytesRemaining() >= 2) ? input.readShort() : 0;
+
+	// Sources this version doesn't have are read past, missing ones keep their settings
+	for (int i = 0; i < numStoredLfos && input.getNumBytesRemaining() >= 6; ++i)
+	{
+		const float rate = input.readFloat();
+		const int shape = input.readShort();
+
+		if (i < numLfos)
+		{
+			editedSettings.lfoRates[i] = getClamped(rate, 0.0f, maxLfoRate);
+			editedSettings.lfoShapes[i] = jlimit(0, numShapes - 1, shape);
+		}
+	}
+
+	for (int i = 0; i < numStoredEnvelopes && input.getNumBytesRemaining() >= 8; ++i)
+	{
+		const float attack = input.readFloat();
+		const float release = input.readFloat();
+
+		if (i < numEnvelopes)
+		{
+			editedSettings.envelopeAttacks[i] = jmax(minEnvelopeTime, attack);
+			editedSettings.envelopeReleases[i] = jmax(minEnvelopeTime, release);
+		}
+	}
+
+	while (input.getNumBytesRemaining() >= 12)
+	{
+		const uint32 id = static_cast<uint32>(input.readInt());
+		const int routeIndex = input.readShort();
+		const int source = input.readShort();
+		const float depth = input.readFloat();
+
+		if (!isPositiveAndBelow(routeIndex, static_cast<int>(maxRoutes)))
+			continue;
+
+		// Routes onto parameters this version doesn't have, or no longer modulates, are dropped
+		for (int parameter = 0; parameter < jmin(numParameters, numTargets); ++parameter)
+		{
+			if (parameterIds[parameter] == id)
+			{
+				if (!allowedTargets[parameter])
+					break;
+
+				Route& route = editedSettings.routes[routeIndex];
+				route.source = jlimit(0, numSources - 1, source);
+				route.target = parameter;
+				route.depth = getClamped(depth, -1.0f, 1.0f);
+				break;
+			}
+		}
+	}
+
+	publish();
+}
+
+//==============================================================================
+void ModulationMatrix::advance(const float* left, const float* right, int numSamples) noexcept
+{
+	const Settings& settings = publishedSettings.read();
+
+	evaluateLfos(settings);
+	evaluateEnvelopes(settings, left, right, numSamples);
+
+	FloatVectorOperations::clear(offsets, numTargets);
+
+	for (int i = 0; i < maxRoutes; ++i)
+	{
+		const Route& route = settings.routes[i];
+
+		if (isPositiveAndBelow(route.target, numTargets))
+			offsets[route.target] += route.depth * sourceValues[route.source];
+	}
+}
+
+void ModulationMatrix::evaluateLfos(const Settings& settings) noexcept
+{
+	int tableOffsets[numLfos];
+
+	for (int i = 0; i < numLfos; ++i)
+		tableOffsets[i] = settings.lfoShapes[i] * (tableSize + 1);
+
+#if ZEN_USE_SSE_INTRINSICS
+	// Phase advance, wrap and table position for all four LFOs at once
+	__m128 phase = _mm_loadu_ps(lfoPhases);
+	phase = _mm_add_ps(phase, _mm_mul_ps(_mm_loadu_ps(settings.lfoRates), _mm_set1_ps(tickSeconds)));
+	phase = _mm_sub_ps(phase, _mm_cvtepi32_ps(_mm_cvttps_epi32(phase)));	// Phases are never negative
+	_mm_storeu_ps(lfoPhases, phase);
+
+	const __m128 position = _mm_mul_ps(phase, _mm_set1_ps(static_cast<float>(tableSize)));
+	const __m128i index = _mm_cvttps_epi32(position);	// Phase is below 1, so index stops at tableSize - 1
+	const __m128 fraction = _mm_sub_ps(position, _mm_cvtepi32_ps(index));
+
+	int indices[numLfos];
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(indices), _mm_add_epi32(index, _mm_loadu_si128(reinterpret_cast<const __m128i*>(tableOffsets))));
+
+	const float* const table = wavetables;
+	const __m128 below = _mm_setr_ps(table[indices[0]], table[indices[1]], table[indices[2]], table[indices[3]]);
+	const __m128 above = _mm_setr_ps(table[indices[0] + 1], table[indices[1] + 1], table[indices[2] + 1], table[indices[3] + 1]);
+
+	_mm_storeu_ps(sourceValues + lfo1, _mm_add_ps(below, _mm_mul_ps(fraction, _mm_sub_ps(above, below))));
+#else
+	for (int i = 0; i < numLfos; ++i)
+	{
+		float phase = lfoPhases[i] + settings.lfoRates[i] * tickSeconds;
+		phase -= std::floor(phase);
+		lfoPhases[i] = phase;
+
+		const float position = phase * tableSize;
+		const int index = jmin(static_cast<int>(position), static_cast<int>(tableSize) - 1);
+		const float fraction = position - index;
+		const float* const table = wavetables + tableOffsets[i] + index;
+
+		sourceValues[lfo1 + i] = table[0] + fraction * (table[1] - table[0]);
+	}
+#endif
+}
+
+void ModulationMatrix::evaluateEnvelopes(const Settings& settings, const float* left, const float* right, int numSamples) noexcept
+{
+	float peak = 0.0f;
+
+	if (numSamples > 0)
+	{
+		const Range<float> leftRange(FloatVectorOperations::findMinAndMax(left, numSamples));
+		const Range<float> rightRange(FloatVectorOperations::findMinAndMax(right, numSamples));
+		peak = jmax(-leftRange.getStart(), leftRange.getEnd(), jmax(-rightRange.getStart(), rightRange.getEnd()));
+	}
+
+	peak = jmin(peak, 1.0f);
+
+	for (int i = 0; i < numEnvelopes; ++i)
+	{
+		// One pole per tick: the coefficient is how far the level would get in tickSeconds
+		const float time = (peak > envelopeLevels[i]) ? settings.envelopeAttacks[i] : settings.envelopeReleases[i];
+		const float coefficient = 1.0f - std::exp(-tickSeconds / time);
+
+		envelopeLevels[i] += coefficient * (peak - envelopeLevels[i]);
+		sourceValues[envelope1 + i] = envelopeLevels[i];
+	}
+}
+
+} // namespace Zen
@@ -0,0 +1,167 @@
+/*==============================================================================
+//  ModulationMatrix.h
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Control-rate LFOs and envelope followers routed onto parameters
+//  through a lock-free routing table
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#ifndef ZEN_MODULATION_MATRIX_H_INCLUDED
+#define ZEN_MODULATION_MATRIX_H_INCLUDED
+
+#include "JuceHeader.h"
+#include "../utilities/TripleBuffer.hpp"
+
+namespace Zen
+{
+
+/// <summary> Four wavetable LFOs and two envelope followers of the input, evaluated once every controlInterval
+/// samples, summed through up to maxRoutes routes into one normalized offset per target parameter.
+///
+/// The four LFOs are the four lanes of one SSE register: phases advance, wrap and turn into table positions
+/// together, and only the table reads themselves are scalar.  LFOs are bipolar (-1 to 1), envelope followers
+/// unipolar (0 to 1); a route scales its source by depth, in normalized parameter units.
+///
+/// The routing and source settings are edited on the message thread and published whole through a TripleBuffer,
+/// so the audio thread picks up a complete new table at its next control tick without locking. </summary>
+class ModulationMatrix
+{
+public:
+	enum Source
+	{
+		lfo1 = 0,
+		lfo2,
+		lfo3,
+		lfo4,
+		envelope1,
+		envelope2,
+		numSources
+	};
+
+	enum Shape
+	{
+		sineShape = 0,
+		triangleShape,
+		sawShape,
+		squareShape,
+		numShapes
+	};
+
+	enum
+	{
+		numLfos = 4,
+		numEnvelopes = 2,
+		maxRoutes = 16,
+		controlInterval = 32,	///< Samples between evaluations
+		tableSize = 256			///< Wavetable steps per cycle, each shape holds tableSize + 1 entries
+	};
+
+	/// <summary> numTargets is the number of parameters routes can target, indexed the same way </summary>
+	explicit ModulationMatrix(int numTargets);
+	~ModulationMatrix();
+
+	/// <summary> Sets the sample rate the control tick is timed against and restarts every source </summary>
+	void prepare(double inSampleRate);
+
+	/// <summary> Restarts the LFOs at phase zero and the envelope followers at rest </summary>
+	void reset() noexcept;
+
+	//==============================================================================
+	// Message thread only, each call publishes the whole table
+
+	void setLfo(int lfoIndex, float rateHz, Shape shape);
+	void setEnvelope(int envelopeIndex, float attackSeconds, float releaseSeconds);
+
+	/// <summary> Allows or refuses routes onto targetIndex.  Every target starts out allowed; disallowing one clears
+	/// any route already on it.  Meant for stepped parameters, which would jump between steps at control rate. </summary>
+	void setTargetAllowed(int targetIndex, bool canBeModulated);
+	bool isTargetAllowed(int targetIndex) const noexcept { return isPositiveAndBelow(targetIndex, numTargets) && allowedTargets[targetIndex]; }
+
+	/// <summary> Routes source onto target with depth, replacing whatever was in routeIndex.  A target that isn't
+	/// allowed clears the route instead. </summary>
+	void setRoute(int routeIndex, Source source, int targetIndex, float depth);
+	void clearRoute(int routeIndex);
+
+	float getLfoRate(int lfoIndex) const noexcept { return editedSettings.lfoRates[lfoIndex]; }
+	Shape getLfoShape(int lfoIndex) const noexcept { return static_cast<Shape>(editedSettings.lfoShapes[lfoIndex]); }
+	float getEnvelopeAttack(int envelopeIndex) const noexcept { return editedSettings.envelopeAttacks[envelopeIndex]; }
+	float getEnvelopeRelease(int envelopeIndex) const noexcept { return editedSettings.envelopeReleases[envelopeIndex]; }
+
+	/// <summary> Target of routeIndex, or -1 when the route is unused </summary>
+	int getRouteTarget(int routeIndex) const noexcept { return editedSettings.routes[routeIndex].target; }
+	Source getRouteSource(int routeIndex) const noexcept { return static_cast<Source>(editedSettings.routes[routeIndex].source); }
+	float getRouteDepth(int routeIndex) const noexcept { return editedSettings.routes[routeIndex].depth; }
+
+	/// <summary> Saved state form, little endian: uint16 numLfos, uint16 numEnvelopes, then { float rate, uint16 shape }
+	/// per LFO, { float attack, float release } per envelope, and one { uint32 parameter ID, uint16 route,
+	/// uint16 source, float depth } record per used route.  Targets are stored by ID, like MidiControllerMap's. </summary>
+	void writeState(MemoryBlock& destData, const uint32* parameterIds, int numParameters) const;
+	/// <summary> Routes onto targets that aren't allowed are dropped </summary>
+	void restoreState(const void* data, size_t size, const uint32* parameterIds, int numParameters);
+
+	//==============================================================================
+	/// <summary> False while no route has a target and a non-zero depth, when there is nothing to evaluate and
+	/// every offset is zero.  Audio thread only, picks up the latest published table like advance(). </summary>
+	bool hasActiveRoutes() noexcept { return publishedSettings.read().numActiveRoutes > 0; }
+
+	//==============================================================================
+	/// <summary> Runs one control tick, which moves every source on by controlInterval samples.  left and right are the
+	/// input the tick covers, numSamples of it (fewer than controlInterval where a block ends mid tick), for the envelope
+	/// followers; they may be the same channel.  Audio thread only. </summary>
+	void advance(const float* left, const float* right, int numSamples) noexcept;
+
+	/// <summary> Summed offset per target from the last advance(), numTargets values </summary>
+	const float* getOffsets() const noexcept { return offsets; }
+
+	/// <summary> Each source's value from the last advance() </summary>
+	float getSourceValue(Source source) const noexcept { return sourceValues[source]; }
+
+private:
+	struct Route
+	{
+		int source;
+		int target;	///< -1 when the route is unused
+		float depth;
+	};
+
+	/// <summary> Everything the message thread can change, published to the audio thread as one unit </summary>
+	struct Settings
+	{
+		float lfoRates[numLfos];
+		int lfoShapes[numLfos];
+		float envelopeAttacks[numEnvelopes], envelopeReleases[numEnvelopes];
+		Route routes[maxRoutes];
+		int numActiveRoutes;
+	};
+
+	/// <summary> Counts the active routes and publishes editedSettings </summary>
+	void publish();
+	void buildWavetables();
+	void evaluateLfos(const Settings& settings) noexcept;
+	void evaluateEnvelopes(const Settings& settings, const float* left, const float* right, int numSamples) noexcept;
+
+	const int numTargets;
+	HeapBlock<float> wavetables;	///< numShapes tables of tableSize + 1 entries
+	HeapBlock<float> offsets;
+	HeapBlock<bool> allowedTargets;	///< Message thread only, routes are checked against it as they are set
+
+	Settings editedSettings;		///< Message thread's copy
+	TripleBuffer<Settings> publishedSettings;
+
+	float lfoPhases[numLfos];
+	float envelopeLevels[numEnvelopes];
+	float sourceValues[numSources];
+	float tickSeconds = controlInterval / 44100.0f;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ModulationMatrix);
+};
+
+} // namespace Zen
+#endif // ZEN_MODULATION_MATRIX_H_INCLUDED
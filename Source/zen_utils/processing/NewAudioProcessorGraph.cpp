@@ -22,8 +22,11 @@ available: visit www.juce.com for more information.
 ==============================================================================
 */
 #include "NewAudioProcessorGraph.h"
+#include "../utilities/WorkStealingDeque.hpp"
+#include "../utilities/ZenSIMD.hpp"
 
 const int NewAudioProcessorGraph::midiChannelIndex = 0x1000;
+static const uint32 firstFeedbackNodeId = 0xff000000;
 
 //==============================================================================
 namespace GraphRenderingOps
@@ -274,7 +277,8 @@ class MapNode
 public:
 
 	MapNode(const int nodeId, NewAudioProcessorGraph::Node* node) noexcept :
-		feedbackLoopCheck(0), nodeId(nodeId), node(node), renderIndex(0), maxInputLatency(0), maxLatency(0)
+		uniqueStamp(0), unsortedSourceCount(0), loopIndex(-1), loopLowLink(0), isOnLoopStack(false), isInLoop(false),
+		nodeId(nodeId), node(node), renderIndex(0), level(0), maxInputLatency(0), maxLatency(0)
 	{
 	}
 
@@ -298,6 +302,19 @@ public:
 		renderIndex = theRenderIndex;
 	}
 
+	/** Longest chain of sources above this node, 0 for a node without inputs, though output nodes get levels of
+	their own when grouping by level.  Nodes on the same level never depend on one another, so they can be
+	rendered at the same time. */
+	int getLevel() const noexcept
+	{
+		return level;
+	}
+
+	void setLevel(int theLevel)
+	{
+		level = theLevel;
+	}
+
 	int getMaxInputLatency() const noexcept
 	{
 		return maxInputLatency;
@@ -328,19 +345,49 @@ public:
 		destConnections.add(new MapNodeConnection(srcMapNode, destMapNode, sourceChannelIndex, destChannelIndex));
 	}
 
-	Array<MapNodeConnection*> getSourcesToChannel(uint32 channel) const
+	/** The connections into one input channel: a view of a range of GraphMap's channel index, so nothing is
+	copied or allocated to get it. */
+	struct ChannelSources
 	{
-		Array<MapNodeConnection*> sourcesToChannel;
+		int size() const noexcept { return numSources; }
+		MapNodeConnection* getUnchecked(int index) const noexcept { return sources[index]; }
 
-		for (int i = 0; i < sourceConnections.size(); ++i)
-		{
-			MapNodeConnection* ec = sourceConnections.getUnchecked(i);
+		MapNodeConnection* const* sources;
+		int numSources;
+	};
+
+	/** Input channels from 0 to getNumInputSlots() - 2, then the midi input */
+	int getNumInputSlots() const noexcept
+	{
+		return node->getProcessor()->getNumInputChannels() + 1;
+	}
+
+	int getInputSlot(uint32 channel) const noexcept
+	{
+		return channel == (uint32)NewAudioProcessorGraph::midiChannelIndex ? getNumInputSlots() - 1 : (int)channel;
+	}
+
+	ChannelSources getSourcesToChannel(uint32 channel) const noexcept
+	{
+		const int slot = getInputSlot(channel);
+		ChannelSources result = { nullptr, 0 };
 
-			if (ec->destChannelIndex == channel)
-				sourcesToChannel.add(ec);
+		if (isPositiveAndBelow(slot, numInputSlots))
+		{
+			result.sources = channelSources + slotStarts[slot];
+			result.numSources = slotStarts[slot + 1] - slotStarts[slot];
 		}
 
-		return sourcesToChannel;
+		return result;
+	}
+
+	/** Points the node at its part of GraphMap's channel index: slotStarts[i] to slotStarts[i + 1] index the
+	sources of input slot i in channelSources. */
+	void setChannelIndex(MapNodeConnection* const* channelSources_, const int* slotStarts_, int numInputSlots_) noexcept
+	{
+		channelSources = channelSources_;
+		slotStarts = slotStarts_;
+		numInputSlots = numInputSlots_;
 	}
 
 	const OwnedArray<MapNodeConnection>& getSourceConnections() const noexcept
@@ -359,37 +406,54 @@ public:
 		maxLatency = maxInputLatency + node->getProcessor()->getLatencySamples();
 	}
 
-	void cacheUniqueNodeConnections()
+	/** stamp must be different for every call to every node, and is advanced past the ones used here */
+	void cacheUniqueNodeConnections(int& stamp)
 	{
 		//This should only ever be called once but in case things change
 		uniqueSources.clear();
 		uniqueDestinations.clear();
 
+		// A node is new to the list if it hasn't been stamped with this pass's stamp yet
+		++stamp;
+
 		for (int i = 0; i < sourceConnections.size(); ++i)
 		{
-			const MapNodeConnection* ec = sourceConnections.getUnchecked(i);
+			MapNode* const sourceNode = sourceConnections.getUnchecked(i)->sourceMapNode;
 
-			if (!uniqueSources.contains(ec->sourceMapNode))
-				uniqueSources.add(ec->sourceMapNode);
+			if (sourceNode->uniqueStamp != stamp)
+			{
+				sourceNode->uniqueStamp = stamp;
+				uniqueSources.add(sourceNode);
+			}
 		}
 
+		++stamp;
+
 		for (int i = 0; i < destConnections.size(); ++i)
 		{
-			const MapNodeConnection* ec = destConnections.getUnchecked(i);
+			MapNode* const destNode = destConnections.getUnchecked(i)->destMapNode;
 
-			if (!uniqueDestinations.contains(ec->destMapNode))
-				uniqueDestinations.add(ec->destMapNode);
+			if (destNode->uniqueStamp != stamp)
+			{
+				destNode->uniqueStamp = stamp;
+				uniqueDestinations.add(destNode);
+			}
 		}
 
 	}
 
-	uint32 feedbackLoopCheck;
+	// Working state for GraphMap's sort and loop search
+	int uniqueStamp;
+	int unsortedSourceCount;
+	int loopIndex, loopLowLink;
+	bool isOnLoopStack, isInLoop;
 
 private:
 
 	const int nodeId;
 	NewAudioProcessorGraph::Node* node;
 	uint32 renderIndex;
+	int level;
 	int maxInputLatency;
 	int maxLatency;
 
@@ -398,6 +462,10 @@ private:
 	Array<MapNode*> uniqueSources;
 	Array<MapNode*> uniqueDestinations;
 
+	MapNodeConnection* const* channelSources = nullptr;
+	const int* slotStarts = nullptr;
+	int numInputSlots = 0;
+
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MapNode);
 
 };
@@ -411,21 +479,28 @@ public:
 
 	GraphMap() {};
 
-	void buildMap(const OwnedArray<NewAudioProcessorGraph::Connection>& connections, const ReferenceCountedArray<NewAudioProcessorGraph::Node>& nodes)
+	/** groupByLevel orders the sorted nodes level by level, which the parallel renderer needs, rather than in the
+	order the sort happened to reach them. With nodesAreInRenderOrder every connection already runs forwards
+	through nodes, so their order is taken as it is instead of sorting. */
+	void buildMap(const OwnedArray<NewAudioProcessorGraph::Connection>& connections, const ReferenceCountedArray<NewAudioProcessorGraph::Node>& nodes,
+		bool groupByLevel, bool nodesAreInRenderOrder)
 	{
 		mapNodes.ensureStorageAllocated(nodes.size());
+		mapNodesById.remapTable(nodes.size() * 2 + 1);
+
+		Array<MapNode*> nodesInGivenOrder;
+		nodesInGivenOrder.ensureStorageAllocated(nodes.size());
 
 		//Create MapNode for every node.
 		for (int i = 0; i < nodes.size(); ++i)
 		{
 			NewAudioProcessorGraph::Node* node = nodes.getUnchecked(i);
 
-			//#smell - just want to get the insert index, we don't care about the returned node.
-			int index;
-			MapNode* foundMapNode = findMapNode(node->nodeId, index);
-			jassert(foundMapNode == nullptr);  //cannot have duplicate nodeIds.
+			jassert(findMapNode(node->nodeId) == nullptr);  //cannot have duplicate nodeIds.
 
-			mapNodes.insert(index, new MapNode(node->nodeId, node));
+			MapNode* const mapNode = mapNodes.add(new MapNode(node->nodeId, node));
+			mapNodesById.set((int)node->nodeId, mapNode);
+			nodesInGivenOrder.add(mapNode);
 
 		}
 
@@ -434,14 +509,12 @@ public:
 		{
 			const NewAudioProcessorGraph::Connection* c = connections.getUnchecked(i);
 
-			//#smell - We don't care about index here but we do care about the returned node.
-			int index;
-			MapNode* srcMapNode = findMapNode(c->sourceNodeId, index);
-			MapNode* destMapNode = findMapNode(c->destNodeId, index);
+			MapNode* srcMapNode = findMapNode(c->sourceNodeId);
+			MapNode* destMapNode = findMapNode(c->destNodeId);
 
-			jassert(srcMapNode != nullptr);
+			jassert(srcMapNode != nullptr && destMapNode != nullptr);
 
-			if (srcMapNode != nullptr)
+			if (srcMapNode != nullptr && destMapNode != nullptr)
 			{
 				srcMapNode->addOutputConnection(srcMapNode, destMapNode, c->sourceChannelIndex, c->destChannelIndex);
 				destMapNode->addInputConnection(srcMapNode, destMapNode, c->sourceChannelIndex, c->destChannelIndex);
@@ -451,34 +524,35 @@ public:
 
 		//MapNodes have all their connections now, but for sorting we only care about connections to distinct nodes so
 		//cache lists of the distinct source and destination nodes.
-		for (int i = 0; i < mapNodes.size(); ++i)
-			mapNodes.getUnchecked(i)->cacheUniqueNodeConnections();
+		int uniqueStamp = 0;
 
-
-		//Grab all the nodes that have no input connections (they are used as the starting points for the sort routine)
-		Array<MapNode*> nodesToSort;
 		for (int i = 0; i < mapNodes.size(); ++i)
-		{
-			MapNode* mapNode = mapNodes.getUnchecked(i);
+			mapNodes.getUnchecked(i)->cacheUniqueNodeConnections(uniqueStamp);
+
+		buildChannelIndex();
 
-			if (mapNode->getUniqueSources().size() == 0)
-				nodesToSort.add(mapNode);
-		}
 
 		sortedMapNodes.ensureStorageAllocated(mapNodes.size());
 
-		//Sort the nodes
-		while (true)
+		if (nodesAreInRenderOrder)
+		{
+			for (int i = 0; i < nodesInGivenOrder.size(); ++i)
+				addSortedNode(nodesInGivenOrder.getUnchecked(i), sortedMapNodes);
+		} else
 		{
-			Array<MapNode*> nextNodes;
-			this->sortNodes(nodesToSort, sortedMapNodes, nextNodes);
+			sortNodes(nodesInGivenOrder);
+		}
 
-			if (nextNodes.size() == 0)
-				break;
+		if (groupByLevel)
+		{
+			separateOutputNodes();
 
-			nodesToSort.clear();
-			nodesToSort.addArray(nextNodes);
+			// Any order that keeps levels ascending is still a valid topological order
+			MapNodeLevelSorter sorter;
+			sortedMapNodes.sort(sorter, true);
 
+			for (int i = 0; i < sortedMapNodes.size(); ++i)
+				sortedMapNodes.getUnchecked(i)->setRenderIndex(i + 1);
 		}
 
 	}
@@ -488,122 +562,264 @@ public:
 		return sortedMapNodes;
 	}
 
+	/** IDs of the nodes found on loops of connections, which can only be rendered with some of their inputs silent */
+	const Array<uint32>& getNodesInLoops() const noexcept
+	{
+		return nodesInLoops;
+	}
+
 private:
 
-	MapNode* findMapNode(const int destNodeId, int& insertIndex) const noexcept
+	/** Every audio or midi output node writes the graph's one output buffer, so no two may render at the same
+	time. Output nodes feed nothing, so each can move down to a level of its own below all the others. */
+	void separateOutputNodes()
 	{
+		int lastLevel = 0;
 
-		int start = 0;
-		int end = mapNodes.size();
+		for (int i = 0; i < sortedMapNodes.size(); ++i)
+			lastLevel = jmax(lastLevel, sortedMapNodes.getUnchecked(i)->getLevel());
 
-		for (;;)
+		for (int i = 0; i < sortedMapNodes.size(); ++i)
 		{
-			if (start >= end)
-			{
-				break;
-			} else if (destNodeId == mapNodes.getUnchecked(start)->getNodeId())
-			{
-				insertIndex = start;
-				return mapNodes.getUnchecked(start);
-				break;
-			} else
-			{
-				const int halfway = (start + end) / 2;
+			MapNode* const mapNode = sortedMapNodes.getUnchecked(i);
 
-				if (halfway == start)
+			if (NewAudioProcessorGraph::AudioGraphIOProcessor* const ioProc
+				= dynamic_cast <NewAudioProcessorGraph::AudioGraphIOProcessor*> (mapNode->getNode()->getProcessor()))
+			{
+				if (ioProc->isOutput())
 				{
-					if (destNodeId >= mapNodes.getUnchecked(halfway)->getNodeId())
-						++start;
+					jassert(mapNode->getUniqueDestinations().size() == 0);
+					mapNode->setLevel(++lastLevel);
+				}
+			}
+		}
+	}
 
-					break;
-				} else if (destNodeId >= mapNodes.getUnchecked(halfway)->getNodeId())
-					start = halfway;
-				else
-					end = halfway;
+	struct MapNodeLevelSorter
+	{
+		static int compareElements(const MapNode* first, const MapNode* second) noexcept
+		{
+			return first->getLevel() - second->getLevel();
+		}
+	};
+
+	MapNode* findMapNode(const uint32 nodeId) const noexcept
+	{
+		return mapNodesById[(int)nodeId];
+	}
+
+	/** Compressed sparse rows of every node's input connections by input slot, so the calculator can ask for a
+	channel's sources without scanning or allocating. A counting sort: one pass sizes every slot's range, a
+	prefix sum places them, and a second pass fills them in. Connections to channels a processor doesn't have
+	are left out, as nothing renders them. */
+	void buildChannelIndex()
+	{
+		int numSlots = 0;
+
+		for (int i = 0; i < mapNodes.size(); ++i)
+			numSlots += mapNodes.getUnchecked(i)->getNumInputSlots();
+
+		slotStarts.insertMultiple(0, 0, numSlots + 1);
+		int* const starts = slotStarts.getRawDataPointer();
+		int firstSlot = 0;
+
+		for (int i = 0; i < mapNodes.size(); ++i)
+		{
+			const MapNode* const mapNode = mapNodes.getUnchecked(i);
+			const OwnedArray<MapNodeConnection>& sources = mapNode->getSourceConnections();
+			const int numInputSlots = mapNode->getNumInputSlots();
+
+			for (int j = 0; j < sources.size(); ++j)
+			{
+				const int slot = mapNode->getInputSlot(sources.getUnchecked(j)->destChannelIndex);
+
+				if (isPositiveAndBelow(slot, numInputSlots))
+					++starts[firstSlot + slot + 1];
 			}
+
+			firstSlot += numInputSlots;
 		}
 
-		insertIndex = start;
+		for (int i = 0; i < numSlots; ++i)
+			starts[i + 1] += starts[i];
 
-		return nullptr;
+		channelSources.insertMultiple(0, nullptr, starts[numSlots]);
+		Array<int> fillPositions(starts, numSlots);
+		firstSlot = 0;
+
+		for (int i = 0; i < mapNodes.size(); ++i)
+		{
+			MapNode* const mapNode = mapNodes.getUnchecked(i);
+			const OwnedArray<MapNodeConnection>& sources = mapNode->getSourceConnections();
+			const int numInputSlots = mapNode->getNumInputSlots();
+
+			for (int j = 0; j < sources.size(); ++j)
+			{
+				const int slot = mapNode->getInputSlot(sources.getUnchecked(j)->destChannelIndex);
 
+				if (isPositiveAndBelow(slot, numInputSlots))
+					channelSources.set(fillPositions.getReference(firstSlot + slot)++, sources.getUnchecked(j));
+			}
+
+			mapNode->setChannelIndex(channelSources.getRawDataPointer(), starts + firstSlot, numInputSlots);
+			firstSlot += numInputSlots;
+		}
 	}
 
-	/*
-	* Iterates the given startNodes and if a node's sources have all been sorted then the node is inserted into the sort list.  If the node is still waiting
-	* for a source to be sorted it is added to the nextNodes list for the next call.  If a node is sorted then it's destination nodes are added to the nextNodes list.
-	*/
-	void sortNodes(Array<MapNode*>& startNodes, Array<MapNode*>& sortedNodes, Array<MapNode*>& nextNodes) const
+	/** Kahn's algorithm: a node is sorted once all its sources are, starting from the nodes without any, in the
+	order given. If it runs out of such nodes the rest are on or after a loop: the loops are found exactly and
+	reported, and each time the sort gets stuck the earliest unsorted node on a loop is let through. Its inputs
+	from nodes that aren't sorted yet read silence. Linear in the number of nodes and connections. */
+	void sortNodes(const Array<MapNode*>& nodesInGivenOrder)
 	{
+		Array<MapNode*> readyNodes;
+		readyNodes.ensureStorageAllocated(nodesInGivenOrder.size());
 
-		for (int i = 0; i < startNodes.size(); ++i)
+		for (int i = 0; i < nodesInGivenOrder.size(); ++i)
 		{
-			MapNode* node = startNodes.getUnchecked(i);
+			MapNode* const node = nodesInGivenOrder.getUnchecked(i);
+			node->unsortedSourceCount = node->getUniqueSources().size();
 
-			const Array<MapNode*>& uniqueSources = node->getUniqueSources();
+			if (node->unsortedSourceCount == 0)
+				readyNodes.add(node);
+		}
 
-			bool canBeSorted = true;
+		int nextReady = 0;
+		int nextLoopCandidate = 0;
 
-			if (uniqueSources.size() > 1)
+		while (sortedMapNodes.size() < nodesInGivenOrder.size())
+		{
+			if (nextReady == readyNodes.size())
 			{
-				for (int j = 0; j < uniqueSources.size(); ++j)
-				{
-					MapNode* sourceNode = uniqueSources.getUnchecked(j);
+				if (nodesInLoops.size() == 0)
+					findLoops(nodesInGivenOrder);
 
-					if (!isNodeSorted(sourceNode))
-					{
-						sourceNode->feedbackLoopCheck++;
+				while (isNodeSorted(nodesInGivenOrder.getUnchecked(nextLoopCandidate))
+					|| !nodesInGivenOrder.getUnchecked(nextLoopCandidate)->isInLoop)
+					++nextLoopCandidate;
 
-						//Less than fantastic way to deal with feedback loops but at least it eliminates an infinite loop.
-						//5000 attempts waiting for this sourceNode to be sorted probably means there's a feedback loop.  Let the node proceed if so.
-						canBeSorted = sourceNode->feedbackLoopCheck > 5000;
+				readyNodes.add(nodesInGivenOrder.getUnchecked(nextLoopCandidate));
+			}
 
-						jassert(sourceNode->feedbackLoopCheck <= 5000); //Feedback loop detected.  Feedback loops are not supported, will not work, and sometimes mess up the sorting.
+			MapNode* const node = readyNodes.getUnchecked(nextReady++);
 
-						if (!canBeSorted)
-							break;
+			if (isNodeSorted(node))
+				continue;
 
-					}
+			addSortedNode(node, sortedMapNodes);
 
-				}
+			const Array<MapNode*>& uniqueDestinations = node->getUniqueDestinations();
+
+			for (int j = 0; j < uniqueDestinations.size(); ++j)
+			{
+				MapNode* const destination = uniqueDestinations.getUnchecked(j);
 
+				if (--(destination->unsortedSourceCount) == 0 && !isNodeSorted(destination))
+					readyNodes.add(destination);
 			}
+		}
 
-			if (canBeSorted)
-			{
-				//Determine the latency information for this node.
-				int maxInputLatency = 0;
+		// Connections that close a loop need to be feedback connections, see NewAudioProcessorGraph::addFeedbackConnection()
+		jassert(nodesInLoops.size() == 0);
+	}
 
-				for (int j = 0; j < uniqueSources.size(); ++j)
-					maxInputLatency = jmax(maxInputLatency, uniqueSources.getUnchecked(j)->getMaxLatency());
+	/** Tarjan's strongly connected components over the unsorted nodes, marking and listing every node that's on a
+	loop. Iterative, so long chains can't overflow the stack. */
+	void findLoops(const Array<MapNode*>& nodesInGivenOrder)
+	{
+		Array<MapNode*> componentStack, searchPath;
+		Array<int> nextDestination;
+		int nextIndex = 0;
 
-				node->calculateLatenciesWithInputLatency(maxInputLatency);
+		for (int i = 0; i < nodesInGivenOrder.size(); ++i)
+		{
+			MapNode* const root = nodesInGivenOrder.getUnchecked(i);
 
-				//Add the node to the sorted list
-				sortedNodes.add(node);
-				node->setRenderIndex(sortedNodes.size());
+			if (isNodeSorted(root) || root->loopIndex >= 0)
+				continue;
 
-				//in some graph configurations the node we just sorted could already have been inserted in the next nodes list.
-				nextNodes.removeFirstMatchingValue(node);
+			root->loopIndex = root->loopLowLink = nextIndex++;
+			root->isOnLoopStack = true;
+			componentStack.add(root);
+			searchPath.add(root);
+			nextDestination.add(0);
 
-				//Add unsorted destination nodes to the next round of sorting.
+			while (searchPath.size() > 0)
+			{
+				MapNode* const node = searchPath.getLast();
+				int& destinationIndex = nextDestination.getReference(nextDestination.size() - 1);
 				const Array<MapNode*>& uniqueDestinations = node->getUniqueDestinations();
 
-				for (int j = 0; j < uniqueDestinations.size(); ++j)
+				if (destinationIndex < uniqueDestinations.size())
 				{
-					MapNode* nextNode = uniqueDestinations.getUnchecked(j);
+					MapNode* const destination = uniqueDestinations.getUnchecked(destinationIndex++);
+
+					if (isNodeSorted(destination))
+						continue;
+
+					if (destination->loopIndex < 0)
+					{
+						destination->loopIndex = destination->loopLowLink = nextIndex++;
+						destination->isOnLoopStack = true;
+						componentStack.add(destination);
+						searchPath.add(destination);
+						nextDestination.add(0);
+					} else if (destination->isOnLoopStack)
+					{
+						node->loopLowLink = jmin(node->loopLowLink, destination->loopIndex);
+					}
 
-					if (!nextNodes.contains(nextNode) && !isNodeSorted(nextNode))
-						nextNodes.add(nextNode);
+					continue;
 				}
 
-			} else
-			{
-				nextNodes.add(node);
+				searchPath.removeLast();
+				nextDestination.removeLast();
+
+				if (searchPath.size() > 0)
+					searchPath.getLast()->loopLowLink = jmin(searchPath.getLast()->loopLowLink, node->loopLowLink);
+
+				if (node->loopLowLink == node->loopIndex)
+				{
+					// node heads a component; it's a loop unless it's on its own
+					const bool isLoop = componentStack.getLast() != node;
+					MapNode* member;
+
+					do
+					{
+						member = componentStack.getLast();
+						componentStack.removeLast();
+						member->isOnLoopStack = false;
+						member->isInLoop = isLoop;
+
+						if (isLoop)
+							nodesInLoops.add(member->getNodeId());
+					} while (member != node);
+				}
 			}
+		}
+	}
+
+	/** Works out a node's latency and level from its sorted sources and appends it to the sorted list. */
+	void addSortedNode(MapNode* node, Array<MapNode*>& sortedNodes) const
+	{
+		const Array<MapNode*>& uniqueSources = node->getUniqueSources();
+		int maxInputLatency = 0;
+		int level = 0;
 
+		for (int j = 0; j < uniqueSources.size(); ++j)
+		{
+			const MapNode* sourceNode = uniqueSources.getUnchecked(j);
+			maxInputLatency = jmax(maxInputLatency, sourceNode->getMaxLatency());
+
+			if (isNodeSorted(sourceNode))
+				level = jmax(level, sourceNode->getLevel() + 1);
 		}
 
+		node->calculateLatenciesWithInputLatency(maxInputLatency);
+		node->setLevel(level);
+
+		sortedNodes.add(node);
+		node->setRenderIndex(sortedNodes.size());
 	}
 
 	bool isNodeSorted(const MapNode* mapNode) const
@@ -612,7 +828,11 @@ private:
 	}
 
 	OwnedArray<MapNode> mapNodes;
+	HashMap<int, MapNode*> mapNodesById;
 	Array<MapNode*> sortedMapNodes;
+	Array<uint32> nodesInLoops;
+	Array<MapNodeConnection*> channelSources;
+	Array<int> slotStarts;
 
 	JUCE_DECLARE_NON_COPYABLE(GraphMap);
 
@@ -627,31 +847,57 @@ class RenderingOpSequenceCalculator
 {
 public:
 	//==============================================================================
-	RenderingOpSequenceCalculator(NewAudioProcessorGraph& graph_,
-		const ReferenceCountedArray<NewAudioProcessorGraph::Node>& nodes_,
+	/** Each node's ops are one task: taskStarts gets the index of every task's first op, then renderingOps.size().
+	levelStarts gets the index of the first task of every level, then the number of tasks.
+
+	With forParallelRendering the tasks of a level may run at the same time, so buffers are only recycled between
+	levels, and a node never works in place on a buffer another node of its level also reads. The ops are still
+	correct run one after another.
+
+	nodesAreInRenderOrder says every connection already runs forwards through nodes_, see GraphMap::buildMap().
+	Feedback connections must already have been replaced by their delay nodes. */
+	RenderingOpSequenceCalculator(const ReferenceCountedArray<NewAudioProcessorGraph::Node>& nodes_,
 		const OwnedArray<NewAudioProcessorGraph::Connection>& connections_,
-		Array<void*>& renderingOps)
-		: graph(graph_),
+		Array<void*>& renderingOps,
+		const bool forParallelRendering,
+		Array<int>& taskStarts,
+		Array<int>& levelStarts,
+		const bool nodesAreInRenderOrder)
+		: parallel(forParallelRendering),
 		totalLatency(0)
 	{
 		audioChannelBuffers.add(new ChannelBufferInfo(0, (uint32)zeroNodeID, 0, 0));
 		midiChannelBuffers.add(new ChannelBufferInfo(0, (uint32)zeroNodeID, 0, 0));
 
 		GraphRenderingOps::GraphMap graphMap;
-		graphMap.buildMap(connections_, nodes_);
+		graphMap.buildMap(connections_, nodes_, parallel, nodesAreInRenderOrder);
+
+		const Array<MapNode*>& sortedMapNodes = graphMap.getSortedMapNodes();
 
-		for (int i = 0; i < graphMap.getSortedMapNodes().size(); ++i)
+		for (int i = 0; i < sortedMapNodes.size(); ++i)
 		{
-			const MapNode* mapNode = graphMap.getSortedMapNodes().getUnchecked(i);
+			const MapNode* mapNode = sortedMapNodes.getUnchecked(i);
+			const bool endsLevel = i == sortedMapNodes.size() - 1 || sortedMapNodes.getUnchecked(i + 1)->getLevel() != mapNode->getLevel();
+
+			if (i == 0 || sortedMapNodes.getUnchecked(i - 1)->getLevel() != mapNode->getLevel())
+				levelStarts.add(taskStarts.size());
+
+			taskStarts.add(renderingOps.size());
 			createRenderingOpsForNode(mapNode, renderingOps);
-			markAnyUnusedBuffersAsFree(mapNode);
+
+			if (endsLevel || !parallel)
+				markAnyUnusedBuffersAsFree(mapNode);
 		}
 
-		graph.setLatencySamples(totalLatency);
+		taskStarts.add(renderingOps.size());
+		levelStarts.add(taskStarts.size() - 1);
 
+		nodesInLoops = graphMap.getNodesInLoops();
 	}
 
 	int getNumBuffersNeeded() const { return audioChannelBuffers.size(); }
+	int getTotalLatency() const { return totalLatency; }
+	const Array<uint32>& getNodesInLoops() const noexcept { return nodesInLoops; }
 	int getNumMidiBuffersNeeded() const { return midiChannelBuffers.size(); }
 
 private:
@@ -681,15 +927,17 @@ private:
 	};
 
 	//==============================================================================
-	NewAudioProcessorGraph& graph;
 	OwnedArray<ChannelBufferInfo> audioChannelBuffers;
 	OwnedArray <ChannelBufferInfo> midiChannelBuffers;
 
-	enum { freeNodeID = 0xffffffff, zeroNodeID = 0xfffffffe };
+	// reservedNodeID holds a buffer handed out by getFreeBuffer() until the level ends, see getFreeBuffer()
+	enum { freeNodeID = 0xffffffff, zeroNodeID = 0xfffffffe, reservedNodeID = 0xfffffffd };
 
 	static bool isNodeBusy(uint32 nodeID) noexcept { return nodeID != freeNodeID && nodeID != zeroNodeID; }
 
+	const bool parallel;
 	int totalLatency;
+	Array<uint32> nodesInLoops;
 
 	//==============================================================================
 	void createRenderingOpsForNode(const MapNode* mapNode, Array<void*>& renderingOps)
@@ -706,7 +954,7 @@ private:
 		{
 			const ChannelBufferInfo* audioChannelBufferToUse = nullptr;
 
-			const Array<GraphRenderingOps::MapNodeConnection*> srcConnectionsToChannel = mapNode->getSourcesToChannel(inputChan);
+			const MapNode::ChannelSources srcConnectionsToChannel = mapNode->getSourcesToChannel(inputChan);
 
 			if (srcConnectionsToChannel.size() == 0)
 			{
@@ -865,7 +1113,7 @@ private:
 
 		const ChannelBufferInfo* midiBufferToUse = nullptr;
 
-		const Array<GraphRenderingOps::MapNodeConnection*> midiSourceConnections = mapNode->getSourcesToChannel(NewAudioProcessorGraph::midiChannelIndex);
+		const MapNode::ChannelSources midiSourceConnections = mapNode->getSourcesToChannel(NewAudioProcessorGraph::midiChannelIndex);
 
 		if (midiSourceConnections.size() == 0)
 		{
@@ -882,7 +1130,7 @@ private:
 			midiBufferToUse = getBufferContaining(mapNodeConnection->sourceMapNode->getNodeId(),
 				NewAudioProcessorGraph::midiChannelIndex);
 
-			if (midiBufferToUse >= 0)
+			if (midiBufferToUse != nullptr)
 			{
 				if (isBufferNeededLater(midiBufferToUse, mapNode, NewAudioProcessorGraph::midiChannelIndex))
 				{
@@ -924,7 +1172,7 @@ private:
 			{
 				// can't re-use any of our input buffers, so get a new one and copy everything into it..
 				midiBufferToUse = getFreeBuffer(true);
-				jassert(midiBufferToUse >= 0);
+				jassert(midiBufferToUse != nullptr);
 
 				const GraphRenderingOps::MapNodeConnection* midiConnection = midiSourceConnections.getUnchecked(0);
 
@@ -965,7 +1213,22 @@ private:
 	}
 
 	//==============================================================================
+	/** In parallel, a buffer used only as scratch, or as a MIDI buffer the node ignores, would look free to the
+	next node of the level while this one is still using it, so it stays reserved until the level is done. */
 	const ChannelBufferInfo* getFreeBuffer(const bool forMidi)
+	{
+		const ChannelBufferInfo* const freeBuffer = findFreeBuffer(forMidi);
+
+		if (!parallel)
+			return freeBuffer;
+
+		OwnedArray<ChannelBufferInfo>& buffers = forMidi ? midiChannelBuffers : audioChannelBuffers;
+		const uint32 index = freeBuffer->index;
+		buffers.set((int)index, new ChannelBufferInfo(index, (uint32)reservedNodeID, freeBuffer->channelIndex, 0));
+		return buffers.getUnchecked((int)index);
+	}
+
+	const ChannelBufferInfo* findFreeBuffer(const bool forMidi)
 	{
 		if (forMidi)
 		{
@@ -1036,6 +1299,13 @@ private:
 			{
 				const MapNodeConnection* ec = srcMapNode->getDestConnections().getUnchecked(i);
 
+				// In parallel, another reader on the same level may be reading it right now
+				if (parallel
+					&& ec->destMapNode != currentMapNode
+					&& ec->destMapNode->getLevel() == currentMapNode->getLevel()
+					&& ec->sourceChannelIndex == outputChanIndex)
+					return true;
+
 				if (ec->destMapNode->getNodeId() == currentMapNode->getNodeId())
 				{
 					if (outputChanIndex == NewAudioProcessorGraph::midiChannelIndex)
@@ -1133,151 +1403,592 @@ struct ConnectionSorter
 	}
 };
 
-}
-
-//==============================================================================
-NewAudioProcessorGraph::Connection::Connection(const uint32 sourceNodeId_, const int sourceChannelIndex_,
-	const uint32 destNodeId_, const int destChannelIndex_) noexcept
-	: sourceNodeId(sourceNodeId_), sourceChannelIndex(sourceChannelIndex_),
-	destNodeId(destNodeId_), destChannelIndex(destChannelIndex_)
-{
-}
 
 //==============================================================================
-NewAudioProcessorGraph::Node::Node(const uint32 nodeId_, AudioProcessor* const processor_) noexcept
-	: nodeId(nodeId_),
-	processor(processor_),
-	isPrepared(false)
-{
-	jassert(processor != nullptr);
-}
-
-void NewAudioProcessorGraph::Node::prepare(const double sampleRate, const int blockSize,
-	NewAudioProcessorGraph* const graph)
+/** One end of a feedback connection's one-block delay. The send end stores what the connection's source rendered
+this block, and the return end plays it to the destination in the next. Every return is rendered before any send,
+so a block never reads what it wrote itself. Both ends carry one audio channel and midi, of which a connection
+uses one, and own nothing but a share of their preallocated line.
+*/
+class FeedbackDelayProcessor : public AudioProcessor
 {
-	if (!isPrepared)
+public:
+	struct Line : public ReferenceCountedObject
 	{
-		isPrepared = true;
-		setParentGraph(graph);
+		explicit Line(const int blockSize)
+			: audio(1, blockSize)
+		{
+			audio.clear();
+			midi.ensureSize(2048);
+		}
 
-		processor->setPlayConfigDetails(processor->getNumInputChannels(),
-			processor->getNumOutputChannels(),
-			sampleRate, blockSize);
+		AudioSampleBuffer audio;
+		MidiBuffer midi;
 
-		processor->prepareToPlay(sampleRate, blockSize);
-	}
-}
+		typedef ReferenceCountedObjectPtr<Line> Ptr;
+	};
 
-void NewAudioProcessorGraph::Node::unprepare()
-{
-	if (isPrepared)
+	FeedbackDelayProcessor(Line* const line_, const bool isSend_)
+		: line(line_), isSend(isSend_)
 	{
-		isPrepared = false;
-		processor->releaseResources();
+		setPlayConfigDetails(1, 1, 44100.0, line->audio.getNumSamples());
 	}
-}
 
-void NewAudioProcessorGraph::Node::setParentGraph(NewAudioProcessorGraph* const graph) const
-{
-	if (NewAudioProcessorGraph::AudioGraphIOProcessor* const ioProc
-		= dynamic_cast <NewAudioProcessorGraph::AudioGraphIOProcessor*> (processor.get()))
-		ioProc->setParentGraph(graph);
-}
-
-//==============================================================================
-NewAudioProcessorGraph::NewAudioProcessorGraph()
-	: lastNodeId(0),
-	currentAudioInputBuffer(nullptr),
-	currentMidiInputBuffer(nullptr)
-{
-}
+	int getCapacity() const noexcept { return line->audio.getNumSamples(); }
 
-NewAudioProcessorGraph::~NewAudioProcessorGraph()
-{
-	clearRenderingSequence();
-	clear();
-}
+	void processBlock(AudioSampleBuffer& buffer, MidiBuffer& midiMessages) override
+	{
+		const int numSamples = jmin(buffer.getNumSamples(), getCapacity());
 
-const String NewAudioProcessorGraph::getName() const
-{
-	return "Audio Graph";
-}
+		if (isSend)
+		{
+			line->audio.copyFrom(0, 0, buffer, 0, 0, numSamples);
+			line->midi.clear();
+			line->midi.addEvents(midiMessages, 0, numSamples, 0);
+		} else
+		{
+			buffer.copyFrom(0, 0, line->audio, 0, 0, numSamples);
+			midiMessages.clear();
+			midiMessages.addEvents(line->midi, 0, numSamples, 0);
+		}
+	}
 
-//==============================================================================
-void NewAudioProcessorGraph::clear()
-{
-	nodes.clear();
-	connections.clear();
-	triggerAsyncUpdate();
-}
+	const String getName() const override { return isSend ? "Feedback Send" : "Feedback Return"; }
+	void prepareToPlay(double, int) override {}
+	void releaseResources() override {}
+	const String getInputChannelName(int) const override { return String(); }
+	const String getOutputChannelName(int) const override { return String(); }
+	bool isInputChannelStereoPair(int) const override { return false; }
+	bool isOutputChannelStereoPair(int) const override { return false; }
+	bool silenceInProducesSilenceOut() const override { return false; }
+	double getTailLengthSeconds() const override { return 0.0; }
+	bool acceptsMidi() const override { return true; }
+	bool producesMidi() const override { return true; }
+	AudioProcessorEditor* createEditor() override { return nullptr; }
+	bool hasEditor() const override { return false; }
+	int getNumPrograms() override { return 0; }
+	int getCurrentProgram() override { return 0; }
+	void setCurrentProgram(int) override {}
+	const String getProgramName(int) override { return String(); }
+	void changeProgramName(int, const String&) override {}
+	void getStateInformation(juce::MemoryBlock&) override {}
+	void setStateInformation(const void*, int) override {}
 
-NewAudioProcessorGraph::Node* NewAudioProcessorGraph::getNodeForId(const uint32 nodeId) const
-{
-	for (int i = nodes.size(); --i >= 0;)
-		if (nodes.getUnchecked(i)->nodeId == nodeId)
-			return nodes.getUnchecked(i);
+private:
+	const Line::Ptr line;
+	const bool isSend;
 
-	return nullptr;
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FeedbackDelayProcessor)
+};
 }
 
-NewAudioProcessorGraph::Node* NewAudioProcessorGraph::addNode(AudioProcessor* const newProcessor, uint32 nodeId)
+//==============================================================================
+/** Everything the audio thread needs to render the graph: the ops, their task and level boundaries, the buffers
+they work in, and references to the nodes and connections they were planned from, which keep removed processors
+alive for as long as the program can still be rendering them.
+
+The message thread fills in the nodes, connections and settings, build() makes the rest on the builder thread,
+and once published nothing in it changes except the contents of its buffers. It is deleted on the message thread
+after the audio thread has moved on to a later one.
+*/
+struct NewAudioProcessorGraph::RenderProgram
 {
-	if (newProcessor == nullptr || newProcessor == this)
+	RenderProgram(const int generation_, const bool isParallel_, const int blockSize_)
+		: generation(generation_), isParallel(isParallel_), blockSize(jmax(1, blockSize_))
 	{
-		jassertfalse;
-		return nullptr;
 	}
 
-	for (int i = nodes.size(); --i >= 0;)
+	~RenderProgram()
 	{
-		if (nodes.getUnchecked(i)->getProcessor() == newProcessor)
-		{
-			jassertfalse; // Cannot add the same object to the graph twice!
-			return nullptr;
-		}
+		for (int i = ops.size(); --i >= 0;)
+			delete static_cast<GraphRenderingOps::AudioGraphRenderingOp*> (ops.getUnchecked(i));
 	}
 
-	if (nodeId == 0)
+	void build()
 	{
-		nodeId = ++lastNodeId;
-	} else
-	{
-		// you can't add a node with an id that already exists in the graph..
-		jassert(getNodeForId(nodeId) == nullptr);
-		removeNode(nodeId);
-
-		if (nodeId > lastNodeId)
-			lastNodeId = nodeId;
-	}
-
-	newProcessor->setPlayHead(getPlayHead());
-
-	Node* const n = new Node(nodeId, newProcessor);
-	nodes.add(n);
-	triggerAsyncUpdate();
+		GraphRenderingOps::RenderingOpSequenceCalculator calculator(nodes, connections, ops, isParallel, taskStarts, levelStarts,
+			nodesAreInRenderOrder);
+		latencySamples = calculator.getTotalLatency();
+		nodesInLoops = calculator.getNodesInLoops();
 
-	n->setParentGraph(this);
-	return n;
-}
+		renderingBuffers.setSize(jmax(2, calculator.getNumBuffersNeeded()), blockSize);
+		renderingBuffers.clear();
 
-bool NewAudioProcessorGraph::removeNode(const uint32 nodeId)
-{
-	disconnectNode(nodeId);
+		for (int i = jmax(1, calculator.getNumMidiBuffersNeeded()); --i >= 0;)
+			midiBuffers.add(new MidiBuffer())->ensureSize(2048);
 
-	for (int i = nodes.size(); --i >= 0;)
-	{
-		if (nodes.getUnchecked(i)->nodeId == nodeId)
+		if (isParallel)
 		{
-			nodes.getUnchecked(i)->setParentGraph(nullptr);
-			nodes.remove(i);
-			triggerAsyncUpdate();
+			int widestLevel = 1;
 
-			return true;
+			for (int i = 0; i < levelStarts.size() - 1; ++i)
+				widestLevel = jmax(widestLevel, levelStarts.getUnchecked(i + 1) - levelStarts.getUnchecked(i));
+
+			readyTasks = new Zen::WorkStealingDeque(widestLevel);
 		}
 	}
 
-	return false;
-}
+	const int generation;
+	const bool isParallel;
+	const int blockSize;
+	uint64 retiredAtEpoch = 0;
+
+	ReferenceCountedArray<Node> nodes;
+	bool nodesAreInRenderOrder = false;
+	OwnedArray<Connection> connections;
+
+	Array<void*> ops;
+	Array<int> taskStarts, levelStarts;
+	int latencySamples = 0;
+	Array<uint32> nodesInLoops;
+	AudioSampleBuffer renderingBuffers;
+	OwnedArray<MidiBuffer> midiBuffers;
+	ScopedPointer<Zen::WorkStealingDeque> readyTasks;	///< Only used by the block rendering this program
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RenderProgram)
+};
+
+//==============================================================================
+/** A feedback connection's delay nodes, and the line between them. */
+struct NewAudioProcessorGraph::FeedbackPath
+{
+	explicit FeedbackPath(const Connection& connection_)
+		: connection(connection_)
+	{
+	}
+
+	const Connection connection;
+	Node::Ptr sendNode, returnNode;
+
+	JUCE_DECLARE_NON_COPYABLE(FeedbackPath)
+};
+
+//==============================================================================
+/** Builds programs the message thread asks for, off the message thread, and publishes them. A request replaces
+any that hasn't been started yet, so a burst of edits costs one build.
+*/
+class NewAudioProcessorGraph::ProgramBuilder : public Thread
+{
+public:
+	explicit ProgramBuilder(NewAudioProcessorGraph& graph_)
+		: Thread("Graph program builder"), graph(graph_)
+	{
+		startThread();
+	}
+
+	~ProgramBuilder()
+	{
+		stopThread(4000);
+	}
+
+	/** Takes ownership of an unbuilt program. Message thread only. */
+	void requestBuild(RenderProgram* const program)
+	{
+		ScopedPointer<RenderProgram> replaced(program);
+
+		{
+			const ScopedLock sl(pendingLock);
+			pending.swapWith(replaced);
+		}
+
+		// The replaced request is deleted here, on the message thread, because it holds node references
+		replaced = nullptr;
+		notify();
+	}
+
+	void run() override
+	{
+		while (!threadShouldExit())
+		{
+			RenderProgram* program;
+
+			{
+				const ScopedLock sl(pendingLock);
+				program = pending.release();
+			}
+
+			if (program == nullptr)
+			{
+				wait(-1);
+				continue;
+			}
+
+			program->build();
+			graph.publishProgram(program);
+		}
+	}
+
+private:
+	NewAudioProcessorGraph& graph;
+	CriticalSection pendingLock;
+	ScopedPointer<RenderProgram> pending;
+
+	JUCE_DECLARE_NON_COPYABLE(ProgramBuilder)
+};
+
+//==============================================================================
+/** Renders a parallel program level by level. The audio thread pushes each level's tasks onto the program's
+work-stealing deque and works through them from the bottom while the worker threads steal from the top, then
+waits for the level's last task before starting the next. It never needs a worker to turn up: if none do, it
+renders the whole block by itself.
+
+Workers sleep on their events between levels. Only a level with more than one task wakes any, and then no more
+than there are tasks the audio thread won't get to itself; single-task levels run on the audio thread with every
+worker parked.
+
+A worker that has stolen a task owns it until it's rendered, and the audio thread can't start the next level
+until it is. If the OS preempts a worker mid-task the audio thread spins in the tasksRemaining wait for as long as
+that worker is descheduled, so the workers run at a high priority, and a graph whose levels are all cheap gains
+little from them.
+*/
+class NewAudioProcessorGraph::ParallelRenderer
+{
+public:
+	explicit ParallelRenderer(const int numWorkerThreads)
+		: tasksRemaining(0), levelGeneration(0), blockDone(true), activeWorkers(0)
+	{
+		for (int i = 0; i < numWorkerThreads; ++i)
+			workers.add(new Worker(*this, i));
+
+		for (int i = 0; i < workers.size(); ++i)
+			workers.getUnchecked(i)->startThread(10);
+	}
+
+	~ParallelRenderer()
+	{
+		for (int i = 0; i < workers.size(); ++i)
+			workers.getUnchecked(i)->signalThreadShouldExit();
+
+		for (int i = 0; i < workers.size(); ++i)
+		{
+			workers.getUnchecked(i)->wakeUp.signal();
+			workers.getUnchecked(i)->stopThread(1000);
+		}
+	}
+
+	int getNumWorkers() const noexcept { return workers.size(); }
+
+	/** Audio thread only. Returns once every task has been rendered and no worker is looking at the program. */
+	void render(RenderProgram& program, const int numSamples) noexcept
+	{
+		blockProgram = &program;
+		blockNumSamples = numSamples;
+		blockDone.store(false);
+
+		const Array<int>& levelStarts = program.levelStarts;
+
+		for (int level = 0; level < levelStarts.size() - 1; ++level)
+		{
+			const int firstTask = levelStarts.getUnchecked(level);
+			const int endTask = levelStarts.getUnchecked(level + 1);
+
+			if (endTask - firstTask == 1)
+			{
+				renderTask(firstTask);
+				continue;
+			}
+
+			tasksRemaining.store(endTask - firstTask, std::memory_order_relaxed);
+
+			// Pushed last to first, so the audio thread pops in sequence order and the thieves start from the far end
+			for (int task = endTask; --task >= firstTask;)
+				program.readyTasks->push(task);
+
+			// The audio thread takes one task itself, so there's work for at most one worker per remaining task
+			levelGeneration.fetch_add(1);
+
+			for (int i = jmin(workers.size(), endTask - firstTask - 1); --i >= 0;)
+				workers.getUnchecked(i)->wakeUp.signal();
+
+			int task;
+
+			while (program.readyTasks->pop(task))
+				renderTaskAndCount(task);
+
+			// Only tasks the workers have already stolen are left.  This is where a preempted worker stalls the block
+			while (tasksRemaining.load(std::memory_order_acquire) > 0)
+				pause();
+		}
+
+		blockDone.store(true);
+
+		while (activeWorkers.load() > 0)
+			pause();
+	}
+
+private:
+	//==============================================================================
+	class Worker : public Thread
+	{
+	public:
+		Worker(ParallelRenderer& owner_, const int index)
+			: Thread("Graph render worker " + String(index + 1)), owner(owner_)
+		{
+		}
+
+		void run() override
+		{
+			int lastGeneration = owner.levelGeneration.load();
+
+			while (!threadShouldExit())
+			{
+				const int generation = owner.levelGeneration.load();
+
+				if (generation == lastGeneration)
+				{
+					wakeUp.wait(100);
+					continue;
+				}
+
+				lastGeneration = generation;
+
+				// Checked in before looking at the block, so the audio thread can't finish it without waiting for us
+				owner.activeWorkers.fetch_add(1);
+
+				if (!owner.blockDone.load())
+					owner.stealUntilLevelEmpty();
+
+				owner.activeWorkers.fetch_sub(1, std::memory_order_release);
+			}
+		}
+
+		WaitableEvent wakeUp;
+
+	private:
+		ParallelRenderer& owner;
+
+		JUCE_DECLARE_NON_COPYABLE(Worker)
+	};
+
+	/** Steals from the current level until its deque is empty, then goes back to sleep. A worker that arrives late
+		for its level may find the next one's tasks instead, which is fine: the program is the same all block. */
+	void stealUntilLevelEmpty() noexcept
+	{
+		Zen::WorkStealingDeque& readyTasks = *blockProgram->readyTasks;
+		int task;
+
+		while (!blockDone.load(std::memory_order_acquire))
+		{
+			if (readyTasks.steal(task))
+				renderTaskAndCount(task);
+			else if (readyTasks.isEmpty())
+				break;
+			else
+				pause();	// Lost the race for a task, there may be more
+		}
+	}
+
+	void renderTask(const int task) noexcept
+	{
+		RenderProgram& program = *blockProgram;
+		const int endOp = program.taskStarts.getUnchecked(task + 1);
+
+		for (int i = program.taskStarts.getUnchecked(task); i < endOp; ++i)
+		{
+			GraphRenderingOps::AudioGraphRenderingOp* const op
+				= (GraphRenderingOps::AudioGraphRenderingOp*) program.ops.getUnchecked(i);
+
+			op->perform(program.renderingBuffers, program.midiBuffers, blockNumSamples);
+		}
+	}
+
+	void renderTaskAndCount(const int task) noexcept
+	{
+		renderTask(task);
+		tasksRemaining.fetch_sub(1, std::memory_order_acq_rel);
+	}
+
+	static void pause() noexcept
+	{
+	   #if ZEN_USE_SSE_INTRINSICS
+		_mm_pause();
+	   #else
+		Thread::yield();
+	   #endif
+	}
+
+	OwnedArray<Worker> workers;
+	std::atomic<int> tasksRemaining, levelGeneration;
+	std::atomic<bool> blockDone;
+	std::atomic<int> activeWorkers;
+
+	// The block being rendered, only read by workers between checking in and blockDone
+	RenderProgram* blockProgram = nullptr;
+	int blockNumSamples = 0;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParallelRenderer)
+};
+
+//==============================================================================
+NewAudioProcessorGraph::Connection::Connection(const uint32 sourceNodeId_, const int sourceChannelIndex_,
+	const uint32 destNodeId_, const int destChannelIndex_, const bool isFeedback_) noexcept
+	: sourceNodeId(sourceNodeId_), sourceChannelIndex(sourceChannelIndex_),
+	destNodeId(destNodeId_), destChannelIndex(destChannelIndex_), isFeedback(isFeedback_)
+{
+}
+
+//==============================================================================
+NewAudioProcessorGraph::Node::Node(const uint32 nodeId_, AudioProcessor* const processor_) noexcept
+	: nodeId(nodeId_),
+	processor(processor_),
+	isPrepared(false),
+	orderIndex(0),
+	isMarked(false)
+{
+	jassert(processor != nullptr);
+}
+
+void NewAudioProcessorGraph::Node::prepare(const double sampleRate, const int blockSize,
+	NewAudioProcessorGraph* const graph)
+{
+	if (!isPrepared)
+	{
+		isPrepared = true;
+		setParentGraph(graph);
+
+		processor->setPlayConfigDetails(processor->getNumInputChannels(),
+			processor->getNumOutputChannels(),
+			sampleRate, blockSize);
+
+		processor->prepareToPlay(sampleRate, blockSize);
+	}
+}
+
+void NewAudioProcessorGraph::Node::unprepare()
+{
+	if (isPrepared)
+	{
+		isPrepared = false;
+		processor->releaseResources();
+	}
+}
+
+void NewAudioProcessorGraph::Node::setParentGraph(NewAudioProcessorGraph* const graph) const
+{
+	if (NewAudioProcessorGraph::AudioGraphIOProcessor* const ioProc
+		= dynamic_cast <NewAudioProcessorGraph::AudioGraphIOProcessor*> (processor.get()))
+		ioProc->setParentGraph(graph);
+}
+
+//==============================================================================
+NewAudioProcessorGraph::NewAudioProcessorGraph()
+	: lastNodeId(0),
+	nodeOrderIsValid(true),
+	updateDepth(0),
+	lastFeedbackNodeId(firstFeedbackNodeId - 1),
+	currentProgram(nullptr),
+	publishedEpoch(0),
+	completedEpoch(0),
+	programPublished(false),
+	lastPlannedGeneration(0),
+	lastPublishedGeneration(0),
+	sequenceIsStale(false),
+	currentAudioInputBuffer(nullptr),
+	currentMidiInputBuffer(nullptr)
+{
+	programBuilder = new ProgramBuilder(*this);
+}
+
+NewAudioProcessorGraph::~NewAudioProcessorGraph()
+{
+	programBuilder = nullptr;
+	stopTimer();
+	clearRenderingSequence();
+	clear();
+	parallelRenderer = nullptr;
+}
+
+const String NewAudioProcessorGraph::getName() const
+{
+	return "Audio Graph";
+}
+
+//==============================================================================
+void NewAudioProcessorGraph::clear()
+{
+	const ScopedLock sl(planLock);
+
+	nodes.clear();
+	nodesById.clear();
+	connections.clear();
+	feedbackPaths.clear();
+	nodeOrder.clear();
+	nodeOrderIsValid = true;
+	invalidateRenderingSequence();
+}
+
+NewAudioProcessorGraph::Node* NewAudioProcessorGraph::getNodeForId(const uint32 nodeId) const
+{
+	return nodesById[(int)nodeId];
+}
+
+NewAudioProcessorGraph::Node* NewAudioProcessorGraph::addNode(AudioProcessor* const newProcessor, uint32 nodeId)
+{
+	const ScopedLock sl(planLock);
+
+	if (newProcessor == nullptr || newProcessor == this)
+	{
+		jassertfalse;
+		return nullptr;
+	}
+
+	for (int i = nodes.size(); --i >= 0;)
+	{
+		if (nodes.getUnchecked(i)->getProcessor() == newProcessor)
+		{
+			jassertfalse; // Cannot add the same object to the graph twice!
+			return nullptr;
+		}
+	}
+
+	if (nodeId == 0)
+	{
+		nodeId = ++lastNodeId;
+	} else
+	{
+		// you can't add a node with an id that already exists in the graph..
+		jassert(getNodeForId(nodeId) == nullptr);
+		removeNode(nodeId);
+
+		if (nodeId > lastNodeId)
+			lastNodeId = nodeId;
+	}
+
+	newProcessor->setPlayHead(getPlayHead());
+	newProcessor->setNonRealtime(isNonRealtime());
+
+	Node* const n = new Node(nodeId, newProcessor);
+	nodes.add(n);
+	nodesById.set((int)nodeId, n);
+	n->orderIndex = nodeOrder.size();
+	nodeOrder.add(n);
+	invalidateRenderingSequence();
+
+	n->setParentGraph(this);
+	return n;
+}
+
+bool NewAudioProcessorGraph::removeNode(const uint32 nodeId)
+{
+	const ScopedLock sl(planLock);
+
+	disconnectNode(nodeId);
+
+	Node* const node = getNodeForId(nodeId);
+
+	if (node == nullptr)
+		return false;
+
+	// The node is detached from the graph when the last program that renders it is reclaimed
+	const int orderIndex = node->orderIndex;
+	nodeOrder.remove(orderIndex);
+	renumberNodeOrder(orderIndex);
+	nodesById.remove((int)nodeId);
+	nodes.removeObject(node);
+	invalidateRenderingSequence();
+
+	return true;
+}
 
 //==============================================================================
 const NewAudioProcessorGraph::Connection* NewAudioProcessorGraph::getConnectionBetween(const uint32 sourceNodeId,
@@ -1293,18 +2004,26 @@ const NewAudioProcessorGraph::Connection* NewAudioProcessorGraph::getConnectionB
 bool NewAudioProcessorGraph::isConnected(const uint32 possibleSourceNodeId,
 	const uint32 possibleDestNodeId) const
 {
-	for (int i = connections.size(); --i >= 0;)
+	// Connections are sorted by source then destination, so any between the two start where the lowest possible
+	// channels would be inserted
+	const Connection first(possibleSourceNodeId, -1, possibleDestNodeId, -1);
+	int start = 0, end = connections.size();
+
+	while (start < end)
 	{
-		const Connection* const c = connections.getUnchecked(i);
+		const int halfway = (start + end) >> 1;
 
-		if (c->sourceNodeId == possibleSourceNodeId
-			&& c->destNodeId == possibleDestNodeId)
-		{
-			return true;
-		}
+		if (GraphRenderingOps::ConnectionSorter::compareElements(connections.getUnchecked(halfway), &first) < 0)
+			start = halfway + 1;
+		else
+			end = halfway;
 	}
 
-	return false;
+	const Connection* const c = connections[start];
+
+	return c != nullptr
+		&& c->sourceNodeId == possibleSourceNodeId
+		&& c->destNodeId == possibleDestNodeId;
 }
 
 bool NewAudioProcessorGraph::canConnect(const uint32 sourceNodeId,
@@ -1341,25 +2060,59 @@ bool NewAudioProcessorGraph::addConnection(const uint32 sourceNodeId,
 	const uint32 destNodeId,
 	const int destChannelIndex)
 {
+	const ScopedLock sl(planLock);
+
 	if (!canConnect(sourceNodeId, sourceChannelIndex, destNodeId, destChannelIndex))
 		return false;
 
 	GraphRenderingOps::ConnectionSorter sorter;
 	connections.addSorted(sorter, new Connection(sourceNodeId, sourceChannelIndex,
 		destNodeId, destChannelIndex));
-	triggerAsyncUpdate();
+	connectInOrder(getNodeForId(sourceNodeId), getNodeForId(destNodeId));
+	invalidateRenderingSequence();
+	return true;
+}
+
+bool NewAudioProcessorGraph::addFeedbackConnection(const uint32 sourceNodeId,
+	const int sourceChannelIndex,
+	const uint32 destNodeId,
+	const int destChannelIndex)
+{
+	const ScopedLock sl(planLock);
+
+	if (!canConnect(sourceNodeId, sourceChannelIndex, destNodeId, destChannelIndex))
+		return false;
+
+	// Feedback connections stay out of the node order: the plan routes them through delay nodes instead
+	Connection* const c = new Connection(sourceNodeId, sourceChannelIndex, destNodeId, destChannelIndex, true);
+	GraphRenderingOps::ConnectionSorter sorter;
+	connections.addSorted(sorter, c);
+	feedbackPaths.add(new FeedbackPath(*c));
+	invalidateRenderingSequence();
 	return true;
 }
 
 void NewAudioProcessorGraph::removeConnection(const int index)
 {
-	connections.remove(index);
-	triggerAsyncUpdate();
+	const ScopedLock sl(planLock);
+
+	if (const Connection* const c = connections[index])
+	{
+		if (c->isFeedback)
+			feedbackPaths.removeObject(getFeedbackPath(*c));
+		else
+			disconnectInOrder(*c);
+
+		connections.remove(index);
+		invalidateRenderingSequence();
+	}
 }
 
 bool NewAudioProcessorGraph::removeConnection(const uint32 sourceNodeId, const int sourceChannelIndex,
 	const uint32 destNodeId, const int destChannelIndex)
 {
+	const ScopedLock sl(planLock);
+
 	bool doneAnything = false;
 
 	for (int i = connections.size(); --i >= 0;)
@@ -1381,6 +2134,8 @@ bool NewAudioProcessorGraph::removeConnection(const uint32 sourceNodeId, const i
 
 bool NewAudioProcessorGraph::disconnectNode(const uint32 nodeId)
 {
+	const ScopedLock sl(planLock);
+
 	bool doneAnything = false;
 
 	for (int i = connections.size(); --i >= 0;)
@@ -1414,6 +2169,8 @@ bool NewAudioProcessorGraph::isConnectionLegal(const Connection* const c) const
 
 bool NewAudioProcessorGraph::removeIllegalConnections()
 {
+	const ScopedLock sl(planLock);
+
 	bool doneAnything = false;
 
 	for (int i = connections.size(); --i >= 0;)
@@ -1429,91 +2186,429 @@ bool NewAudioProcessorGraph::removeIllegalConnections()
 }
 
 //==============================================================================
-static void deleteRenderOpArray(Array<void*>& ops)
+void NewAudioProcessorGraph::connectInOrder(Node* const source, Node* const dest)
 {
-	for (int i = ops.size(); --i >= 0;)
-		delete static_cast<GraphRenderingOps::AudioGraphRenderingOp*> (ops.getUnchecked(i));
+	source->outputNodes.add(dest);
+	dest->inputNodes.add(source);
+
+	if (nodeOrderIsValid && source->orderIndex > dest->orderIndex)
+		nodeOrderIsValid = reorderForConnection(source, dest);
 }
 
-void NewAudioProcessorGraph::clearRenderingSequence()
+void NewAudioProcessorGraph::disconnectInOrder(const Connection& c)
 {
-	Array<void*> oldOps;
+	Node* const source = getNodeForId(c.sourceNodeId);
+	Node* const dest = getNodeForId(c.destNodeId);
 
+	if (source != nullptr && dest != nullptr)
 	{
-		const ScopedLock sl(getCallbackLock());
-		renderingOps.swapWith(oldOps);
+		source->outputNodes.removeFirstMatchingValue(dest);
+		dest->inputNodes.removeFirstMatchingValue(source);
 	}
+}
+
+bool NewAudioProcessorGraph::reorderForConnection(Node* const source, Node* const dest)
+{
+	// Pearce and Kelly's dynamic topological sort: only the nodes placed between dest and source can be out of
+	// order now, namely those dest leads to and those that lead to source. Both groups swap sides, keeping
+	// their own order, within the positions they already occupy.
+	Array<Node*> leadFromDest, leadToSource;
+	collectOrderRegion(dest, source->orderIndex, true, leadFromDest);
+
+	const bool closesLoop = source->isMarked;
+
+	if (!closesLoop)
+		collectOrderRegion(source, dest->orderIndex, false, leadToSource);
+
+	for (int i = 0; i < leadFromDest.size(); ++i)
+		leadFromDest.getUnchecked(i)->isMarked = false;
+
+	for (int i = 0; i < leadToSource.size(); ++i)
+		leadToSource.getUnchecked(i)->isMarked = false;
+
+	if (closesLoop)
+		return false;
+
+	struct NodeOrderSorter
+	{
+		static int compareElements(const Node* first, const Node* second) noexcept
+		{
+			return first->orderIndex - second->orderIndex;
+		}
+	};
+
+	NodeOrderSorter sorter;
+	leadFromDest.sort(sorter);
+	leadToSource.sort(sorter);
+
+	Array<int> positions;
+	positions.ensureStorageAllocated(leadFromDest.size() + leadToSource.size());
+
+	for (int i = 0; i < leadToSource.size(); ++i)
+		positions.add(leadToSource.getUnchecked(i)->orderIndex);
+
+	for (int i = 0; i < leadFromDest.size(); ++i)
+		positions.add(leadFromDest.getUnchecked(i)->orderIndex);
+
+	DefaultElementComparator<int> ascending;
+	positions.sort(ascending);
+	leadToSource.addArray(leadFromDest);
 
-	deleteRenderOpArray(oldOps);
+	for (int i = 0; i < leadToSource.size(); ++i)
+	{
+		Node* const node = leadToSource.getUnchecked(i);
+		node->orderIndex = positions.getUnchecked(i);
+		nodeOrder.set(node->orderIndex, node);
+	}
+
+	return true;
 }
 
-bool NewAudioProcessorGraph::isAnInputTo(const uint32 possibleInputId,
-	const uint32 possibleDestinationId,
-	const int recursionCheck) const
+void NewAudioProcessorGraph::collectOrderRegion(Node* const start, const int bound, const bool forwards,
+	Array<Node*>& region)
 {
-	if (recursionCheck > 0)
+	// Marks and collects the nodes reachable from start, following connections forwards or backwards, that are
+	// placed no further than bound
+	Array<Node*> toVisit;
+	toVisit.add(start);
+	start->isMarked = true;
+
+	while (toVisit.size() > 0)
 	{
-		for (int i = connections.size(); --i >= 0;)
+		Node* const node = toVisit.getLast();
+		toVisit.removeLast();
+		region.add(node);
+
+		const Array<Node*>& neighbours = forwards ? node->outputNodes : node->inputNodes;
+
+		for (int i = 0; i < neighbours.size(); ++i)
 		{
-			const NewAudioProcessorGraph::Connection* const c = connections.getUnchecked(i);
+			Node* const next = neighbours.getUnchecked(i);
 
-			if (c->destNodeId == possibleDestinationId
-				&& (c->sourceNodeId == possibleInputId
-					|| isAnInputTo(possibleInputId, c->sourceNodeId, recursionCheck - 1)))
-				return true;
+			if (!next->isMarked && (forwards ? next->orderIndex <= bound : next->orderIndex >= bound))
+			{
+				next->isMarked = true;
+				toVisit.add(next);
+			}
 		}
 	}
+}
+
+void NewAudioProcessorGraph::rebuildNodeOrder()
+{
+	// Kahn's algorithm, using orderIndex to count each node's unplaced inputs
+	Array<Node*> ordered;
+	ordered.ensureStorageAllocated(nodes.size());
+
+	for (int i = 0; i < nodes.size(); ++i)
+	{
+		Node* const node = nodes.getUnchecked(i);
+		node->orderIndex = node->inputNodes.size();
+
+		if (node->orderIndex == 0)
+			ordered.add(node);
+	}
+
+	for (int i = 0; i < ordered.size(); ++i)
+	{
+		const Array<Node*>& outputs = ordered.getUnchecked(i)->outputNodes;
+
+		for (int j = 0; j < outputs.size(); ++j)
+			if (--(outputs.getUnchecked(j)->orderIndex) == 0)
+				ordered.add(outputs.getUnchecked(j));
+	}
+
+	nodeOrderIsValid = ordered.size() == nodes.size();
+
+	if (nodeOrderIsValid)
+		nodeOrder.swapWith(ordered);
+
+	renumberNodeOrder(0);
+}
+
+void NewAudioProcessorGraph::renumberNodeOrder(const int startIndex)
+{
+	for (int i = startIndex; i < nodeOrder.size(); ++i)
+		nodeOrder.getUnchecked(i)->orderIndex = i;
+}
+
+//==============================================================================
+void NewAudioProcessorGraph::beginUpdate()
+{
+	++updateDepth;
+}
+
+void NewAudioProcessorGraph::endUpdate()
+{
+	jassert(updateDepth > 0);
 
-	return false;
+	if (--updateDepth == 0 && sequenceIsStale)
+		triggerAsyncUpdate();
 }
 
-void NewAudioProcessorGraph::buildRenderingSequence()
+//==============================================================================
+void NewAudioProcessorGraph::invalidateRenderingSequence()
 {
-	Array<void*> newRenderingOps;
-	int numRenderingBuffersNeeded = 2;
-	int numMidiBuffersNeeded = 1;
+	sequenceIsStale = true;
+
+	if (updateDepth == 0)
+		triggerAsyncUpdate();
+}
+
+NewAudioProcessorGraph::RenderProgram* NewAudioProcessorGraph::planRenderingSequence()
+{
+	const ScopedLock sl(planLock);
+
+	for (int i = 0; i < nodes.size(); ++i)
+	{
+		Node* const node = nodes.getUnchecked(i);
+
+		node->prepare(getSampleRate(), getBlockSize(), this);
+	}
 
+	if (!nodeOrderIsValid)
+		rebuildNodeOrder();
+
+	RenderProgram* const program = new RenderProgram(++lastPlannedGeneration, parallelRenderer != nullptr, getBlockSize());
+	program->nodesAreInRenderOrder = nodeOrderIsValid;
+	program->nodes.ensureStorageAllocated(nodes.size() + 2 * feedbackPaths.size());
+
+	// Each feedback connection becomes source -> send node, return node -> destination. Returns go first and
+	// sends last, which keeps the order valid and renders every return before any send
+	for (int i = 0; i < feedbackPaths.size(); ++i)
+	{
+		prepareFeedbackPath(*feedbackPaths.getUnchecked(i));
+		program->nodes.add(feedbackPaths.getUnchecked(i)->returnNode);
+	}
+
+	if (nodeOrderIsValid)
+	{
+		for (int i = 0; i < nodeOrder.size(); ++i)
+			program->nodes.add(nodeOrder.getUnchecked(i));
+	} else
 	{
-		MessageManagerLock mml;
+		program->nodes.addArray(nodes);
+	}
 
+	for (int i = 0; i < connections.size(); ++i)
+	{
+		const Connection* const c = connections.getUnchecked(i);
+
+		if (!c->isFeedback)
 		{
-			for (int i = 0; i < nodes.size(); ++i)
+			program->connections.add(new Connection(*c));
+			continue;
+		}
+
+		const FeedbackPath* const path = getFeedbackPath(*c);
+		const int delayChannelIndex = c->sourceChannelIndex == midiChannelIndex ? midiChannelIndex : 0;
+
+		program->connections.add(new Connection(c->sourceNodeId, c->sourceChannelIndex,
+			path->sendNode->nodeId, delayChannelIndex));
+		program->connections.add(new Connection(path->returnNode->nodeId, delayChannelIndex,
+			c->destNodeId, c->destChannelIndex));
+	}
+
+	for (int i = 0; i < feedbackPaths.size(); ++i)
+		program->nodes.add(feedbackPaths.getUnchecked(i)->sendNode);
+
+	return program;
+}
+
+NewAudioProcessorGraph::FeedbackPath* NewAudioProcessorGraph::getFeedbackPath(const Connection& c) const
+{
+	for (int i = feedbackPaths.size(); --i >= 0;)
+	{
+		FeedbackPath* const path = feedbackPaths.getUnchecked(i);
+
+		if (GraphRenderingOps::ConnectionSorter::compareElements(&path->connection, &c) == 0)
+			return path;
+	}
+
+	jassertfalse;
+	return nullptr;
+}
+
+void NewAudioProcessorGraph::prepareFeedbackPath(FeedbackPath& path)
+{
+	using GraphRenderingOps::FeedbackDelayProcessor;
+
+	const int blockSize = jmax(1, getBlockSize());
+
+	if (path.sendNode != nullptr
+		&& static_cast<FeedbackDelayProcessor*> (path.sendNode->getProcessor())->getCapacity() >= blockSize)
+		return;
+
+	// A bigger block only comes with prepareToPlay(), when nothing is rendering the old line
+	FeedbackDelayProcessor::Line* const line = new FeedbackDelayProcessor::Line(blockSize);
+	path.sendNode = new Node(++lastFeedbackNodeId, new FeedbackDelayProcessor(line, true));
+	path.returnNode = new Node(++lastFeedbackNodeId, new FeedbackDelayProcessor(line, false));
+}
+
+void NewAudioProcessorGraph::publishProgram(RenderProgram* const program)
+{
+	{
+		const ScopedLock sl(publishLock);
+
+		// Two builds can be in flight when prepareToPlay() builds its own, and the older one mustn't win
+		if (program->generation > lastPublishedGeneration)
+		{
+			lastPublishedGeneration = program->generation;
+
+			RenderProgram* const oldProgram = currentProgram.exchange(program, std::memory_order_acq_rel);
+			retireProgram(oldProgram, publishedEpoch.fetch_add(1, std::memory_order_release) + 1);
+		} else
+		{
+			retireProgram(program, 0);
+		}
+	}
+
+	programPublished.store(true, std::memory_order_release);
+	triggerAsyncUpdate();
+}
+
+void NewAudioProcessorGraph::retireProgram(RenderProgram* const program, const uint64 epoch)
+{
+	if (program != nullptr)
+	{
+		program->retiredAtEpoch = epoch;
+
+		const ScopedLock sl(retiredProgramsLock);
+		retiredPrograms.add(program);
+	}
+}
+
+void NewAudioProcessorGraph::reclaimRetiredPrograms()
+{
+	const uint64 epoch = completedEpoch.load(std::memory_order_acquire);
+	OwnedArray<RenderProgram> reclaimed;
+
+	{
+		const ScopedLock sl(retiredProgramsLock);
+
+		for (int i = retiredPrograms.size(); --i >= 0;)
+			if (retiredPrograms.getUnchecked(i)->retiredAtEpoch <= epoch)
+				reclaimed.add(retiredPrograms.removeAndReturn(i));
+	}
+
+	// Nodes removed from the graph keep pointing at it until nothing can render them any more
+	for (int i = 0; i < reclaimed.size(); ++i)
+	{
+		const ReferenceCountedArray<Node>& programNodes = reclaimed.getUnchecked(i)->nodes;
+
+		for (int j = 0; j < programNodes.size(); ++j)
+		{
+			Node* const node = programNodes.getUnchecked(j);
+			bool stillRendered = nodes.contains(node);
+
+			{
+				const ScopedLock sl(publishLock);
+				const RenderProgram* const program = currentProgram.load(std::memory_order_acquire);
+				stillRendered = stillRendered || (program != nullptr && program->nodes.contains(node));
+			}
+
 			{
-				Node* const node = nodes.getUnchecked(i);
+				const ScopedLock sl(retiredProgramsLock);
 
-				node->prepare(getSampleRate(), getBlockSize(), this);
+				for (int k = retiredPrograms.size(); --k >= 0 && !stillRendered;)
+					stillRendered = retiredPrograms.getUnchecked(k)->nodes.contains(node);
 			}
+
+			if (!stillRendered)
+				node->setParentGraph(nullptr);
 		}
+	}
+}
+
+void NewAudioProcessorGraph::clearRenderingSequence()
+{
+	retireProgram(currentProgram.exchange(nullptr, std::memory_order_acq_rel), 0);
+
+	const ScopedLock sl(retiredProgramsLock);
+	retiredPrograms.clear();
+}
+
+bool NewAudioProcessorGraph::isAnInputTo(const uint32 possibleInputId,
+	const uint32 possibleDestinationId)
+{
+	Node* const input = getNodeForId(possibleInputId);
+	Node* const destination = getNodeForId(possibleDestinationId);
+
+	if (input == nullptr || destination == nullptr || input == destination)
+		return false;
+
+	// Nothing placed after the destination can feed it, and nothing placed before the input can lie between them
+	if (nodeOrderIsValid && input->orderIndex >= destination->orderIndex)
+		return false;
+
+	Array<Node*> ancestors;
+	collectOrderRegion(destination, nodeOrderIsValid ? input->orderIndex : -1, false, ancestors);
+
+	const bool isInput = input->isMarked;
+
+	for (int i = 0; i < ancestors.size(); ++i)
+		ancestors.getUnchecked(i)->isMarked = false;
+
+	return isInput;
+}
+
+void NewAudioProcessorGraph::handleAsyncUpdate()
+{
+	if (programPublished.exchange(false, std::memory_order_acquire))
+	{
+		{
+			const ScopedLock sl(publishLock);
 
-		GraphRenderingOps::RenderingOpSequenceCalculator calculator(*this, nodes, connections, newRenderingOps);
+			if (const RenderProgram* const program = currentProgram.load(std::memory_order_acquire))
+			{
+				setLatencySamples(program->latencySamples);
+				nodesInLoops = program->nodesInLoops;
+			}
+		}
 
-		numRenderingBuffersNeeded = calculator.getNumBuffersNeeded();
-		numMidiBuffersNeeded = calculator.getNumMidiBuffersNeeded();
+		startTimer(50);
 	}
 
+	reclaimRetiredPrograms();
+
+	if (sequenceIsStale && updateDepth == 0)
 	{
-		// swap over to the new rendering sequence..
-		const ScopedLock sl(getCallbackLock());
+		sequenceIsStale = false;
+		programBuilder->requestBuild(planRenderingSequence());
+	}
+}
 
-		renderingBuffers.setSize(numRenderingBuffersNeeded, getBlockSize());
-		renderingBuffers.clear();
+void NewAudioProcessorGraph::timerCallback()
+{
+	reclaimRetiredPrograms();
+
+	const ScopedLock sl(retiredProgramsLock);
 
-		for (int i = midiBuffers.size(); --i >= 0;)
-			midiBuffers.getUnchecked(i)->clear();
+	if (retiredPrograms.size() == 0)
+		stopTimer();
+}
 
-		while (midiBuffers.size() < numMidiBuffersNeeded)
-			midiBuffers.add(new MidiBuffer());
+void NewAudioProcessorGraph::setNumRenderThreads(const int numThreads)
+{
+	if (numThreads == getNumRenderThreads())
+		return;
 
-		renderingOps.swapWith(newRenderingOps);
+	ScopedPointer<ParallelRenderer> newRenderer(numThreads > 0 ? new ParallelRenderer(numThreads) : nullptr);
+
+	{
+		const ScopedLock sl(getCallbackLock());
+		parallelRenderer.swapWith(newRenderer);
 	}
 
-	// delete the old ones..
-	deleteRenderOpArray(newRenderingOps);
+	// The old workers are stopped outside the lock. Until the rebuild, the current sequence is rendered in order,
+	// which is correct whichever way it was planned
+	newRenderer = nullptr;
+	invalidateRenderingSequence();
 }
 
-void NewAudioProcessorGraph::handleAsyncUpdate()
+int NewAudioProcessorGraph::getNumRenderThreads() const noexcept
 {
-	buildRenderingSequence();
+	return parallelRenderer != nullptr ? parallelRenderer->getNumWorkers() : 0;
 }
 
 //==============================================================================
@@ -1524,17 +2619,29 @@ void NewAudioProcessorGraph::prepareToPlay(double /*sampleRate*/, int estimatedS
 	currentMidiInputBuffer = nullptr;
 	currentMidiOutputBuffer.clear();
 
-	clearRenderingSequence();
-	buildRenderingSequence();
+	// Built here rather than on the builder thread so the graph is ready when this returns
+	ScopedPointer<RenderProgram> program(planRenderingSequence());
+	program->build();
+	setLatencySamples(program->latencySamples);
+	publishProgram(program.release());
+
+	// Nothing is rendering, so every program retired so far can be reclaimed
+	completedEpoch.store(publishedEpoch.load(std::memory_order_acquire), std::memory_order_release);
 }
 
 void NewAudioProcessorGraph::releaseResources()
 {
-	for (int i = 0; i < nodes.size(); ++i)
-		nodes.getUnchecked(i)->unprepare();
+	{
+		const ScopedLock sl(planLock);
 
-	renderingBuffers.setSize(1, 1);
-	midiBuffers.clear();
+		for (int i = 0; i < nodes.size(); ++i)
+			nodes.getUnchecked(i)->unprepare();
+	}
+
+	// prepareToPlay() builds a new program, so the buffers can go now rather than when a block acknowledges them
+	retireProgram(currentProgram.exchange(nullptr, std::memory_order_acq_rel), 0);
+	completedEpoch.store(publishedEpoch.load(std::memory_order_acquire), std::memory_order_release);
+	triggerAsyncUpdate();
 
 	currentAudioInputBuffer = nullptr;
 	currentAudioOutputBuffer.setSize(1, 1);
@@ -1545,11 +2652,34 @@ void NewAudioProcessorGraph::releaseResources()
 void NewAudioProcessorGraph::reset()
 {
 	const ScopedLock sl(getCallbackLock());
+	const ScopedLock planSl(planLock);
 
 	for (int i = 0; i < nodes.size(); ++i)
 		nodes.getUnchecked(i)->getProcessor()->reset();
 }
 
+void NewAudioProcessorGraph::setNonRealtime(bool isProcessingNonRealtime) noexcept
+{
+	const ScopedLock sl(getCallbackLock());
+	const ScopedLock planSl(planLock);
+
+	AudioProcessor::setNonRealtime(isProcessingNonRealtime);
+
+	for (int i = 0; i < nodes.size(); ++i)
+		nodes.getUnchecked(i)->getProcessor()->setNonRealtime(isProcessingNonRealtime);
+}
+
+void NewAudioProcessorGraph::setPlayHead(AudioPlayHead* audioPlayHead)
+{
+	const ScopedLock sl(getCallbackLock());
+	const ScopedLock planSl(planLock);
+
+	AudioProcessor::setPlayHead(audioPlayHead);
+
+	for (int i = 0; i < nodes.size(); ++i)
+		nodes.getUnchecked(i)->getProcessor()->setPlayHead(audioPlayHead);
+}
+
 void NewAudioProcessorGraph::processBlock(AudioSampleBuffer& buffer, MidiBuffer& midiMessages)
 {
 	const int numSamples = buffer.getNumSamples();
@@ -1560,14 +2690,27 @@ void NewAudioProcessorGraph::processBlock(AudioSampleBuffer& buffer, MidiBuffer&
 	currentMidiInputBuffer = &midiMessages;
 	currentMidiOutputBuffer.clear();
 
-	for (int i = 0; i < renderingOps.size(); ++i)
+	// The epoch is read first: a program replaced after this read is retired at a later epoch than the one
+	// acknowledged below, so it can't be reclaimed while this block is rendering it
+	const uint64 epoch = publishedEpoch.load(std::memory_order_acquire);
+	RenderProgram* const program = currentProgram.load(std::memory_order_acquire);
+
+	if (program != nullptr && program->isParallel && parallelRenderer != nullptr)
+	{
+		parallelRenderer->render(*program, numSamples);
+	} else if (program != nullptr)
 	{
-		GraphRenderingOps::AudioGraphRenderingOp* const op
-			= (GraphRenderingOps::AudioGraphRenderingOp*) renderingOps.getUnchecked(i);
+		for (int i = 0; i < program->ops.size(); ++i)
+		{
+			GraphRenderingOps::AudioGraphRenderingOp* const op
+				= (GraphRenderingOps::AudioGraphRenderingOp*) program->ops.getUnchecked(i);
 
-		op->perform(renderingBuffers, midiBuffers, numSamples);
+			op->perform(program->renderingBuffers, program->midiBuffers, numSamples);
+		}
 	}
 
+	completedEpoch.store(epoch, std::memory_order_release);
+
 	for (int i = 0; i < buffer.getNumChannels(); ++i)
 		buffer.copyFrom(i, 0, currentAudioOutputBuffer, i, 0, numSamples);
 
@@ -1744,19 +2887,12 @@ bool NewAudioProcessorGraph::AudioGraphIOProcessor::isOutputChannelStereoPair(in
 	return isInputChannelStereoPair(index);
 }
 
-bool NewAudioProcessorGraph::AudioGraphIOProcessor::isInput() const { return type == audioInputNode || type == midiInputNode; }
-bool NewAudioProcessorGraph::AudioGraphIOProcessor::isOutput() const { return type == audioOutputNode || type == midiOutputNode; }
+bool NewAudioProcessorGraph::AudioGraphIOProcessor::isInput() const noexcept { return type == audioInputNode || type == midiInputNode; }
+bool NewAudioProcessorGraph::AudioGraphIOProcessor::isOutput() const noexcept { return type == audioOutputNode || type == midiOutputNode; }
 
 bool NewAudioProcessorGraph::AudioGraphIOProcessor::hasEditor() const { return false; }
 AudioProcessorEditor* NewAudioProcessorGraph::AudioGraphIOProcessor::createEditor() { return nullptr; }
 
-int NewAudioProcessorGraph::AudioGraphIOProcessor::getNumParameters() { return 0; }
-const String NewAudioProcessorGraph::AudioGraphIOProcessor::getParameterName(int) { return String(); }
-
-float NewAudioProcessorGraph::AudioGraphIOProcessor::getParameter(int) { return 0.0f; }
-const String NewAudioProcessorGraph::AudioGraphIOProcessor::getParameterText(int) { return String(); }
-void NewAudioProcessorGraph::AudioGraphIOProcessor::setParameter(int, float) {}
-
 int NewAudioProcessorGraph::AudioGraphIOProcessor::getNumPrograms() { return 0; }
 int NewAudioProcessorGraph::AudioGraphIOProcessor::getCurrentProgram() { return 0; }
 void NewAudioProcessorGraph::AudioGraphIOProcessor::setCurrentProgram(int) {}
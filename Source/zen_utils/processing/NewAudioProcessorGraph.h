@@ -26,6 +26,7 @@ available: visit www.juce.com for more information.
 #define JUCE_NewAudioProcessorGraph_H_INCLUDED
 
 #include "JuceHeader.h"
+#include <atomic>
 
 //==============================================================================
 /**
@@ -42,7 +43,8 @@ To play back a graph through an audio device, you might want to use an
 AudioProcessorPlayer object.
 */
 class JUCE_API  NewAudioProcessorGraph : public AudioProcessor,
-	private AsyncUpdater
+	private AsyncUpdater,
+	private Timer
 {
 public:
 	//==============================================================================
@@ -90,6 +92,11 @@ public:
 		const ScopedPointer<AudioProcessor> processor;
 		bool isPrepared;
 
+		// The graph's message thread bookkeeping for its topological order
+		int orderIndex;
+		Array<Node*> inputNodes, outputNodes;	// One entry per connection
+		bool isMarked;
+
 		Node(uint32 nodeId, AudioProcessor*) noexcept;
 
 		void setParentGraph(NewAudioProcessorGraph*) const;
@@ -109,7 +116,7 @@ public:
 	public:
 		//==============================================================================
 		Connection(uint32 sourceNodeId, int sourceChannelIndex,
-			uint32 destNodeId, int destChannelIndex) noexcept;
+			uint32 destNodeId, int destChannelIndex, bool isFeedback = false) noexcept;
 
 		//==============================================================================
 		/** The ID number of the node which is the input source for this connection.
@@ -140,6 +147,11 @@ public:
 		*/
 		int destChannelIndex;
 
+		/** True if the data arrives a block late, which lets the connection close a loop.
+		@see NewAudioProcessorGraph::addFeedbackConnection
+		*/
+		bool isFeedback;
+
 	private:
 		//==============================================================================
 		JUCE_LEAK_DETECTOR(Connection)
@@ -218,6 +230,21 @@ public:
 	bool addConnection(uint32 sourceNodeId, int sourceChannelIndex,
 		uint32 destNodeId, int destChannelIndex);
 
+	/** Connects two channels through a one-block delay, so that the connection may close a loop.
+
+	The graph renders an ordinary loop with one of its connections silent, and reports its nodes through
+	getNodesInLoops(). A feedback connection instead delivers what its source rendered in the previous block,
+	through a pair of delay nodes with preallocated buffers that the graph inserts when it plans the rendering
+	sequence. Those nodes use IDs from 0xff000000 up, which shouldn't be given to addNode().
+	*/
+	bool addFeedbackConnection(uint32 sourceNodeId, int sourceChannelIndex,
+		uint32 destNodeId, int destChannelIndex);
+
+	/** Returns the IDs of the nodes on loops of ordinary connections in the current rendering sequence.
+	Each of these loops needs one of its connections made a feedback connection.
+	*/
+	const Array<uint32>& getNodesInLoops() const noexcept { return nodesInLoops; }
+
 	/** Deletes the connection with the specified index. */
 	void removeConnection(int index);
 
@@ -244,6 +271,45 @@ public:
 	*/
 	bool removeIllegalConnections();
 
+	//==============================================================================
+	/** Holds back rebuilding the rendering sequence until the matching endUpdate(), so a batch of edits such as
+	loading a session costs one rebuild instead of one per edit. Calls can be nested.
+	*/
+	void beginUpdate();
+
+	/** Ends a beginUpdate(). The outermost one rebuilds the rendering sequence if anything changed. */
+	void endUpdate();
+
+	/** Calls beginUpdate() when created and endUpdate() when deleted. */
+	class ScopedUpdate
+	{
+	public:
+		explicit ScopedUpdate(NewAudioProcessorGraph& graph_) : graph(graph_) { graph.beginUpdate(); }
+		~ScopedUpdate() { graph.endUpdate(); }
+
+	private:
+		NewAudioProcessorGraph& graph;
+
+		JUCE_DECLARE_NON_COPYABLE(ScopedUpdate)
+	};
+
+	//==============================================================================
+	/** Sets how many worker threads render independent branches of the graph alongside the audio thread.
+
+	With 0, the default, the nodes are rendered one after another on the audio thread. Otherwise they're grouped
+	into dependency levels, and the nodes of each level are shared between the audio thread and the workers
+	through a lock-free work-stealing deque, all of them finishing before the next level starts. Graphs with
+	many parallel branches get faster; a single chain doesn't, and pays for the copies that keep branches
+	from sharing buffers.
+
+	Audio and midi output nodes all write the graph's output, so each is rendered in a level of its own after
+	the rest of the graph.
+	*/
+	void setNumRenderThreads(int numThreads);
+
+	/** Returns the number of worker threads set by setNumRenderThreads(). */
+	int getNumRenderThreads() const noexcept;
+
 	//==============================================================================
 	/** A special number that represents the midi channel of a node.
 
@@ -375,11 +441,45 @@ public:
 private:
 	//==============================================================================
 	ReferenceCountedArray<Node> nodes;
+	HashMap<int, Node*> nodesById;
 	OwnedArray<Connection> connections;
 	uint32 lastNodeId;
-	AudioSampleBuffer renderingBuffers;
-	OwnedArray<MidiBuffer> midiBuffers;
-	Array<void*> renderingOps;
+
+	/* Kept in an order every connection runs forwards in, and repaired locally when a connection is added against
+	it, so a plan never has to sort the whole graph. A connection that closes a loop leaves no such order; plans
+	then fall back to sorting until a rebuild of the order succeeds. */
+	Array<Node*> nodeOrder;
+	bool nodeOrderIsValid;
+	int updateDepth;
+	Array<uint32> nodesInLoops;
+
+	// The delay nodes standing in for each feedback connection, kept from one plan to the next so the delayed
+	// audio isn't lost when the graph is edited
+	struct FeedbackPath;
+	OwnedArray<FeedbackPath> feedbackPaths;
+	uint32 lastFeedbackNodeId;
+
+	/* The audio thread renders whichever program currentProgram points at, and never waits for a new one: they
+	are built on programBuilder's thread and swapped in with an atomic exchange. A replaced program is retired
+	with the epoch its replacement was published at, and deleted on the message thread once the audio thread
+	has finished a block it started at that epoch or later. */
+	struct RenderProgram;
+	class ProgramBuilder;
+	std::atomic<RenderProgram*> currentProgram;
+	std::atomic<uint64> publishedEpoch, completedEpoch;
+	std::atomic<bool> programPublished;
+	OwnedArray<RenderProgram> retiredPrograms;
+	CriticalSection retiredProgramsLock, publishLock;
+
+	/* Guards nodes, nodesById, connections, feedbackPaths and the node order. Every edit takes it, and so does
+	planning, so a host thread calling prepareToPlay() can plan while the message thread edits the graph. */
+	CriticalSection planLock;
+	int lastPlannedGeneration, lastPublishedGeneration;
+	bool sequenceIsStale;
+	ScopedPointer<ProgramBuilder> programBuilder;
+
+	class ParallelRenderer;
+	ScopedPointer<ParallelRenderer> parallelRenderer;
 
 	friend class AudioGraphIOProcessor;
 	AudioSampleBuffer* currentAudioInputBuffer;
@@ -388,9 +488,22 @@ private:
 	MidiBuffer currentMidiOutputBuffer;
 
 	void handleAsyncUpdate() override;
+	void timerCallback() override;
+	void invalidateRenderingSequence();
+	RenderProgram* planRenderingSequence();
+	void publishProgram(RenderProgram*);
+	void retireProgram(RenderProgram*, uint64 epoch);
+	void reclaimRetiredPrograms();
 	void clearRenderingSequence();
-	void buildRenderingSequence();
-	bool isAnInputTo(uint32 possibleInputId, uint32 possibleDestinationId, int recursionCheck) const;
+	void connectInOrder(Node* source, Node* dest);
+	void disconnectInOrder(const Connection&);
+	bool reorderForConnection(Node* source, Node* dest);
+	void collectOrderRegion(Node* start, int bound, bool forwards, Array<Node*>& region);
+	void rebuildNodeOrder();
+	void renumberNodeOrder(int startIndex);
+	FeedbackPath* getFeedbackPath(const Connection&) const;
+	void prepareFeedbackPath(FeedbackPath&);
+	bool isAnInputTo(uint32 possibleInputId, uint32 possibleDestinationId);
 
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(NewAudioProcessorGraph)
 };
@@ -13,10 +13,316 @@
 ===============================================================================*/
 
 #include "ZenDSPFilters.h"
+#include "../utilities/ZenSIMD.hpp"
+#include <cmath>
 
 namespace Zen
 {
-	ZenDSPFilters::ZenDSPFilters() { }
 
-	ZenDSPFilters::~ZenDSPFilters() { }
-}
\ No newline at end of file
+namespace
+{
+struct CookbookTerms
+{
+	CookbookTerms(double sampleRate, double frequency, double q)
+	{
+		const double omega = 2.0 * double_Pi * jlimit(1.0, sampleRate * 0.49, frequency) / sampleRate;
+		cosOmega = std::cos(omega);
+		alpha = std::sin(omega) / (2.0 * jmax(1.0e-3, q));
+	}
+
+	double cosOmega, alpha;
+};
+
+BiquadCoefficients normalize(double b0, double b1, double b2, double a0, double a1, double a2)
+{
+	BiquadCoefficients result;
+	result.b0 = static_cast<float>(b0 / a0);
+	result.b1 = static_cast<float>(b1 / a0);
+	result.b2 = static_cast<float>(b2 / a0);
+	result.a1 = static_cast<float>(a1 / a0);
+	result.a2 = static_cast<float>(a2 / a0);
+	return result;
+}
+
+inline void flushDenormal(float& state) noexcept
+{
+	if (!(state < -1.0e-8f || state > 1.0e-8f)) state = 0.0f;
+}
+}
+
+//==============================================================================
+BiquadCoefficients BiquadCoefficients::makeLowPass(double sampleRate, double frequency, double q)
+{
+	const CookbookTerms t(sampleRate, frequency, q);
+	const double b1 = 1.0 - t.cosOmega;
+
+	return normalize(b1 * 0.5, b1, b1 * 0.5, 1.0 + t.alpha, -2.0 * t.cosOmega, 1.0 - t.alpha);
+}
+
+BiquadCoefficients BiquadCoefficients::makeHighPass(double sampleRate, double frequency, double q)
+{
+	const CookbookTerms t(sampleRate, frequency, q);
+	const double b1 = -(1.0 + t.cosOmega);
+
+	return normalize(-b1 * 0.5, b1, -b1 * 0.5, 1.0 + t.alpha, -2.0 * t.cosOmega, 1.0 - t.alpha);
+}
+
+BiquadCoefficients BiquadCoefficients::makeLowShelf(double sampleRate, double frequency, double q, float gain)
+{
+	const CookbookTerms t(sampleRate, frequency, q);
+	const double A = std::sqrt(jmax(1.0e-6, static_cast<double>(gain)));
+	const double twoRootAAlpha = 2.0 * std::sqrt(A) * t.alpha;
+
+	return normalize(A * ((A + 1.0) - (A - 1.0) * t.cosOmega + twoRootAAlpha),
+					 2.0 * A * ((A - 1.0) - (A + 1.0) * t.cosOmega),
+					 A * ((A + 1.0) - (A - 1.0) * t.cosOmega - twoRootAAlpha),
+					 (A + 1.0) + (A - 1.0) * t.cosOmega + twoRootAAlpha,
+					 -2.0 * ((A - 1.0) + (A + 1.0) * t.cosOmega),
+					 (A + 1.0) + (A - 1.0) * t.cosOmega - twoRootAAlpha);
+}
+
+BiquadCoefficients BiquadCoefficients::makeHighShelf(double sampleRate, double frequency, double q, float gain)
+{
+	const CookbookTerms t(sampleRate, frequency, q);
+	const double A = std::sqrt(jmax(1.0e-6, static_cast<double>(gain)));
+	const double twoRootAAlpha = 2.0 * std::sqrt(A) * t.alpha;
+
+	return normalize(A * ((A + 1.0) + (A - 1.0) * t.cosOmega + twoRootAAlpha),
+					 -2.0 * A * ((A - 1.0) + (A + 1.0) * t.cosOmega),
+					 A * ((A + 1.0) + (A - 1.0) * t.cosOmega - twoRootAAlpha),
+					 (A + 1.0) - (A - 1.0) * t.cosOmega + twoRootAAlpha,
+					 2.0 * ((A - 1.0) - (A + 1.0) * t.cosOmega),
+					 (A + 1.0) - (A - 1.0) * t.cosOmega - twoRootAAlpha);
+}
+
+BiquadCoefficients BiquadCoefficients::makePeak(double sampleRate, double frequency, double q, float gain)
+{
+	const CookbookTerms t(sampleRate, frequency, q);
+	const double A = std::sqrt(jmax(1.0e-6, static_cast<double>(gain)));
+
+	return normalize(1.0 + t.alpha * A, -2.0 * t.cosOmega, 1.0 - t.alpha * A,
+					 1.0 + t.alpha / A, -2.0 * t.cosOmega, 1.0 - t.alpha / A);
+}
+
+BiquadCoefficients BiquadCoefficients::makeAllPass(double sampleRate, double frequency, double q)
+{
+	const CookbookTerms t(sampleRate, frequency, q);
+
+	return normalize(1.0 - t.alpha, -2.0 * t.cosOmega, 1.0 + t.alpha,
+					 1.0 + t.alpha, -2.0 * t.cosOmega, 1.0 - t.alpha);
+}
+
+BiquadCoefficients BiquadCoefficients::makeOnePoleLowPass(float pole, float gain)
+{
+	BiquadCoefficients result;
+	result.b0 = (1.0f - pole) * gain;
+	result.a1 = -pole;
+	return result;
+}
+
+BiquadCoefficients BiquadCoefficients::withGain(float gain) const
+{
+	BiquadCoefficients result(*this);
+	result.b0 *= gain;
+	result.b1 *= gain;
+	result.b2 *= gain;
+	return result;
+}
+
+//==============================================================================
+BiquadBank::BiquadBank()
+{
+	for (int i = 0; i < numCoefficients; ++i)
+		coefficients[i] = nullptr;
+
+	for (int i = 0; i < numStates; ++i)
+		states[i] = nullptr;
+}
+
+BiquadBank::~BiquadBank()
+{
+	release();
+}
+
+void BiquadBank::prepare(int inNumFilters)
+{
+	jassert(inNumFilters > 0 && inNumFilters <= maxNumFilters);
+
+	numFilters = jlimit(1, static_cast<int>(maxNumFilters), inNumFilters);
+	numPaddedFilters = (numFilters + laneWidth - 1) & ~(laneWidth - 1);
+
+	// Every array is a multiple of four floats long, so aligning the first aligns them all
+	memory.allocate(static_cast<size_t>((numCoefficients + numStates) * numPaddedFilters + 4), true);
+
+	float* data = getAligned16(memory);
+
+	for (int i = 0; i < numCoefficients; ++i, data += numPaddedFilters)
+		coefficients[i] = data;
+
+	for (int i = 0; i < numStates; ++i, data += numPaddedFilters)
+		states[i] = data;
+
+	for (int i = 0; i < numFilters; ++i)
+		setCoefficients(i, BiquadCoefficients());
+}
+
+void BiquadBank::release()
+{
+	memory.free();
+
+	for (int i = 0; i < numCoefficients; ++i)
+		coefficients[i] = nullptr;
+
+	for (int i = 0; i < numStates; ++i)
+		states[i] = nullptr;
+
+	numFilters = numPaddedFilters = 0;
+}
+
+void BiquadBank::reset() noexcept
+{
+	for (int i = 0; i < numStates; ++i)
+		if (states[i] != nullptr)
+			FloatVectorOperations::clear(states[i], numPaddedFilters);
+}
+
+void BiquadBank::setCoefficients(int filterIndex, const BiquadCoefficients& newCoefficients) noexcept
+{
+	jassert(isPositiveAndBelow(filterIndex, numFilters));
+
+	coefficients[0][filterIndex] = newCoefficients.b0;
+	coefficients[1][filterIndex] = newCoefficients.b1;
+	coefficients[2][filterIndex] = newCoefficients.b2;
+	coefficients[3][filterIndex] = newCoefficients.a1;
+	coefficients[4][filterIndex] = newCoefficients.a2;
+}
+
+BiquadCoefficients BiquadBank::getCoefficients(int filterIndex) const noexcept
+{
+	jassert(isPositiveAndBelow(filterIndex, numFilters));
+
+	BiquadCoefficients result;
+	result.b0 = coefficients[0][filterIndex];
+	result.b1 = coefficients[1][filterIndex];
+	result.b2 = coefficients[2][filterIndex];
+	result.a1 = coefficients[3][filterIndex];
+	result.a2 = coefficients[4][filterIndex];
+	return result;
+}
+
+void BiquadBank::process(float* const* channels, int numSamples) noexcept
+{
+	if (memory == nullptr || numSamples <= 0) return;
+
+	int filter = 0;
+
+#if ZEN_USE_SSE_INTRINSICS
+	for (; filter + laneWidth <= numFilters; filter += laneWidth)
+		processLaneGroup(filter, channels, numSamples);
+#endif
+
+	for (; filter < numFilters; ++filter)
+		processSingle(filter, channels[filter], numSamples);
+
+	// Flush states that decayed into the denormal range once per block instead of every sample
+	for (int i = 0; i < numFilters; ++i)
+	{
+		flushDenormal(states[0][i]);
+		flushDenormal(states[1][i]);
+	}
+}
+
+void BiquadBank::processLaneGroup(int firstFilter, float* const* channels, int numSamples) noexcept
+{
+#if ZEN_USE_SSE_INTRINSICS
+	// Transposed direct form II per lane:  y = b0 x + s1;  s1 = b1 x - a1 y + s2;  s2 = b2 x - a2 y
+	const __m128 b0 = _mm_load_ps(coefficients[0] + firstFilter);
+	const __m128 b1 = _mm_load_ps(coefficients[1] + firstFilter);
+	const __m128 b2 = _mm_load_ps(coefficients[2] + firstFilter);
+	const __m128 a1 = _mm_load_ps(coefficients[3] + firstFilter);
+	const __m128 a2 = _mm_load_ps(coefficients[4] + firstFilter);
+	__m128 s1 = _mm_load_ps(states[0] + firstFilter);
+	__m128 s2 = _mm_load_ps(states[1] + firstFilter);
+
+	float* const lane0 = channels[firstFilter];
+	float* const lane1 = channels[firstFilter + 1];
+	float* const lane2 = channels[firstFilter + 2];
+	float* const lane3 = channels[firstFilter + 3];
+
+#define ZEN_BIQUAD_STEP(x, y) \
+	y = _mm_add_ps(_mm_mul_ps(b0, x), s1); \
+	s1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b1, x), _mm_mul_ps(a1, y)), s2); \
+	s2 = _mm_sub_ps(_mm_mul_ps(b2, x), _mm_mul_ps(a2, y));
+
+	int i = 0;
+
+	for (; i + 4 <= numSamples; i += 4)
+	{
+		// After the transpose xN holds time step i + N of all four lanes
+		__m128 x0 = _mm_loadu_ps(lane0 + i);
+		__m128 x1 = _mm_loadu_ps(lane1 + i);
+		__m128 x2 = _mm_loadu_ps(lane2 + i);
+		__m128 x3 = _mm_loadu_ps(lane3 + i);
+		_MM_TRANSPOSE4_PS(x0, x1, x2, x3);
+
+		__m128 y0, y1, y2, y3;
+		ZEN_BIQUAD_STEP(x0, y0);
+		ZEN_BIQUAD_STEP(x1, y1);
+		ZEN_BIQUAD_STEP(x2, y2);
+		ZEN_BIQUAD_STEP(x3, y3);
+
+		_MM_TRANSPOSE4_PS(y0, y1, y2, y3);
+		_mm_storeu_ps(lane0 + i, y0);
+		_mm_storeu_ps(lane1 + i, y1);
+		_mm_storeu_ps(lane2 + i, y2);
+		_mm_storeu_ps(lane3 + i, y3);
+	}
+
+	for (; i < numSamples; ++i)
+	{
+		const __m128 x = _mm_setr_ps(lane0[i], lane1[i], lane2[i], lane3[i]);
+		__m128 y;
+		ZEN_BIQUAD_STEP(x, y);
+
+		float outputs[4];
+		_mm_storeu_ps(outputs, y);
+		lane0[i] = outputs[0];
+		lane1[i] = outputs[1];
+		lane2[i] = outputs[2];
+		lane3[i] = outputs[3];
+	}
+
+#undef ZEN_BIQUAD_STEP
+
+	_mm_store_ps(states[0] + firstFilter, s1);
+	_mm_store_ps(states[1] + firstFilter, s2);
+#else
+	for (int filter = firstFilter; filter < firstFilter + laneWidth; ++filter)
+		processSingle(filter, channels[filter], numSamples);
+#endif
+}
+
+void BiquadBank::processSingle(int filterIndex, float* data, int numSamples) noexcept
+{
+	const float b0 = coefficients[0][filterIndex];
+	const float b1 = coefficients[1][filterIndex];
+	const float b2 = coefficients[2][filterIndex];
+	const float a1 = coefficients[3][filterIndex];
+	const float a2 = coefficients[4][filterIndex];
+	float s1 = states[0][filterIndex];
+	float s2 = states[1][filterIndex];
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		const float x = data[i];
+		const float y = b0 * x + s1;
+		s1 = b1 * x - a1 * y + s2;
+		s2 = b2 * x - a2 * y;
+		data[i] = y;
+	}
+
+	states[0][filterIndex] = s1;
+	states[1][filterIndex] = s2;
+}
+
+} // namespace Zen
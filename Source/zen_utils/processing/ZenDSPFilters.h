@@ -7,7 +7,8 @@
 //  Copyright (C) 2015 by Casey Bailey
 //  Provided under the [GNU license]
 //
-//  Details: General DSP ZenDSPFilters (IIR)
+//  Details: General DSP ZenDSPFilters (IIR) - biquad coefficient design and a
+//  structure-of-arrays filter bank that runs one filter per SIMD lane
 //
 //  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
 ===============================================================================*/
@@ -18,16 +19,76 @@
 
 namespace Zen{
 
-class ZenDSPFilters
+/// <summary> Normalized biquad coefficients (a0 == 1):
+/// y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2].
+/// The design functions follow the RBJ Audio EQ Cookbook, shelf and peak gains are linear amplitude. </summary>
+struct BiquadCoefficients
 {
+	float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
 
+	static BiquadCoefficients makeLowPass(double sampleRate, double frequency, double q = 0.7071);
+	static BiquadCoefficients makeHighPass(double sampleRate, double frequency, double q = 0.7071);
+	static BiquadCoefficients makeLowShelf(double sampleRate, double frequency, double q, float gain);
+	static BiquadCoefficients makeHighShelf(double sampleRate, double frequency, double q, float gain);
+	static BiquadCoefficients makePeak(double sampleRate, double frequency, double q, float gain);
+	static BiquadCoefficients makeAllPass(double sampleRate, double frequency, double q = 0.7071);
+
+	/// <summary> y[n] = (1 - pole) x[n] + pole y[n-1], the usual reverb damping lowpass, with an overall gain </summary>
+	static BiquadCoefficients makeOnePoleLowPass(float pole, float gain = 1.0f);
+
+	/// <summary> Scales the whole response by a constant gain </summary>
+	BiquadCoefficients withGain(float gain) const;
+};
+
+/// <summary> A bank of independent biquads, filter i processing channel i in place, e.g. one per delay line.
+///
+/// Coefficients and states are stored structure-of-arrays so each group of four filters is one set of SSE
+/// registers.  Four samples of each of the four channels are loaded, transposed so every register holds one
+/// time step across the lanes, run through four transposed direct form II steps and transposed back.  Filters
+/// left over past the last full group of four run scalar.  Eight filters are two groups. </summary>
+class BiquadBank
+{
 public:
-	
-	ZenDSPFilters();
-	~ZenDSPFilters();
+	enum
+	{
+		laneWidth = 4,
+		maxNumFilters = 64
+	};
+
+	BiquadBank();
+	~BiquadBank();
+
+	/// <summary> Allocates coefficients and states for numFilters filters, all set to pass through.
+	/// The only place this class allocates. </summary>
+	void prepare(int numFilters);
+
+	/// <summary> Frees all memory. </summary>
+	void release();
+
+	/// <summary> Clears every filter's state, coefficients are kept. </summary>
+	void reset() noexcept;
+
+	void setCoefficients(int filterIndex, const BiquadCoefficients& newCoefficients) noexcept;
+	BiquadCoefficients getCoefficients(int filterIndex) const noexcept;
+
+	/// <summary> Filters channels[i] in place with filter i, for every filter in the bank. </summary>
+	void process(float* const* channels, int numSamples) noexcept;
+
+	int getNumFilters() const noexcept { return numFilters; }
 
 private:
+	enum { numCoefficients = 5, numStates = 2 };
 
+	void processLaneGroup(int firstFilter, float* const* channels, int numSamples) noexcept;
+	void processSingle(int filterIndex, float* data, int numSamples) noexcept;
+
+	HeapBlock<float> memory;
+	float* coefficients[numCoefficients];	///< b0, b1, b2, a1, a2 arrays of numPaddedFilters, 16 byte aligned
+	float* states[numStates];				///< TDF-II s1, s2 arrays, 16 byte aligned
+	int numFilters = 0, numPaddedFilters = 0;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BiquadBank);
 };
+
 } // namespace Zen
 #endif // FILTERS_H_INCLUDED
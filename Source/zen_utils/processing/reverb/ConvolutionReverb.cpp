@@ -0,0 +1,344 @@
+/*==============================================================================
+//  ConvolutionReverb.cpp
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Stereo convolution reverb engine - impulse response management,
+//  latency-matched dry path and wet/dry mix around HybridConvolver
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#include "ConvolutionReverb.h"
+#include "../../utilities/ZenUtils.hpp"
+#include <cmath>
+
+namespace Zen
+{
+
+ConvolutionReverb::ConvolutionReverb()
+	: impulseResponse(createDefaultImpulseResponse(48000.0, 2.0))
+{
+}
+
+ConvolutionReverb::~ConvolutionReverb()
+{
+	release();
+}
+
+void ConvolutionReverb::prepare(double inSampleRate, int inMaxBlockSize)
+{
+	jassert(inSampleRate > 0 && inMaxBlockSize > 0);
+
+	sampleRate = inSampleRate;
+	maxBlockSize = inMaxBlockSize;
+	partitionSize = nextPowerOfTwo(maxBlockSize);
+
+	wetBuffer.setSize(2, maxBlockSize);
+	dryDelayBuffer.setSize(2, partitionSize);
+
+	worker.removeAllConvolvers();
+	convolvers.clear();
+
+	if (useWorkerThread)
+		worker.startThread(8);
+	else
+		worker.stopThread(1000);
+
+	const AudioSampleBuffer preparedImpulse(createPreparedImpulse());
+	buildConvolvers(convolvers, preparedImpulse);
+	preparedImpulseLength = preparedImpulse.getNumSamples();
+	dryDelayLength = convolvers.getUnchecked(0)->getLatencySamples();
+
+	for (int i = 0; i < convolvers.size(); ++i)
+		worker.addConvolver(&convolvers.getUnchecked(i)->getTailConvolver());
+
+	reset();
+}
+
+void ConvolutionReverb::release()
+{
+	worker.stopThread(1000);
+	worker.removeAllConvolvers();
+	convolvers.clear();
+	wetBuffer.setSize(1, 1);
+	dryDelayBuffer.setSize(1, 1);
+	maxBlockSize = partitionSize = dryDelayLength = 0;
+}
+
+void ConvolutionReverb::reset() noexcept
+{
+	for (int i = 0; i < convolvers.size(); ++i)
+		convolvers.getUnchecked(i)->reset();
+
+	dryDelayBuffer.clear();
+	dryDelayPosition = 0;
+}
+
+void ConvolutionReverb::setImpulseResponse(const AudioSampleBuffer& newImpulse, double newImpulseRate, const CriticalSection& processLock)
+{
+	jassert(newImpulse.getNumSamples() > 0 && newImpulseRate > 0);
+
+	impulseResponse = newImpulse;
+	impulseSampleRate = newImpulseRate;
+
+	if (maxBlockSize == 0) return;	// Not prepared yet, prepare() will pick it up
+
+	rebuildConvolvers(processLock);
+}
+
+void ConvolutionReverb::setZeroLatency(bool shouldBeZeroLatency, const CriticalSection& processLock)
+{
+	if (shouldBeZeroLatency == zeroLatency) return;
+
+	zeroLatency = shouldBeZeroLatency;
+
+	if (maxBlockSize == 0) return;	// Not prepared yet, prepare() will pick it up
+
+	rebuildConvolvers(processLock);
+}
+
+void ConvolutionReverb::rebuildConvolvers(const CriticalSection& processLock)
+{
+	const AudioSampleBuffer preparedImpulse(createPreparedImpulse());
+	OwnedArray<HybridConvolver> newConvolvers;
+	buildConvolvers(newConvolvers, preparedImpulse);
+
+	// The worker picks up the new convolvers before the audio thread can post to them
+	for (int i = 0; i < newConvolvers.size(); ++i)
+		worker.addConvolver(&newConvolvers.getUnchecked(i)->getTailConvolver());
+
+	{
+		const ScopedLock sl(processLock);
+		convolvers.swapWith(newConvolvers);
+		preparedImpulseLength = preparedImpulse.getNumSamples();
+
+		const int newDryDelayLength = convolvers.getUnchecked(0)->getLatencySamples();
+
+		if (newDryDelayLength != dryDelayLength)
+		{
+			dryDelayLength = newDryDelayLength;
+			dryDelayBuffer.clear();
+			dryDelayPosition = 0;
+		}
+	}
+
+	for (int i = 0; i < newConvolvers.size(); ++i)
+		worker.removeConvolver(&newConvolvers.getUnchecked(i)->getTailConvolver());
+
+	// The old convolvers are deleted here, outside the lock and after the worker let go of them
+}
+
+bool ConvolutionReverb::loadImpulseResponse(const File& impulseFile, const CriticalSection& processLock)
+{
+	AudioFormatManager formatManager;
+	formatManager.registerBasicFormats();
+
+	ScopedPointer<AudioFormatReader> reader(formatManager.createReaderFor(impulseFile));
+
+	if (reader == nullptr || reader->lengthInSamples <= 0)
+		return false;
+
+	// Three channel files are read as stereo, four as true stereo
+	const int numChannels = (reader->numChannels >= 4) ? 4 : jlimit(1, 2, static_cast<int>(reader->numChannels));
+	AudioSampleBuffer newImpulse(numChannels, static_cast<int>(reader->lengthInSamples));
+	reader->read(&newImpulse, 0, newImpulse.getNumSamples(), 0, true, numChannels > 1);
+
+	setImpulseResponse(newImpulse, reader->sampleRate, processLock);
+	return true;
+}
+
+void ConvolutionReverb::setMix(float inMix) noexcept
+{
+	const float mix = getClamped(inMix, 0.0f, 1.0f);
+	dryGain = 1.0f - mix;
+	wetGain = mix;
+}
+
+void ConvolutionReverb::setNonRealtime(bool isNonRealtime) noexcept
+{
+	for (int i = 0; i < convolvers.size(); ++i)
+		convolvers.getUnchecked(i)->getTailConvolver().setNonRealtime(isNonRealtime);
+}
+
+void ConvolutionReverb::processStereo(float* leftData, float* rightData, int numSamples) noexcept
+{
+	if (convolvers.size() == 0) return;
+
+	while (numSamples > 0)
+	{
+		const int numToDo = jmin(numSamples, maxBlockSize);
+		const float* const inputs[2] = { leftData, rightData };
+		float* const wets[2] = { wetBuffer.getWritePointer(0), wetBuffer.getWritePointer(1) };
+
+		if (isTrueStereo())
+		{
+			convolvers.getUnchecked(0)->process(inputs, wets, numToDo);
+		}
+		else
+		{
+			for (int channel = 0; channel < 2; ++channel)
+				convolvers.getUnchecked(channel)->process(inputs[channel], wets[channel], numToDo);
+		}
+
+		for (int channel = 0; channel < 2; ++channel)
+		{
+			float* const data = (channel == 0) ? leftData : rightData;
+			const float* const wet = wets[channel];
+
+			if (dryDelayLength > 0)
+				delayDryChannel(channel, data, numToDo);
+
+			FloatVectorOperations::multiply(data, dryGain, numToDo);
+			FloatVectorOperations::addWithMultiply(data, wet, wetGain, numToDo);
+		}
+
+		if (dryDelayLength > 0)
+			dryDelayPosition = (dryDelayPosition + numToDo) % dryDelayLength;
+
+		leftData += numToDo;
+		rightData += numToDo;
+		numSamples -= numToDo;
+	}
+}
+
+void ConvolutionReverb::delayDryChannel(int channel, float* data, int numSamples) noexcept
+{
+	float* const delayLine = dryDelayBuffer.getWritePointer(channel);
+	int position = dryDelayPosition;
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		const float delayed = delayLine[position];
+		delayLine[position] = data[i];
+		data[i] = delayed;
+
+		if (++position >= dryDelayLength) position = 0;
+	}
+}
+
+String ConvolutionReverb::getScheduleDescription() const
+{
+	String description;
+
+	for (int index = 0; index < convolvers.size(); ++index)
+	{
+		const HybridConvolver* const convolver = convolvers.getUnchecked(index);
+		const NonUniformConvolver& tail = convolver->getTailConvolver();
+
+		if (isTrueStereo())
+			description << "True stereo 2 x 2";
+		else
+			description << "Channel " << index;
+
+		description << ", latency " << convolver->getLatencySamples()
+			<< ", direct head " << convolver->getDirectHeadLength() << " taps"
+			<< ", deadline misses " << tail.getTotalDeadlineMisses() << "\n"
+			<< tail.getScheduleDescription();
+	}
+
+	return description;
+}
+
+double ConvolutionReverb::getTailLengthSeconds() const
+{
+	return (sampleRate > 0) ? preparedImpulseLength / sampleRate : 0.0;
+}
+
+AudioSampleBuffer ConvolutionReverb::createPreparedImpulse() const
+{
+	const int numChannels = (impulseResponse.getNumChannels() >= 4) ? 4 : jmin(2, impulseResponse.getNumChannels());
+	const double speedRatio = impulseSampleRate / sampleRate;
+	int numSamples = impulseResponse.getNumSamples();
+
+	if (speedRatio != 1.0)
+		numSamples = jmax(1, static_cast<int>((numSamples - 1) / speedRatio));
+
+	AudioSampleBuffer prepared(numChannels, numSamples);
+
+	// True stereo paths LL, LR, RL, RR: channel c feeds output c % 2
+	const int numOutputs = jmin(2, numChannels);
+	double outputEnergy[2] = { 0.0, 0.0 };
+
+	for (int channel = 0; channel < numChannels; ++channel)
+	{
+		if (speedRatio != 1.0)
+		{
+			LagrangeInterpolator interpolator;
+			interpolator.process(speedRatio, impulseResponse.getReadPointer(channel), prepared.getWritePointer(channel), numSamples);
+		}
+		else
+		{
+			prepared.copyFrom(channel, 0, impulseResponse, channel, 0, numSamples);
+		}
+
+		const float* data = prepared.getReadPointer(channel);
+		double energy = 0.0;
+
+		for (int i = 0; i < numSamples; ++i)
+			energy += data[i] * data[i];
+
+		outputEnergy[channel % numOutputs] += energy;
+	}
+
+	const double maxEnergy = jmax(outputEnergy[0], outputEnergy[1]);
+
+	// Normalize to unit energy so different impulses sit at a similar level
+	if (maxEnergy > 0.0)
+		prepared.applyGain(static_cast<float>(1.0 / std::sqrt(maxEnergy)));
+
+	return prepared;
+}
+
+void ConvolutionReverb::buildConvolvers(OwnedArray<HybridConvolver>& dest, const AudioSampleBuffer& preparedImpulse)
+{
+	ConvolutionWorker* const tailWorker = worker.isThreadRunning() ? &worker : nullptr;
+
+	if (preparedImpulse.getNumChannels() == 4)
+	{
+		const float* impulses[4];
+
+		for (int path = 0; path < 4; ++path)
+			impulses[path] = preparedImpulse.getReadPointer(path);
+
+		dest.add(new HybridConvolver())->prepare(sampleRate, maxBlockSize, impulses, preparedImpulse.getNumSamples(), 2, 2, tailWorker, zeroLatency);
+		return;
+	}
+
+	for (int channel = 0; channel < 2; ++channel)
+	{
+		const int sourceChannel = jmin(channel, preparedImpulse.getNumChannels() - 1);
+		HybridConvolver* convolver = dest.add(new HybridConvolver());
+		convolver->prepare(sampleRate, maxBlockSize, preparedImpulse.getReadPointer(sourceChannel), preparedImpulse.getNumSamples(), tailWorker, zeroLatency);
+	}
+}
+
+AudioSampleBuffer ConvolutionReverb::createDefaultImpulseResponse(double inSampleRate, double rt60Seconds, int numChannels)
+{
+	const int numSamples = jmax(1, static_cast<int>(rt60Seconds * inSampleRate));
+	AudioSampleBuffer impulse(jmax(1, numChannels), numSamples);
+
+	// -60dB amplitude at rt60Seconds
+	const double decayPerSample = std::exp(-6.907755 / (rt60Seconds * inSampleRate));
+
+	for (int channel = 0; channel < impulse.getNumChannels(); ++channel)
+	{
+		Random rng(0x2eef + channel);
+		float* data = impulse.getWritePointer(channel);
+		double envelope = 1.0;
+
+		for (int i = 0; i < numSamples; ++i)
+		{
+			data[i] = static_cast<float>((rng.nextFloat() * 2.0f - 1.0f) * envelope);
+			envelope *= decayPerSample;
+		}
+	}
+
+	return impulse;
+}
+
+} // namespace Zen
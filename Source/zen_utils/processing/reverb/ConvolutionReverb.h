@@ -0,0 +1,120 @@
+/*==============================================================================
+//  ConvolutionReverb.h
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Stereo convolution reverb engine - impulse response management,
+//  latency-matched dry path and wet/dry mix around HybridConvolver
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#ifndef ZEN_CONVOLUTION_REVERB_H_INCLUDED
+#define ZEN_CONVOLUTION_REVERB_H_INCLUDED
+
+#include "JuceHeader.h"
+#include "HybridConvolver.h"
+#include "ConvolutionWorker.h"
+
+namespace Zen
+{
+
+/// <summary> Stereo convolution reverb.  All allocation happens in prepare() or when a new
+/// impulse response is set; the new convolvers are fully built off the audio thread and only
+/// swapped in while holding the processor's callback lock.  The large tail partitions of both
+/// channels share one ConvolutionWorker thread.
+///
+/// Mono and stereo impulses run one convolver per channel.  A four channel impulse is treated
+/// as true stereo (LL, LR, RL, RR) and runs a single 2 x 2 convolver, so each input is
+/// transformed once per block and shared by both outputs. </summary>
+class ConvolutionReverb
+{
+public:
+	ConvolutionReverb();
+	~ConvolutionReverb();
+
+	/// <summary> Partitions the current impulse response for the given rate and block size
+	/// and starts the worker thread if it is enabled. </summary>
+	void prepare(double inSampleRate, int inMaxBlockSize);
+
+	/// <summary> Stops the worker thread and frees every convolver and scratch buffer. </summary>
+	void release();
+
+	/// <summary> Clears all convolution history and the dry delay. </summary>
+	void reset() noexcept;
+
+	/// <summary> Replaces the impulse response.  Must NOT be called from the audio thread.
+	/// The new convolvers are built first, then swapped in while holding processLock. </summary>
+	/// <param name="newImpulse">        Mono, stereo or true stereo (4 channels: LL, LR, RL, RR) impulse response </param>
+	/// <param name="newImpulseRate">    Sample rate the impulse was recorded at, it is resampled if needed </param>
+	/// <param name="processLock">       Lock held by the host around processBlock (AudioProcessor::getCallbackLock()) </param>
+	void setImpulseResponse(const AudioSampleBuffer& newImpulse, double newImpulseRate, const CriticalSection& processLock);
+
+	/// <summary> Switches between FFT only (one block of latency) and a DirectFIR head plus FFT tail
+	/// (zero latency, more CPU).  Rebuilds the convolvers like setImpulseResponse() when prepared,
+	/// so must NOT be called from the audio thread. </summary>
+	void setZeroLatency(bool shouldBeZeroLatency, const CriticalSection& processLock);
+	bool isZeroLatency() const noexcept { return zeroLatency; }
+
+	/// <summary> Reads an audio file and uses it as the impulse response. </summary>
+	/// <returns> false if the file could not be read </returns>
+	bool loadImpulseResponse(const File& impulseFile, const CriticalSection& processLock);
+
+	/// <summary> Sets the normalized dry/wet mix, 0.0 -> dry only, 1.0 -> wet only </summary>
+	void setMix(float inMix) noexcept;
+
+	/// <summary> Processes a stereo block in place.  Both dry and wet are delayed by getLatencySamples(). </summary>
+	void processStereo(float* leftData, float* rightData, int numSamples) noexcept;
+
+	/// <summary> Chooses whether tail partitions run on the worker thread.  Takes effect at the next prepare(). </summary>
+	void setUseWorkerThread(bool shouldUseWorker) noexcept { useWorkerThread = shouldUseWorker; }
+
+	/// <summary> Audio thread only, call before every processStereo().  While non-realtime the tail worker
+	/// is waited for instead of late partitions being dropped, see NonUniformConvolver::setNonRealtime(). </summary>
+	void setNonRealtime(bool isNonRealtime) noexcept;
+
+	int getLatencySamples() const { return dryDelayLength; }
+	bool isTrueStereo() const noexcept { return convolvers.size() == 1; }
+	double getTailLengthSeconds() const;
+
+	/// <summary> Exposes a convolver's partition layout, schedule and timing.  There is one per channel,
+	/// or a single 2 x 2 one for true stereo.  May be nullptr before prepare(). </summary>
+	const HybridConvolver* getConvolver(int index) const { return convolvers[index]; }
+
+	/// <summary> Schedule and timing of every convolver, see NonUniformConvolver::getScheduleDescription() </summary>
+	String getScheduleDescription() const;
+
+	/// <summary> Builds decorrelated exponentially decaying noise impulses, stereo by default, used until a file is loaded.
+	/// Pass numChannels = 4 for a true stereo impulse. </summary>
+	static AudioSampleBuffer createDefaultImpulseResponse(double inSampleRate, double rt60Seconds, int numChannels = 2);
+
+private:
+	/// <summary> Resamples and normalizes the stored impulse for the current sample rate </summary>
+	AudioSampleBuffer createPreparedImpulse() const;
+	void buildConvolvers(OwnedArray<HybridConvolver>& dest, const AudioSampleBuffer& preparedImpulse);
+	void rebuildConvolvers(const CriticalSection& processLock);
+	void delayDryChannel(int channel, float* data, int numSamples) noexcept;
+
+	AudioSampleBuffer impulseResponse;	///< As loaded, before resampling
+	double impulseSampleRate = 48000.0;
+	int preparedImpulseLength = 0;
+
+	OwnedArray<HybridConvolver> convolvers;	///< One per output channel, or one 2 x 2 for true stereo
+	ConvolutionWorker worker;
+	bool useWorkerThread = true, zeroLatency = false;
+	AudioSampleBuffer wetBuffer, dryDelayBuffer;
+	int dryDelayPosition = 0, dryDelayLength = 0;	///< Dry delay matches the convolver latency, may be 0
+
+	double sampleRate = 44100.0;
+	int maxBlockSize = 0, partitionSize = 0;
+	float dryGain = 1.0f, wetGain = 0.0f;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ConvolutionReverb);
+};
+
+} // namespace Zen
+#endif // ZEN_CONVOLUTION_REVERB_H_INCLUDED
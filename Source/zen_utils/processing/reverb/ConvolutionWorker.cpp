@@ -0,0 +1,92 @@
+/*==============================================================================
+//  ConvolutionWorker.cpp
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Background thread computing the tail segments of NonUniformConvolvers
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#include "ConvolutionWorker.h"
+#include "NonUniformConvolver.h"
+
+namespace Zen
+{
+
+ConvolutionWorker::ConvolutionWorker()
+	: Thread("Convolution Worker")
+{
+}
+
+ConvolutionWorker::~ConvolutionWorker()
+{
+	stopThread(1000);
+}
+
+void ConvolutionWorker::addConvolver(NonUniformConvolver* convolver)
+{
+	const ScopedLock sl(convolverLock);
+	convolvers.addIfNotAlreadyThere(convolver);
+}
+
+void ConvolutionWorker::removeConvolver(NonUniformConvolver* convolver)
+{
+	const ScopedLock sl(convolverLock);
+	convolvers.removeFirstMatchingValue(convolver);
+}
+
+void ConvolutionWorker::removeAllConvolvers()
+{
+	const ScopedLock sl(convolverLock);
+	convolvers.clear();
+}
+
+void ConvolutionWorker::run()
+{
+	while (!threadShouldExit())
+	{
+		// Timeout is only a backstop, the audio thread notifies whenever it posts a block
+		wait(10);
+
+		while (!threadShouldExit() && runPass())
+		{
+		}
+	}
+}
+
+bool ConvolutionWorker::runPass()
+{
+	const ScopedLock sl(convolverLock);
+	bool didWork = false;
+
+	for (int segment = 1;; ++segment)
+	{
+		bool anyHasSegment = false;
+
+		for (int i = 0; i < convolvers.size(); ++i)
+		{
+			NonUniformConvolver* const convolver = convolvers.getUnchecked(i);
+
+			if (segment < convolver->getNumSegments())
+			{
+				anyHasSegment = true;
+
+				if (convolver->processPendingWork(segment))
+					didWork = true;
+			}
+		}
+
+		if (!anyHasSegment)
+			break;
+	}
+
+	numPasses += 1;
+	return didWork;
+}
+
+} // namespace Zen
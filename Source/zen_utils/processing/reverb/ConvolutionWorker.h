@@ -0,0 +1,60 @@
+/*==============================================================================
+//  ConvolutionWorker.h
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Background thread computing the tail segments of NonUniformConvolvers
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#ifndef ZEN_CONVOLUTION_WORKER_H_INCLUDED
+#define ZEN_CONVOLUTION_WORKER_H_INCLUDED
+
+#include "JuceHeader.h"
+
+namespace Zen
+{
+
+class NonUniformConvolver;
+
+/// <summary> Services the worker segments of any number of NonUniformConvolvers.
+/// The audio thread only ever calls notify().  Each pass walks the segments smallest partition
+/// first across every convolver (rate monotonic: the shortest period has the closest deadline),
+/// and passes repeat until no segment has pending blocks. </summary>
+class ConvolutionWorker : public Thread
+{
+public:
+	ConvolutionWorker();
+	~ConvolutionWorker();
+
+	/// <summary> Starts servicing a prepared convolver.  Message thread only. </summary>
+	void addConvolver(NonUniformConvolver* convolver);
+
+	/// <summary> Stops servicing a convolver, waiting for any block of it in progress.  Message thread only. </summary>
+	void removeConvolver(NonUniformConvolver* convolver);
+
+	void removeAllConvolvers();
+
+	void run() override;
+
+	/// <summary> Number of completed scheduling passes, for diagnostics </summary>
+	int getNumPasses() const { return numPasses.get(); }
+
+private:
+	/// <returns> true if any block was computed </returns>
+	bool runPass();
+
+	Array<NonUniformConvolver*> convolvers;
+	CriticalSection convolverLock;	///< Never taken by the audio thread
+	Atomic<int> numPasses;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ConvolutionWorker);
+};
+
+} // namespace Zen
+#endif // ZEN_CONVOLUTION_WORKER_H_INCLUDED
@@ -0,0 +1,153 @@
+/*==============================================================================
+//  DirectFIR.cpp
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Time-domain FIR filter with an aligned, unrolled SIMD kernel
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#include "DirectFIR.h"
+#include "../../utilities/ZenSIMD.hpp"
+
+namespace Zen
+{
+
+DirectFIR::DirectFIR()
+{
+	for (int p = 0; p < numPhases; ++p)
+		kernels[p] = nullptr;
+}
+
+DirectFIR::~DirectFIR()
+{
+	release();
+}
+
+void DirectFIR::prepare(const float* coefficients, int inNumTaps, int inMaxBlockSize)
+{
+	jassert(coefficients != nullptr && inNumTaps > 0 && inMaxBlockSize > 0);
+
+	release();
+
+	numTaps = inNumTaps;
+	maxBlockSize = inMaxBlockSize;
+
+	// Room for the longest phase shift, rounded up to whole unrolled iterations
+	kernelLength = ((numTaps + numPhases - 1 + tapGranularity - 1) / tapGranularity) * tapGranularity;
+	historyLength = kernelLength;
+
+	// +numPhases on each block leaves room to align the start to 16 bytes
+	kernelMemory.allocate(static_cast<size_t>(numPhases * kernelLength + numPhases), true);
+	historyMemory.allocate(static_cast<size_t>(historyLength + maxBlockSize + kernelLength + numPhases), true);
+
+	float* const kernelBase = getAligned16(kernelMemory);
+
+	for (int p = 0; p < numPhases; ++p)
+	{
+		kernels[p] = kernelBase + p * kernelLength;
+
+		for (int i = 0; i < numTaps; ++i)
+			kernels[p][p + i] = coefficients[numTaps - 1 - i];
+	}
+
+	history = getAligned16(historyMemory);
+}
+
+void DirectFIR::release()
+{
+	kernelMemory.free();
+	historyMemory.free();
+
+	for (int p = 0; p < numPhases; ++p)
+		kernels[p] = nullptr;
+
+	history = nullptr;
+	numTaps = kernelLength = historyLength = maxBlockSize = 0;
+}
+
+void DirectFIR::reset() noexcept
+{
+	if (history != nullptr)
+		FloatVectorOperations::clear(history, historyLength + maxBlockSize + kernelLength);
+}
+
+void DirectFIR::process(const float* input, float* output, int numSamples) noexcept
+{
+	if (!isPrepared())
+	{
+		if (input != output) FloatVectorOperations::copy(output, input, numSamples);
+		return;
+	}
+
+	while (numSamples > 0)
+	{
+		const int numToDo = jmin(numSamples, maxBlockSize);
+		processChunk(input, output, numToDo);
+
+		input += numToDo;
+		output += numToDo;
+		numSamples -= numToDo;
+	}
+}
+
+void DirectFIR::processChunk(const float* input, float* output, int numSamples) noexcept
+{
+	// Taking the input first makes in-place processing safe
+	FloatVectorOperations::copy(history + historyLength, input, numSamples);
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		// Window of the numTaps most recent samples, starting at 'start'.  Its misalignment
+		// picks the kernel copy that is shifted by the same amount.
+		const int start = historyLength + i - numTaps + 1;
+		const int phase = start & (numPhases - 1);
+		output[i] = dotProduct(kernels[phase], history + start - phase, kernelLength);
+	}
+
+	memmove(history, history + numSamples, sizeof(float) * static_cast<size_t>(historyLength));
+}
+
+float DirectFIR::dotProduct(const float* a, const float* b, int num) noexcept
+{
+	jassert(num % tapGranularity == 0);
+
+#if ZEN_USE_SSE_INTRINSICS
+	__m128 sum0 = _mm_setzero_ps();
+	__m128 sum1 = _mm_setzero_ps();
+	__m128 sum2 = _mm_setzero_ps();
+	__m128 sum3 = _mm_setzero_ps();
+
+	for (int i = 0; i < num; i += tapGranularity)
+	{
+		sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_load_ps(a + i), _mm_load_ps(b + i)));
+		sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_load_ps(a + i + 4), _mm_load_ps(b + i + 4)));
+		sum2 = _mm_add_ps(sum2, _mm_mul_ps(_mm_load_ps(a + i + 8), _mm_load_ps(b + i + 8)));
+		sum3 = _mm_add_ps(sum3, _mm_mul_ps(_mm_load_ps(a + i + 12), _mm_load_ps(b + i + 12)));
+	}
+
+	__m128 sum = _mm_add_ps(_mm_add_ps(sum0, sum1), _mm_add_ps(sum2, sum3));
+	sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+	sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+	return _mm_cvtss_f32(sum);
+#else
+	float sum0 = 0.0f, sum1 = 0.0f, sum2 = 0.0f, sum3 = 0.0f;
+
+	for (int i = 0; i < num; i += 4)
+	{
+		sum0 += a[i] * b[i];
+		sum1 += a[i + 1] * b[i + 1];
+		sum2 += a[i + 2] * b[i + 2];
+		sum3 += a[i + 3] * b[i + 3];
+	}
+
+	return (sum0 + sum1) + (sum2 + sum3);
+#endif
+}
+
+} // namespace Zen
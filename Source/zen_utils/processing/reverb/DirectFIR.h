@@ -0,0 +1,74 @@
+/*==============================================================================
+//  DirectFIR.h
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Time-domain FIR filter with an aligned, unrolled SIMD kernel
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#ifndef ZEN_DIRECT_FIR_H_INCLUDED
+#define ZEN_DIRECT_FIR_H_INCLUDED
+
+#include "JuceHeader.h"
+
+namespace Zen
+{
+
+/// <summary> Direct form FIR filter for short kernels (the head of an impulse response).
+///
+/// Every output sample is one dot product over a contiguous history buffer.  To keep all loads
+/// aligned the reversed kernel is stored four times, each copy shifted by one sample, so whatever
+/// the alignment of the current window there is a kernel copy whose first tap lines up with an
+/// aligned history address.  Kernels are zero padded to a multiple of 16 taps so the dot product
+/// runs four SIMD accumulators with no remainder loop. </summary>
+class DirectFIR
+{
+public:
+	enum
+	{
+		numPhases = 4,		///< Floats per SIMD register
+		tapGranularity = 16	///< Taps per unrolled loop iteration
+	};
+
+	DirectFIR();
+	~DirectFIR();
+
+	/// <summary> Copies the coefficients and allocates every buffer.  Never call this from the audio thread. </summary>
+	/// <param name="coefficients"> Impulse response taps, coefficients[0] applies to the newest sample </param>
+	/// <param name="inNumTaps">    Number of taps </param>
+	/// <param name="inMaxBlockSize"> Largest chunk process() handles in one pass, longer calls are split </param>
+	void prepare(const float* coefficients, int inNumTaps, int inMaxBlockSize);
+
+	void release();
+
+	/// <summary> Clears the input history. </summary>
+	void reset() noexcept;
+
+	/// <summary> Filters any number of samples.  Input and output may be the same buffer. </summary>
+	void process(const float* input, float* output, int numSamples) noexcept;
+
+	int getNumTaps() const { return numTaps; }
+	bool isPrepared() const { return numTaps > 0; }
+
+	/// <summary> Sum of a[i] * b[i].  Both pointers must be 16 byte aligned and num a multiple of tapGranularity. </summary>
+	static float dotProduct(const float* a, const float* b, int num) noexcept;
+
+private:
+	void processChunk(const float* input, float* output, int numSamples) noexcept;
+
+	HeapBlock<float> kernelMemory, historyMemory;
+	float* kernels[numPhases];		///< Reversed kernel, copy p delayed by p samples
+	float* history = nullptr;		///< historyLength past samples followed by the current chunk
+	int numTaps = 0, kernelLength = 0, historyLength = 0, maxBlockSize = 0;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DirectFIR);
+};
+
+} // namespace Zen
+#endif // ZEN_DIRECT_FIR_H_INCLUDED
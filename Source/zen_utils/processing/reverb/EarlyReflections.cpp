@@ -0,0 +1,266 @@
+/*==============================================================================
+//  EarlyReflections.cpp
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Sparse velvet-noise early reflections applied from a single
+//  circular input buffer
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#include "EarlyReflections.h"
+#include "../../utilities/ZenUtils.hpp"
+#include <cmath>
+
+namespace Zen
+{
+
+namespace
+{
+const float maxTapsPerSecond = 2000.0f;
+
+// Predelay and pattern length in seconds, interpolated by size
+const double minPredelay = 0.002, maxPredelay = 0.02;
+const double minPatternLength = 0.01, maxPatternLength = 0.08;
+
+const double envelopeEndDecibels = -20.0;	// Gain of the last tap relative to the first
+const double patternEnergy = 0.5;			// Summed squared tap gains per channel, independent of density
+const int64 tapSeeds[2] = { 0x7e1e7, 0x5a1ad };
+const double fadeSeconds = 0.02;			// Crossfade between the old and new tap tables
+}
+
+EarlyReflections::EarlyReflections()
+{
+}
+
+EarlyReflections::~EarlyReflections()
+{
+	release();
+}
+
+float EarlyReflections::convertDensityToTapsPerSecond(float normalizedDensity)
+{
+	// Linear so the CPU cost follows the parameter linearly too
+	return maxTapsPerSecond * getClamped(normalizedDensity, 0.0f, 1.0f);
+}
+
+void EarlyReflections::prepare(double inSampleRate)
+{
+	jassert(inSampleRate > 0);
+
+	sampleRate = inSampleRate;
+
+	const int maxPosition = static_cast<int>(std::ceil((maxPredelay + maxPatternLength) * sampleRate)) + 1;
+	bufferCapacity = nextPowerOfTwo(maxPosition + maxChunkSize);
+	bufferMask = bufferCapacity - 1;
+	maxTaps = static_cast<int>(std::ceil(maxTapsPerSecond * maxPatternLength)) + 1;
+	fadeLength = jmax(1, roundToInt(fadeSeconds * sampleRate));
+
+	inputMemory.allocate(static_cast<size_t>(bufferCapacity + maxChunkSize), true);
+	fadeMemory.allocate(static_cast<size_t>(2 * maxChunkSize), true);
+
+	for (int table = 0; table < 2; ++table)
+	{
+		for (int channel = 0; channel < 2; ++channel)
+		{
+			tapTables[table].positions[channel].allocate(static_cast<size_t>(maxTaps), true);
+			tapTables[table].gains[channel].allocate(static_cast<size_t>(maxTaps), true);
+		}
+
+		tapTables[table].numTaps = 0;
+	}
+
+	// Rebuild the table for the new rate straight away, there is nothing to fade from yet
+	const float lastSize = (size < 0.0f) ? 0.5f : size;
+	const float lastDensity = (density < 0.0f) ? 0.0f : density;
+	size = density = -1.0f;
+	setParameters(lastSize, lastDensity);
+
+	generateTaps(tapTables[currentTable]);
+	tapsOutOfDate = false;
+	fadePosition = fadeLength;
+
+	reset();
+}
+
+void EarlyReflections::release()
+{
+	inputMemory.free();
+	fadeMemory.free();
+
+	for (int table = 0; table < 2; ++table)
+	{
+		for (int channel = 0; channel < 2; ++channel)
+		{
+			tapTables[table].positions[channel].free();
+			tapTables[table].gains[channel].free();
+		}
+
+		tapTables[table].numTaps = 0;
+	}
+
+	bufferCapacity = bufferMask = writePosition = 0;
+	maxTaps = fadePosition = fadeLength = 0;
+}
+
+void EarlyReflections::reset() noexcept
+{
+	if (inputMemory == nullptr) return;
+
+	FloatVectorOperations::clear(inputMemory, bufferCapacity + maxChunkSize);
+	writePosition = 0;
+	historyStale = false;
+}
+
+void EarlyReflections::setParameters(float inSize, float inDensity) noexcept
+{
+	if (inSize == size && inDensity == density) return;
+
+	size = getClamped(inSize, 0.0f, 1.0f);
+	density = getClamped(inDensity, 0.0f, 1.0f);
+	tapsOutOfDate = true;
+}
+
+void EarlyReflections::generateTaps(TapTable& table) noexcept
+{
+	if (inputMemory == nullptr) return;
+
+	const double predelay = (minPredelay + (maxPredelay - minPredelay) * size) * sampleRate;
+	const double patternLength = (minPatternLength + (maxPatternLength - minPatternLength) * size) * sampleRate;
+
+	const int numTaps = jlimit(0, maxTaps, roundToInt(convertDensityToTapsPerSecond(density) * patternLength / sampleRate));
+	table.numTaps = numTaps;
+
+	if (numTaps == 0) return;
+
+	// One tap per segment: velvet noise keeps the taps evenly spread without ever colliding
+	const double segmentLength = patternLength / numTaps;
+	const int maxPosition = bufferCapacity - maxChunkSize;
+
+	for (int channel = 0; channel < 2; ++channel)
+	{
+		int* const positions = table.positions[channel];
+		float* const gains = table.gains[channel];
+		Random rng(tapSeeds[channel]);
+		double energy = 0.0;
+
+		for (int i = 0; i < numTaps; ++i)
+		{
+			const double position = predelay + (i + rng.nextDouble()) * segmentLength;
+			const double envelope = std::pow(10.0, envelopeEndDecibels / 20.0 * (i + 0.5) / numTaps);
+
+			positions[i] = jlimit(1, maxPosition, roundToInt(position));
+			gains[i] = static_cast<float>(rng.nextBool() ? envelope : -envelope);
+			energy += envelope * envelope;
+		}
+
+		FloatVectorOperations::multiply(gains, static_cast<float>(std::sqrt(patternEnergy / energy)), numTaps);
+	}
+}
+
+void EarlyReflections::startFade() noexcept
+{
+	// The seeds are fixed, so tap i keeps its relative position and sign and only moves with size and density
+	currentTable = 1 - currentTable;
+	generateTaps(tapTables[currentTable]);
+	tapsOutOfDate = false;
+	fadePosition = 0;
+}
+
+void EarlyReflections::process(const float* leftData, const float* rightData, float* earlyLeft, float* earlyRight, int numSamples) noexcept
+{
+	if (inputMemory == nullptr || (getNumTaps() == 0 && !isFading() && !tapsOutOfDate))
+	{
+		FloatVectorOperations::clear(earlyLeft, numSamples);
+		FloatVectorOperations::clear(earlyRight, numSamples);
+		historyStale = (inputMemory != nullptr);
+		return;
+	}
+
+	while (numSamples > 0)
+	{
+		const int chunkSize = jmin(numSamples, static_cast<int>(maxChunkSize));
+		processChunk(leftData, rightData, earlyLeft, earlyRight, chunkSize);
+
+		leftData += chunkSize;
+		rightData += chunkSize;
+		earlyLeft += chunkSize;
+		earlyRight += chunkSize;
+		numSamples -= chunkSize;
+	}
+}
+
+void EarlyReflections::processChunk(const float* leftData, const float* rightData, float* earlyLeft, float* earlyRight, int numSamples) noexcept
+{
+	// Whatever is in the buffer from before the reflections were switched off must not play out
+	if (historyStale)
+		reset();
+
+	if (tapsOutOfDate && !isFading())
+		startFade();
+
+	writeInput(leftData, rightData, numSamples);
+	applyTaps(tapTables[currentTable], earlyLeft, earlyRight, numSamples);
+
+	if (isFading())
+	{
+		float* const oldLeft = fadeMemory;
+		float* const oldRight = fadeMemory + maxChunkSize;
+		applyTaps(tapTables[1 - currentTable], oldLeft, oldRight, numSamples);
+
+		const float fadeStep = 1.0f / fadeLength;
+
+		for (int i = 0; i < numSamples; ++i)
+		{
+			const float newGain = jmin(1.0f, (fadePosition + i + 1) * fadeStep);
+			earlyLeft[i] = oldLeft[i] + (earlyLeft[i] - oldLeft[i]) * newGain;
+			earlyRight[i] = oldRight[i] + (earlyRight[i] - oldRight[i]) * newGain;
+		}
+
+		fadePosition = jmin(fadeLength, fadePosition + numSamples);
+	}
+
+	writePosition = (writePosition + numSamples) & bufferMask;
+}
+
+void EarlyReflections::applyTaps(const TapTable& table, float* earlyLeft, float* earlyRight, int numSamples) const noexcept
+{
+	FloatVectorOperations::clear(earlyLeft, numSamples);
+	FloatVectorOperations::clear(earlyRight, numSamples);
+
+	// Each tap is one contiguous multiply-add over the chunk, the mirror means no read ever wraps
+	const int* const leftPositions = table.positions[0];
+	const int* const rightPositions = table.positions[1];
+	const float* const leftGains = table.gains[0];
+	const float* const rightGains = table.gains[1];
+
+	for (int i = 0; i < table.numTaps; ++i)
+	{
+		FloatVectorOperations::addWithMultiply(earlyLeft, inputMemory + ((writePosition - leftPositions[i]) & bufferMask), leftGains[i], numSamples);
+		FloatVectorOperations::addWithMultiply(earlyRight, inputMemory + ((writePosition - rightPositions[i]) & bufferMask), rightGains[i], numSamples);
+	}
+}
+
+void EarlyReflections::writeInput(const float* leftData, const float* rightData, int numSamples) noexcept
+{
+	// The chunk is written contiguously, possibly running into the mirror, then the two copies are synced
+	float* const dest = inputMemory + writePosition;
+
+	FloatVectorOperations::copyWithMultiply(dest, leftData, 0.5f, numSamples);
+	FloatVectorOperations::addWithMultiply(dest, rightData, 0.5f, numSamples);
+
+	const int overflow = writePosition + numSamples - bufferCapacity;
+
+	if (overflow > 0)
+		FloatVectorOperations::copy(inputMemory, inputMemory + bufferCapacity, overflow);
+
+	if (writePosition < maxChunkSize)
+		FloatVectorOperations::copy(inputMemory + bufferCapacity + writePosition, dest, jmin(numSamples, maxChunkSize - writePosition));
+}
+
+} // namespace Zen
@@ -0,0 +1,107 @@
+/*==============================================================================
+//  EarlyReflections.h
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Sparse velvet-noise early reflections applied from a single
+//  circular input buffer
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#ifndef ZEN_EARLY_REFLECTIONS_H_INCLUDED
+#define ZEN_EARLY_REFLECTIONS_H_INCLUDED
+
+#include "JuceHeader.h"
+
+namespace Zen
+{
+
+/// <summary> Early reflections as a sparse FIR of velvet noise: one tap per grid segment at a random
+/// position inside the segment, with a random sign and an exponentially decaying gain.  Each channel has
+/// its own tap table so the two sides are decorrelated.
+///
+/// Tap tables are structure-of-arrays (positions, gains).  The mono input is written once per chunk to a
+/// single circular buffer whose first maxChunkSize samples are mirrored past its end, so every tap reads
+/// its whole chunk as one contiguous run and is applied as a single multiply-add over the chunk, with no
+/// per-sample gathers.  Cost is exactly proportional to the number of taps, i.e. to the density.
+///
+/// A new size or density moves every tap, so the new table is never swapped in directly: it is built
+/// into a second table and crossfaded in over fadeSeconds, during which both tables run. </summary>
+class EarlyReflections
+{
+public:
+	enum
+	{
+		maxChunkSize = 256
+	};
+
+	EarlyReflections();
+	~EarlyReflections();
+
+	/// <summary> Allocates the input buffer and tap tables for the highest density and size.
+	/// The only place this class allocates. </summary>
+	void prepare(double inSampleRate);
+
+	/// <summary> Frees all memory. </summary>
+	void release();
+
+	/// <summary> Clears the input history. </summary>
+	void reset() noexcept;
+
+	/// <summary> Sets the normalized (0.0 to 1.0) parameters.  A changed value builds a new tap table at the
+	/// next chunk, which never allocates, and crossfades to it.  Changes arriving during a crossfade are
+	/// picked up once it ends, so continuous automation steps through tables one fade at a time. </summary>
+	/// <param name="inSize">    Scales the predelay and the length of the reflection pattern </param>
+	/// <param name="inDensity"> Taps per second, 0.0 turns the reflections off entirely </param>
+	void setParameters(float inSize, float inDensity) noexcept;
+
+	/// <summary> Writes the reflections of the summed input into earlyLeft / earlyRight.  The
+	/// input and output pointers may not alias. </summary>
+	void process(const float* leftData, const float* rightData, float* earlyLeft, float* earlyRight, int numSamples) noexcept;
+
+	/// <summary> Taps per channel currently in use </summary>
+	int getNumTaps() const noexcept { return tapTables[currentTable].numTaps; }
+
+	/// <summary> Maps the normalized density parameter onto taps per second </summary>
+	static float convertDensityToTapsPerSecond(float normalizedDensity);
+
+private:
+	/// One channel pair of taps for one size and density
+	struct TapTable
+	{
+		HeapBlock<int> positions[2];	///< Samples behind the newest input, ascending
+		HeapBlock<float> gains[2];
+		int numTaps = 0;
+	};
+
+	void generateTaps(TapTable& table) noexcept;
+	void startFade() noexcept;
+	bool isFading() const noexcept { return fadePosition < fadeLength; }
+	void processChunk(const float* leftData, const float* rightData, float* earlyLeft, float* earlyRight, int numSamples) noexcept;
+	void applyTaps(const TapTable& table, float* earlyLeft, float* earlyRight, int numSamples) const noexcept;
+	void writeInput(const float* leftData, const float* rightData, int numSamples) noexcept;
+
+	HeapBlock<float> inputMemory;		///< bufferCapacity + maxChunkSize samples, head mirrored at the end
+	HeapBlock<float> fadeMemory;		///< Output of the outgoing table, maxChunkSize per channel
+	TapTable tapTables[2];
+	int currentTable = 0;
+
+	int bufferCapacity = 0, bufferMask = 0, writePosition = 0;
+	int maxTaps = 0;
+	int fadePosition = 0, fadeLength = 0;	///< Samples into the crossfade from the other table
+	bool tapsOutOfDate = false;		///< size or density changed since the current table was built
+	bool historyStale = false;		///< Input was skipped while there were no taps
+
+	float size = -1.0f, density = -1.0f;
+	double sampleRate = 44100.0;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EarlyReflections);
+};
+
+} // namespace Zen
+#endif // ZEN_EARLY_REFLECTIONS_H_INCLUDED
@@ -0,0 +1,357 @@
+/*==============================================================================
+//  FDNReverb.cpp
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Block-based Feedback Delay Network reverb (8 or 16 lines, Hadamard feedback)
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#include "FDNReverb.h"
+#include "../../utilities/ZenUtils.hpp"
+#include <cmath>
+
+namespace Zen
+{
+
+namespace
+{
+// Mutually prime delay lengths in samples at 48kHz and size 1.0 (roughly 30ms - 92ms)
+const int baseDelayLengths16[FDNReverb::maxNumLines] = {
+	1433, 1601, 1867, 2053, 2251, 2399, 2617, 2797,
+	3011, 3203, 3407, 3581, 3793, 4001, 4211, 4397 };
+
+const int baseDelayLengths8[8] = { 1433, 1867, 2251, 2617, 3011, 3407, 3793, 4211 };
+
+const double baseDelaySampleRate = 48000.0;
+const float minSizeScale = 0.25f;
+}
+
+FDNReverb::FDNReverb()
+{
+	for (int i = 0; i < maxNumLines; ++i)
+	{
+		lineData[i] = nullptr;
+		delayLengths[i] = 1;
+		feedbackGains[i] = 0.0f;
+	}
+}
+
+FDNReverb::~FDNReverb()
+{
+	release();
+}
+
+void FDNReverb::prepare(double inSampleRate, int inNumLines)
+{
+	jassert(inSampleRate > 0);
+	jassert(inNumLines == 8 || inNumLines == 16);
+
+	sampleRate = inSampleRate;
+	numLines = (inNumLines > 8) ? 16 : 8;
+
+	const int maxDelay = static_cast<int>(std::ceil(baseDelayLengths16[maxNumLines - 1] * sampleRate / baseDelaySampleRate));
+	lineCapacity = nextPowerOfTwo(maxDelay + maxChunkSize);
+	lineMask = lineCapacity - 1;
+	writePosition = 0;
+
+	delayMemory.allocate(static_cast<size_t>(numLines * lineCapacity), true);
+	dampingFilters.prepare(numLines);
+	decayBands.prepare(sampleRate, numLines, maxChunkSize);
+	scratchMemory.allocate(static_cast<size_t>((maxNumLines + 3) * maxChunkSize), true);
+
+	for (int i = 0; i < maxNumLines; ++i)
+		lineData[i] = scratchMemory + i * maxChunkSize;
+
+	butterflyTemp = scratchMemory + maxNumLines * maxChunkSize;
+	wetLeft = butterflyTemp + maxChunkSize;
+	wetRight = wetLeft + maxChunkSize;
+
+	inputGain = 1.0f / std::sqrt(numLines * 0.5f);
+	outputGain = inputGain;
+
+	// Force every coefficient to be recalculated for the new rate / line count
+	const float lastSize = (size < 0.0f) ? 0.5f : size;
+	const float lastDecay = (decay < 0.0f) ? 0.5f : decay;
+	const float lastDamping = (damping < 0.0f) ? 0.5f : damping;
+	const float lastMix = (mix < 0.0f) ? 0.0f : mix;
+	size = decay = damping = mix = -1.0f;
+	setParameters(lastSize, lastDecay, lastDamping, lastMix);
+
+	const float lastLowDecay = (lowDecay < 0.0f) ? 0.5f : lowDecay;
+	const float lastHighDecay = (highDecay < 0.0f) ? 0.5f : highDecay;
+	const float lastLowCrossover = (lowCrossover < 0.0f) ? 0.5f : lowCrossover;
+	const float lastHighCrossover = (highCrossover < 0.0f) ? 0.5f : highCrossover;
+	lowDecay = highDecay = lowCrossover = highCrossover = -1.0f;
+	setDecayBands(lastLowDecay, lastHighDecay, lastLowCrossover, lastHighCrossover);
+
+	reset();
+}
+
+void FDNReverb::release()
+{
+	delayMemory.free();
+	scratchMemory.free();
+	dampingFilters.release();
+	decayBands.release();
+
+	for (int i = 0; i < maxNumLines; ++i)
+		lineData[i] = nullptr;
+
+	butterflyTemp = wetLeft = wetRight = nullptr;
+	lineCapacity = lineMask = 0;
+}
+
+void FDNReverb::reset() noexcept
+{
+	if (delayMemory == nullptr) return;
+
+	FloatVectorOperations::clear(delayMemory, numLines * lineCapacity);
+	dampingFilters.reset();
+	decayBands.reset();
+
+	writePosition = 0;
+}
+
+float FDNReverb::convertDecayToRT60(float normalizedDecay)
+{
+	return 0.2f * std::pow(100.0f, getClamped(normalizedDecay, 0.0f, 1.0f));
+}
+
+void FDNReverb::setParameters(float inSize, float inDecay, float inDamping, float inMix) noexcept
+{
+	bool lengthsChanged = false, gainsChanged = false, dampingChanged = false;
+
+	if (inSize != size)
+	{
+		size = getClamped(inSize, 0.0f, 1.0f);
+		lengthsChanged = true;
+	}
+
+	if (inDecay != decay)
+	{
+		decay = getClamped(inDecay, 0.0f, 1.0f);
+		rt60 = convertDecayToRT60(decay);
+		gainsChanged = true;
+	}
+
+	if (inDamping != damping)
+	{
+		damping = getClamped(inDamping, 0.0f, 1.0f);
+		dampingCoeff = damping * 0.9f;
+		dampingChanged = true;
+	}
+
+	if (inMix != mix)
+	{
+		mix = getClamped(inMix, 0.0f, 1.0f);
+		dryGain = 1.0f - mix;
+		wetGain = mix;
+	}
+
+	if (lengthsChanged)
+		updateDelayLengths();	// also updates the gains, since they depend on the lengths
+	else if (gainsChanged)
+		updateFeedbackGains();	// also updates the filters, which carry the gains
+	else if (dampingChanged)
+		updateDampingFilters();
+}
+
+void FDNReverb::setDecayBands(float inLowDecay, float inHighDecay, float inLowCrossover, float inHighCrossover) noexcept
+{
+	bool ratiosChanged = false, crossoversChanged = false;
+
+	if (inLowDecay != lowDecay)
+	{
+		lowDecay = getClamped(inLowDecay, 0.0f, 1.0f);
+		lowDecayRatio = MultibandDecayFilter::convertBandDecayToRatio(lowDecay);
+		ratiosChanged = true;
+	}
+
+	if (inHighDecay != highDecay)
+	{
+		highDecay = getClamped(inHighDecay, 0.0f, 1.0f);
+		highDecayRatio = MultibandDecayFilter::convertBandDecayToRatio(highDecay);
+		ratiosChanged = true;
+	}
+
+	if (inLowCrossover != lowCrossover || inHighCrossover != highCrossover)
+	{
+		lowCrossover = getClamped(inLowCrossover, 0.0f, 1.0f);
+		highCrossover = getClamped(inHighCrossover, 0.0f, 1.0f);
+		crossoversChanged = true;
+	}
+
+	if (crossoversChanged)
+		decayBands.setCrossovers(MultibandDecayFilter::convertLowCrossoverToHz(lowCrossover),
+								 MultibandDecayFilter::convertHighCrossoverToHz(highCrossover));
+
+	if (ratiosChanged)
+	{
+		const bool wasMultiband = multibandDecay;
+		multibandDecay = (lowDecayRatio != 1.0f || highDecayRatio != 1.0f);
+
+		// Don't resume from whatever the crossover held the last time it ran
+		if (multibandDecay && !wasMultiband)
+			decayBands.reset();
+
+		updateFeedbackGains();
+	}
+}
+
+void FDNReverb::updateDelayLengths() noexcept
+{
+	const int* baseLengths = (numLines == maxNumLines) ? baseDelayLengths16 : baseDelayLengths8;
+	const double scale = (minSizeScale + (1.0f - minSizeScale) * size) * sampleRate / baseDelaySampleRate;
+	const int maxLength = jmax(1, lineCapacity - maxChunkSize);
+
+	minDelayLength = maxLength;
+
+	for (int i = 0; i < numLines; ++i)
+	{
+		delayLengths[i] = jlimit(1, maxLength, roundToInt(baseLengths[i] * scale));
+		minDelayLength = jmin(minDelayLength, delayLengths[i]);
+	}
+
+	updateFeedbackGains();
+}
+
+void FDNReverb::updateFeedbackGains() noexcept
+{
+	// The Hadamard butterflies are unnormalized, so fold 1/sqrt(N) into the per-line gain
+	const double hadamardNormalization = 1.0 / std::sqrt(static_cast<double>(numLines));
+
+	for (int i = 0; i < numLines; ++i)
+	{
+		const double lineGain = std::pow(10.0, -3.0 * delayLengths[i] / (rt60 * sampleRate));
+		feedbackGains[i] = static_cast<float>(lineGain * hadamardNormalization);
+
+		// Band gains follow the same formula, with each band's own RT60
+		if (multibandDecay && decayBands.getNumLines() == numLines)
+		{
+			const double lowGain = std::pow(10.0, -3.0 * delayLengths[i] / (rt60 * lowDecayRatio * sampleRate));
+			const double highGain = std::pow(10.0, -3.0 * delayLengths[i] / (rt60 * highDecayRatio * sampleRate));
+
+			decayBands.setBandGains(i, static_cast<float>(lowGain * hadamardNormalization), feedbackGains[i],
+									static_cast<float>(highGain * hadamardNormalization));
+		}
+	}
+
+	updateDampingFilters();
+}
+
+void FDNReverb::updateDampingFilters() noexcept
+{
+	if (dampingFilters.getNumFilters() != numLines) return;
+
+	// With multiband decay the band gains carry the RT60 instead
+	for (int i = 0; i < numLines; ++i)
+		dampingFilters.setCoefficients(i, BiquadCoefficients::makeOnePoleLowPass(dampingCoeff, multibandDecay ? 1.0f : feedbackGains[i]));
+}
+
+void FDNReverb::processStereo(float* leftData, float* rightData, int numSamples) noexcept
+{
+	if (delayMemory == nullptr || numSamples <= 0) return;
+
+	// Every delay line must be at least one chunk long so a chunk can be read before it is written
+	const int chunkLimit = jmin(static_cast<int>(maxChunkSize), minDelayLength);
+
+	while (numSamples > 0)
+	{
+		const int chunkSize = jmin(numSamples, chunkLimit);
+		processChunk(leftData, rightData, chunkSize);
+
+		leftData += chunkSize;
+		rightData += chunkSize;
+		numSamples -= chunkSize;
+	}
+}
+
+void FDNReverb::processChunk(float* leftData, float* rightData, int numSamples) noexcept
+{
+	FloatVectorOperations::clear(wetLeft, numSamples);
+	FloatVectorOperations::clear(wetRight, numSamples);
+
+	for (int i = 0; i < numLines; ++i)
+	{
+		float* const line = lineData[i];
+		readLine(i, line, numSamples);
+
+		// Output taps come straight off the delay lines, alternating sign every pair of lines
+		const float tapGain = ((i >> 1) & 1) ? -outputGain : outputGain;
+		FloatVectorOperations::addWithMultiply((i & 1) ? wetRight : wetLeft, line, tapGain, numSamples);
+	}
+
+	// One-pole lowpass damping plus the RT60 line gain, four lines per SIMD lane group
+	dampingFilters.process(lineData, numSamples);
+
+	if (multibandDecay)
+		decayBands.process(lineData, numSamples);
+
+	applyHadamard(numSamples);
+
+	for (int i = 0; i < numLines; ++i)
+	{
+		const float injectGain = ((i >> 1) & 1) ? -inputGain : inputGain;
+		FloatVectorOperations::addWithMultiply(lineData[i], (i & 1) ? rightData : leftData, injectGain, numSamples);
+		writeLine(i, lineData[i], numSamples);
+	}
+
+	writePosition = (writePosition + numSamples) & lineMask;
+
+	FloatVectorOperations::multiply(leftData, dryGain, numSamples);
+	FloatVectorOperations::multiply(rightData, dryGain, numSamples);
+	FloatVectorOperations::addWithMultiply(leftData, wetLeft, wetGain, numSamples);
+	FloatVectorOperations::addWithMultiply(rightData, wetRight, wetGain, numSamples);
+}
+
+void FDNReverb::applyHadamard(int numSamples) noexcept
+{
+	for (int half = 1; half < numLines; half <<= 1)
+	{
+		for (int first = 0; first < numLines; first += (half << 1))
+		{
+			for (int j = first; j < first + half; ++j)
+			{
+				float* const a = lineData[j];
+				float* const b = lineData[j + half];
+
+				// temp = a - b, a = a + b, then swap temp into b's slot rather than copying
+				FloatVectorOperations::subtract(butterflyTemp, a, b, numSamples);
+				FloatVectorOperations::add(a, b, numSamples);
+				lineData[j + half] = butterflyTemp;
+				butterflyTemp = b;
+			}
+		}
+	}
+}
+
+void FDNReverb::readLine(int lineIndex, float* dest, int numSamples) const noexcept
+{
+	const float* const line = delayMemory + lineIndex * lineCapacity;
+	const int readPosition = (writePosition - delayLengths[lineIndex]) & lineMask;
+	const int firstPart = jmin(numSamples, lineCapacity - readPosition);
+
+	FloatVectorOperations::copy(dest, line + readPosition, firstPart);
+
+	if (firstPart < numSamples)
+		FloatVectorOperations::copy(dest + firstPart, line, numSamples - firstPart);
+}
+
+void FDNReverb::writeLine(int lineIndex, const float* src, int numSamples) noexcept
+{
+	float* const line = delayMemory + lineIndex * lineCapacity;
+	const int firstPart = jmin(numSamples, lineCapacity - writePosition);
+
+	FloatVectorOperations::copy(line + writePosition, src, firstPart);
+
+	if (firstPart < numSamples)
+		FloatVectorOperations::copy(line, src + firstPart, numSamples - firstPart);
+}
+
+} // namespace Zen
@@ -0,0 +1,122 @@
+/*==============================================================================
+//  FDNReverb.h
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Block-based Feedback Delay Network reverb (8 or 16 lines, Hadamard feedback)
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#ifndef ZEN_FDN_REVERB_H_INCLUDED
+#define ZEN_FDN_REVERB_H_INCLUDED
+
+#include "JuceHeader.h"
+#include "../ZenDSPFilters.h"
+#include "MultibandDecayFilter.h"
+
+namespace Zen
+{
+
+/// <summary> Feedback delay network reverb that processes whole blocks at a time.
+/// Every delay line lives in one contiguous allocation made in prepare(), and the
+/// Hadamard feedback matrix is applied as log2(N) stages of vectorised butterflies
+/// across each chunk of samples rather than once per sample. </summary>
+class FDNReverb
+{
+public:
+	enum
+	{
+		maxNumLines = 16,
+		maxChunkSize = 256	///< Internal sub-block size; also bounded by the shortest delay line
+	};
+
+	FDNReverb();
+	~FDNReverb();
+
+	/// <summary> Allocates all delay and scratch memory.  Must be called before processing,
+	/// and is the only place this class allocates. </summary>
+	/// <param name="inSampleRate"> The current sample rate. </param>
+	/// <param name="inNumLines">   Number of delay lines, 8 or 16. </param>
+	void prepare(double inSampleRate, int inNumLines = 8);
+
+	/// <summary> Frees all delay memory. </summary>
+	void release();
+
+	/// <summary> Clears the delay lines and filter states without reallocating. </summary>
+	void reset() noexcept;
+
+	/// <summary> Sets the normalized (0.0 to 1.0) engine parameters.  Cheap to call every block,
+	/// coefficients are only recomputed when a value actually changes. </summary>
+	/// <param name="inSize">    Room size, scales every delay length </param>
+	/// <param name="inDecay">   Decay time, maps exponentially to an RT60 of 0.2s - 20s </param>
+	/// <param name="inDamping"> High frequency damping inside the feedback loop </param>
+	/// <param name="inMix">     Dry/Wet mix, 0.0 -> dry only, 1.0 -> wet only </param>
+	void setParameters(float inSize, float inDecay, float inDamping, float inMix) noexcept;
+
+	/// <summary> Sets the normalized (0.0 to 1.0) three band decay parameters.  The low and high band RT60s
+	/// are multiples of the decay set by setParameters(), 0.5 -> the same decay.  While both are 0.5 the
+	/// crossover is bypassed entirely.  Like setParameters(), work is only done for values that changed. </summary>
+	/// <param name="inLowDecay">      Low band RT60 multiplier, see MultibandDecayFilter::convertBandDecayToRatio() </param>
+	/// <param name="inHighDecay">     High band RT60 multiplier </param>
+	/// <param name="inLowCrossover">  Low / mid crossover frequency </param>
+	/// <param name="inHighCrossover"> Mid / high crossover frequency </param>
+	void setDecayBands(float inLowDecay, float inHighDecay, float inLowCrossover, float inHighCrossover) noexcept;
+
+	/// <summary> Processes a stereo block in place. </summary>
+	void processStereo(float* leftData, float* rightData, int numSamples) noexcept;
+
+	/// <summary> Returns the longest band RT60 in seconds </summary>
+	double getTailLengthSeconds() const { return rt60 * jmax(1.0f, lowDecayRatio, highDecayRatio); }
+
+	int getNumLines() const { return numLines; }
+
+	/// <summary> Maps the normalized decay parameter onto an RT60 in seconds </summary>
+	static float convertDecayToRT60(float normalizedDecay);
+
+private:
+	void updateDelayLengths() noexcept;
+	void updateFeedbackGains() noexcept;
+	void updateDampingFilters() noexcept;
+	void processChunk(float* leftData, float* rightData, int numSamples) noexcept;
+
+	void readLine(int lineIndex, float* dest, int numSamples) const noexcept;
+	void writeLine(int lineIndex, const float* src, int numSamples) noexcept;
+
+	/// <summary> Applies an unnormalized Hadamard transform in place across numLines channels.
+	/// Each butterfly is a vector add/subtract over the whole chunk. </summary>
+	void applyHadamard(int numSamples) noexcept;
+
+	HeapBlock<float> delayMemory;	///< numLines * lineCapacity samples, one contiguous block
+	HeapBlock<float> scratchMemory; ///< Chunk buffers: one per line plus butterfly temp and two wet outputs
+	float* lineData[maxNumLines];
+	float* butterflyTemp = nullptr;
+	float* wetLeft = nullptr;
+	float* wetRight = nullptr;
+
+	int numLines = 8;
+	int lineCapacity = 0, lineMask = 0, writePosition = 0;
+	int delayLengths[maxNumLines];
+	int minDelayLength = 1;
+
+	float feedbackGains[maxNumLines];
+	BiquadBank dampingFilters;	///< Per-line damping lowpass, with the line's RT60 gain folded in unless multiband
+	MultibandDecayFilter decayBands;
+	bool multibandDecay = false;
+	float dampingCoeff = 0.0f, inputGain = 1.0f, outputGain = 1.0f;
+	float dryGain = 1.0f, wetGain = 0.0f;
+
+	float size = -1.0f, decay = -1.0f, damping = -1.0f, mix = -1.0f;
+	float lowDecay = -1.0f, highDecay = -1.0f, lowCrossover = -1.0f, highCrossover = -1.0f;
+	float lowDecayRatio = 1.0f, highDecayRatio = 1.0f;
+	double sampleRate = 44100.0, rt60 = 0.0;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FDNReverb);
+};
+
+} // namespace Zen
+#endif // ZEN_FDN_REVERB_H_INCLUDED
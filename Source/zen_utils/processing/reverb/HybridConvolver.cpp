@@ -0,0 +1,146 @@
+/*==============================================================================
+//  HybridConvolver.cpp
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Zero-latency convolution - DirectFIR head plus partitioned FFT tail
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#include "HybridConvolver.h"
+
+namespace Zen
+{
+
+HybridConvolver::HybridConvolver()
+{
+}
+
+HybridConvolver::~HybridConvolver()
+{
+	release();
+}
+
+void HybridConvolver::prepare(double inSampleRate, int inMaxBlockSize, const float* impulseResponse, int impulseLength, ConvolutionWorker* worker,
+	bool shouldBeZeroLatency, int directHeadLength)
+{
+	prepare(inSampleRate, inMaxBlockSize, &impulseResponse, impulseLength, 1, 1, worker, shouldBeZeroLatency, directHeadLength);
+}
+
+void HybridConvolver::prepare(double inSampleRate, int inMaxBlockSize, const float* const* impulseResponses, int impulseLength, int inNumInputs, int inNumOutputs,
+	ConvolutionWorker* worker, bool shouldBeZeroLatency, int directHeadLength)
+{
+	jassert(inMaxBlockSize > 0 && impulseResponses != nullptr && impulseLength > 0);
+	jassert(inNumInputs > 0 && inNumInputs <= maxChannels && inNumOutputs > 0 && inNumOutputs <= maxChannels);
+
+	release();
+
+	maxBlockSize = inMaxBlockSize;
+	numInputs = inNumInputs;
+	numOutputs = inNumOutputs;
+	zeroLatency = shouldBeZeroLatency;
+
+	if (!zeroLatency)
+	{
+		tail.prepare(inSampleRate, nextPowerOfTwo(maxBlockSize), impulseResponses, impulseLength, numInputs, numOutputs, worker);
+		hasTail = true;
+		return;
+	}
+
+	// The tail's head partition must equal the taps it skips, so the FIR length is a power of two too
+	const int headLength = nextPowerOfTwo(jmax(1, directHeadLength));
+	const int numPaths = numInputs * numOutputs;
+
+	for (int path = 0; path < numPaths; ++path)
+		heads.add(new DirectFIR())->prepare(impulseResponses[path], jmin(headLength, impulseLength), maxBlockSize);
+
+	mixBuffers.allocate(static_cast<size_t>(numOutputs * maxBlockSize), true);
+	firBuffer.allocate(static_cast<size_t>(maxBlockSize), true);
+
+	hasTail = impulseLength > headLength;
+
+	if (hasTail)
+	{
+		const float* tailImpulses[maxChannels * maxChannels];
+
+		for (int path = 0; path < numPaths; ++path)
+			tailImpulses[path] = impulseResponses[path] + headLength;
+
+		tail.prepare(inSampleRate, headLength, tailImpulses, impulseLength - headLength, numInputs, numOutputs, worker);
+	}
+}
+
+void HybridConvolver::release()
+{
+	heads.clear();
+	tail.release();
+	mixBuffers.free();
+	firBuffer.free();
+	maxBlockSize = numInputs = numOutputs = 0;
+	hasTail = false;
+}
+
+void HybridConvolver::reset() noexcept
+{
+	for (int path = 0; path < heads.size(); ++path)
+		heads.getUnchecked(path)->reset();
+
+	tail.reset();
+}
+
+void HybridConvolver::process(const float* input, float* output, int numSamples) noexcept
+{
+	jassert(numInputs <= 1 && numOutputs <= 1);
+	process(&input, &output, numSamples);
+}
+
+void HybridConvolver::process(const float* const* inputs, float* const* outputs, int numSamples) noexcept
+{
+	if (!zeroLatency || heads.size() == 0)
+	{
+		tail.process(inputs, outputs, numSamples);
+		return;
+	}
+
+	int position = 0;
+
+	while (position < numSamples)
+	{
+		const int numToDo = jmin(numSamples - position, maxBlockSize);
+		const float* chunkInputs[maxChannels];
+		float* mixes[maxChannels];
+
+		for (int input = 0; input < numInputs; ++input)
+			chunkInputs[input] = inputs[input] + position;
+
+		for (int output = 0; output < numOutputs; ++output)
+			mixes[output] = mixBuffers + output * maxBlockSize;
+
+		if (hasTail)
+			tail.process(chunkInputs, mixes, numToDo);
+		else
+			FloatVectorOperations::clear(mixBuffers, numOutputs * maxBlockSize);
+
+		// Every path is mixed in scratch before any output is written, so in-place is fine
+		for (int input = 0; input < numInputs; ++input)
+		{
+			for (int output = 0; output < numOutputs; ++output)
+			{
+				heads.getUnchecked(input * numOutputs + output)->process(chunkInputs[input], firBuffer, numToDo);
+				FloatVectorOperations::add(mixes[output], firBuffer, numToDo);
+			}
+		}
+
+		for (int output = 0; output < numOutputs; ++output)
+			FloatVectorOperations::copy(outputs[output] + position, mixes[output], numToDo);
+
+		position += numToDo;
+	}
+}
+
+} // namespace Zen
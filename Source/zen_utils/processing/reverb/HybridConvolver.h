@@ -0,0 +1,98 @@
+/*==============================================================================
+//  HybridConvolver.h
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Zero-latency convolution - DirectFIR head plus partitioned FFT tail
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#ifndef ZEN_HYBRID_CONVOLVER_H_INCLUDED
+#define ZEN_HYBRID_CONVOLVER_H_INCLUDED
+
+#include "JuceHeader.h"
+#include "DirectFIR.h"
+#include "NonUniformConvolver.h"
+
+namespace Zen
+{
+
+/// <summary> Convolver that can run with zero latency, mono or multichannel (see PartitionedConvolver).
+///
+/// In zero latency mode the first directHeadLength taps are filtered in the time domain by a
+/// DirectFIR, and the rest of the impulse goes through a NonUniformConvolver whose head partition
+/// is directHeadLength long.  That convolver's one partition of latency is exactly the length of
+/// the taps it skips, so the two outputs line up with no delay.
+///
+/// With zero latency off the whole impulse goes through the NonUniformConvolver with the given
+/// partition size, and the output is delayed by that partition.
+///
+/// Multichannel convolvers keep one DirectFIR per input/output path for the head, while the tail
+/// shares each input's spectra between outputs. </summary>
+class HybridConvolver
+{
+public:
+	enum
+	{
+		defaultDirectHeadLength = 64,
+		maxChannels = NonUniformConvolver::maxChannels
+	};
+
+	HybridConvolver();
+	~HybridConvolver();
+
+	/// <summary> Builds the FIR head (if enabled) and the FFT tail.  Never call this from the audio thread. </summary>
+	/// <param name="inSampleRate">      Passed to the tail for timing </param>
+	/// <param name="inMaxBlockSize">    Largest host block </param>
+	/// <param name="impulseResponse">   Impulse response samples (copied) </param>
+	/// <param name="impulseLength">     Number of impulse response samples </param>
+	/// <param name="worker">            Worker thread for the tail, or nullptr for inline </param>
+	/// <param name="shouldBeZeroLatency"> true for FIR head plus tail, false for FFT only </param>
+	/// <param name="directHeadLength">  FIR taps in zero latency mode, rounded up to a power of two </param>
+	void prepare(double inSampleRate, int inMaxBlockSize, const float* impulseResponse, int impulseLength, ConvolutionWorker* worker,
+		bool shouldBeZeroLatency, int directHeadLength = defaultDirectHeadLength);
+
+	/// <summary> Multichannel prepare().  impulseResponses holds inNumInputs * inNumOutputs impulses, the path
+	/// from input i to output o at index i * inNumOutputs + o, all impulseLength long. </summary>
+	void prepare(double inSampleRate, int inMaxBlockSize, const float* const* impulseResponses, int impulseLength, int inNumInputs, int inNumOutputs,
+		ConvolutionWorker* worker, bool shouldBeZeroLatency, int directHeadLength = defaultDirectHeadLength);
+
+	/// <summary> Frees everything.  The tail must already be removed from its worker. </summary>
+	void release();
+
+	void reset() noexcept;
+
+	/// <summary> Convolves any number of samples.  Input and output may be the same buffer. </summary>
+	void process(const float* input, float* output, int numSamples) noexcept;
+
+	/// <summary> Multichannel process().  Outputs may be the same buffers as the inputs. </summary>
+	void process(const float* const* inputs, float* const* outputs, int numSamples) noexcept;
+
+	int getLatencySamples() const { return zeroLatency ? 0 : tail.getLatencySamples(); }
+	bool isZeroLatency() const { return zeroLatency; }
+	int getDirectHeadLength() const { return heads.size() > 0 ? heads.getUnchecked(0)->getNumTaps() : 0; }
+	int getNumInputs() const { return numInputs; }
+	int getNumOutputs() const { return numOutputs; }
+
+	/// <summary> The FFT part, for its partition layout, schedule and timing </summary>
+	NonUniformConvolver& getTailConvolver() { return tail; }
+	const NonUniformConvolver& getTailConvolver() const { return tail; }
+
+private:
+	OwnedArray<DirectFIR> heads;	///< One per input/output path, same indexing as the impulses
+	NonUniformConvolver tail;
+	HeapBlock<float> mixBuffers;	///< numOutputs * maxBlockSize, tail output plus the FIR paths
+	HeapBlock<float> firBuffer;		///< maxBlockSize, one FIR path at a time
+	int maxBlockSize = 0, numInputs = 0, numOutputs = 0;
+	bool zeroLatency = false, hasTail = false;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HybridConvolver);
+};
+
+} // namespace Zen
+#endif // ZEN_HYBRID_CONVOLVER_H_INCLUDED
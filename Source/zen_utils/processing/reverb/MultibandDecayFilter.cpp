@@ -0,0 +1,199 @@
+/*==============================================================================
+//  MultibandDecayFilter.cpp
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Three band Linkwitz-Riley split with per-line band gains, for
+//  frequency dependent decay inside a delay network's feedback loop
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#include "MultibandDecayFilter.h"
+#include "../../utilities/ZenUtils.hpp"
+#include <cmath>
+
+namespace Zen
+{
+
+namespace
+{
+const float minBandRatio = 0.25f, maxBandRatio = 4.0f;
+const float minLowCrossover = 100.0f, maxLowCrossover = 1000.0f;
+const float minHighCrossover = 1000.0f, maxHighCrossover = 12000.0f;
+const double butterworthQ = 0.7071067811865476;	// Two in series make one Linkwitz-Riley half
+
+float mapExponentially(float normalizedValue, float minValue, float maxValue)
+{
+	return minValue * std::pow(maxValue / minValue, getClamped(normalizedValue, 0.0f, 1.0f));
+}
+}
+
+MultibandDecayFilter::MultibandDecayFilter()
+{
+	for (int i = 0; i < maxNumLines; ++i)
+	{
+		lowBands[i] = highBands[i] = nullptr;
+
+		for (int band = 0; band < numBands; ++band)
+			bandGains[band][i] = 1.0f;
+	}
+}
+
+MultibandDecayFilter::~MultibandDecayFilter()
+{
+	release();
+}
+
+float MultibandDecayFilter::convertBandDecayToRatio(float normalizedDecay)
+{
+	return mapExponentially(normalizedDecay, minBandRatio, maxBandRatio);
+}
+
+float MultibandDecayFilter::convertLowCrossoverToHz(float normalizedFrequency)
+{
+	return mapExponentially(normalizedFrequency, minLowCrossover, maxLowCrossover);
+}
+
+float MultibandDecayFilter::convertHighCrossoverToHz(float normalizedFrequency)
+{
+	return mapExponentially(normalizedFrequency, minHighCrossover, maxHighCrossover);
+}
+
+void MultibandDecayFilter::prepare(double inSampleRate, int inNumLines, int inMaxBlockSize)
+{
+	jassert(inSampleRate > 0);
+	jassert(inNumLines > 0 && inNumLines <= maxNumLines);
+
+	sampleRate = inSampleRate;
+	numLines = jlimit(1, static_cast<int>(maxNumLines), inNumLines);
+	maxBlockSize = jmax(1, inMaxBlockSize);
+
+	bandMemory.allocate(static_cast<size_t>(2 * numLines * maxBlockSize), true);
+
+	for (int i = 0; i < numLines; ++i)
+	{
+		lowBands[i] = bandMemory + i * maxBlockSize;
+		highBands[i] = bandMemory + (numLines + i) * maxBlockSize;
+	}
+
+	splitStage1.prepare(2 * numLines);
+	splitStage2.prepare(2 * numLines);
+	splitStage3.prepare(3 * numLines);
+	splitStage4.prepare(2 * numLines);
+
+	setCrossovers(convertLowCrossoverToHz(0.5f), convertHighCrossoverToHz(0.5f));
+}
+
+void MultibandDecayFilter::release()
+{
+	bandMemory.free();
+	splitStage1.release();
+	splitStage2.release();
+	splitStage3.release();
+	splitStage4.release();
+
+	for (int i = 0; i < maxNumLines; ++i)
+		lowBands[i] = highBands[i] = nullptr;
+
+	numLines = maxBlockSize = 0;
+}
+
+void MultibandDecayFilter::reset() noexcept
+{
+	splitStage1.reset();
+	splitStage2.reset();
+	splitStage3.reset();
+	splitStage4.reset();
+}
+
+void MultibandDecayFilter::setCrossovers(double lowFrequency, double highFrequency) noexcept
+{
+	if (numLines == 0) return;
+
+	highFrequency = jmax(highFrequency, lowFrequency * 1.5);
+
+	const BiquadCoefficients lowSplitLowPass = BiquadCoefficients::makeLowPass(sampleRate, lowFrequency, butterworthQ);
+	const BiquadCoefficients lowSplitHighPass = BiquadCoefficients::makeHighPass(sampleRate, lowFrequency, butterworthQ);
+	const BiquadCoefficients highSplitLowPass = BiquadCoefficients::makeLowPass(sampleRate, highFrequency, butterworthQ);
+	const BiquadCoefficients highSplitHighPass = BiquadCoefficients::makeHighPass(sampleRate, highFrequency, butterworthQ);
+
+	// An LR4 low + high sum is a second order allpass with Butterworth Q, which the lows must match
+	const BiquadCoefficients highSplitAllPass = BiquadCoefficients::makeAllPass(sampleRate, highFrequency, butterworthQ);
+
+	for (int i = 0; i < numLines; ++i)
+	{
+		splitStage1.setCoefficients(i, lowSplitLowPass);
+		splitStage1.setCoefficients(numLines + i, lowSplitHighPass);
+		splitStage2.setCoefficients(i, lowSplitLowPass);
+		splitStage2.setCoefficients(numLines + i, lowSplitHighPass);
+
+		splitStage3.setCoefficients(i, highSplitAllPass);
+		splitStage3.setCoefficients(numLines + i, highSplitLowPass);
+		splitStage3.setCoefficients(2 * numLines + i, highSplitHighPass);
+		splitStage4.setCoefficients(i, highSplitLowPass);
+		splitStage4.setCoefficients(numLines + i, highSplitHighPass);
+	}
+}
+
+void MultibandDecayFilter::setBandGains(int lineIndex, float lowGain, float midGain, float highGain) noexcept
+{
+	jassert(isPositiveAndBelow(lineIndex, numLines));
+
+	bandGains[0][lineIndex] = lowGain;
+	bandGains[1][lineIndex] = midGain;
+	bandGains[2][lineIndex] = highGain;
+}
+
+void MultibandDecayFilter::process(float* const* lines, int numSamples) noexcept
+{
+	if (bandMemory == nullptr) return;
+
+	// The caller may hand over different line buffers every time, so the channel lists are rebuilt per call
+	for (int i = 0; i < numLines; ++i)
+	{
+		splitChannels[i] = stage3Channels[i] = lowBands[i];
+		splitChannels[numLines + i] = stage3Channels[numLines + i] = stage4Channels[i] = lines[i];
+		stage3Channels[2 * numLines + i] = stage4Channels[numLines + i] = highBands[i];
+	}
+
+	for (int offset = 0; offset < numSamples; offset += maxBlockSize)
+	{
+		const int numToDo = jmin(maxBlockSize, numSamples - offset);
+
+		if (offset > 0)
+		{
+			for (int i = 0; i < numLines; ++i)
+				splitChannels[numLines + i] = stage3Channels[numLines + i] = stage4Channels[i] = lines[i] + offset;
+		}
+
+		// Lows split off the line, which keeps everything above the low crossover
+		for (int i = 0; i < numLines; ++i)
+			FloatVectorOperations::copy(lowBands[i], lines[i] + offset, numToDo);
+
+		splitStage1.process(splitChannels, numToDo);
+		splitStage2.process(splitChannels, numToDo);
+
+		// Highs split off the rest, which leaves the mids in the line
+		for (int i = 0; i < numLines; ++i)
+			FloatVectorOperations::copy(highBands[i], lines[i] + offset, numToDo);
+
+		splitStage3.process(stage3Channels, numToDo);
+		splitStage4.process(stage4Channels, numToDo);
+
+		for (int i = 0; i < numLines; ++i)
+		{
+			float* const line = lines[i] + offset;
+
+			FloatVectorOperations::multiply(line, bandGains[1][i], numToDo);
+			FloatVectorOperations::addWithMultiply(line, lowBands[i], bandGains[0][i], numToDo);
+			FloatVectorOperations::addWithMultiply(line, highBands[i], bandGains[2][i], numToDo);
+		}
+	}
+}
+
+} // namespace Zen
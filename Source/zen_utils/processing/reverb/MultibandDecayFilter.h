@@ -0,0 +1,95 @@
+/*==============================================================================
+//  MultibandDecayFilter.h
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Three band Linkwitz-Riley split with per-line band gains, for
+//  frequency dependent decay inside a delay network's feedback loop
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#ifndef ZEN_MULTIBAND_DECAY_FILTER_H_INCLUDED
+#define ZEN_MULTIBAND_DECAY_FILTER_H_INCLUDED
+
+#include "JuceHeader.h"
+#include "../ZenDSPFilters.h"
+
+namespace Zen
+{
+
+/// <summary> Splits every delay line into low, mid and high bands with fourth order Linkwitz-Riley crossovers,
+/// scales each band by its own gain and sums them back, in place.
+///
+/// The low band also runs through the high crossover's allpass so all three bands stay phase aligned, and
+/// equal band gains give a flat magnitude response.  Each crossover stage of every line is one wide
+/// BiquadBank, so the whole split is four lane-packed filter passes per chunk.  Band gains are plain
+/// per-line numbers, computed by the owner at control rate when its parameters change. </summary>
+class MultibandDecayFilter
+{
+public:
+	enum
+	{
+		numBands = 3,
+		maxNumLines = 16
+	};
+
+	MultibandDecayFilter();
+	~MultibandDecayFilter();
+
+	/// <summary> Allocates the filter banks and band buffers.  The only place this class allocates. </summary>
+	/// <param name="inSampleRate">   The current sample rate. </param>
+	/// <param name="inNumLines">     Number of delay lines, one filter set each. </param>
+	/// <param name="inMaxBlockSize"> Longest block process() will be given. </param>
+	void prepare(double inSampleRate, int inNumLines, int inMaxBlockSize);
+
+	/// <summary> Frees all memory. </summary>
+	void release();
+
+	/// <summary> Clears every filter state, coefficients and gains are kept. </summary>
+	void reset() noexcept;
+
+	/// <summary> Redesigns both crossovers.  Only call when a frequency actually changes. </summary>
+	void setCrossovers(double lowFrequency, double highFrequency) noexcept;
+
+	void setBandGains(int lineIndex, float lowGain, float midGain, float highGain) noexcept;
+
+	int getNumLines() const noexcept { return numLines; }
+
+	/// <summary> Filters every line in place, lines[i] through line i's split and band gains. </summary>
+	void process(float* const* lines, int numSamples) noexcept;
+
+	/// <summary> Maps a normalized band decay parameter onto a multiple of the mid band RT60, 0.25x - 4x with 0.5 -> 1x </summary>
+	static float convertBandDecayToRatio(float normalizedDecay);
+
+	/// <summary> Maps a normalized parameter onto the low crossover, 100Hz - 1kHz exponentially </summary>
+	static float convertLowCrossoverToHz(float normalizedFrequency);
+
+	/// <summary> Maps a normalized parameter onto the high crossover, 1kHz - 12kHz exponentially </summary>
+	static float convertHighCrossoverToHz(float normalizedFrequency);
+
+private:
+	HeapBlock<float> bandMemory;	///< Low and high band chunk buffers per line, the mid band stays in the line
+	float* lowBands[maxNumLines];
+	float* highBands[maxNumLines];
+	float bandGains[numBands][maxNumLines];
+
+	// Stage filter i works on channel i of the matching channel list below
+	BiquadBank splitStage1, splitStage2;	///< LR4 halves at the low crossover: lows, then lines (everything above)
+	BiquadBank splitStage3, splitStage4;	///< Allpass on lows, LR4 halves at the high crossover on lines (mids) and highs
+	float* splitChannels[2 * maxNumLines];
+	float* stage3Channels[3 * maxNumLines];
+	float* stage4Channels[2 * maxNumLines];
+
+	int numLines = 0, maxBlockSize = 0;
+	double sampleRate = 44100.0;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MultibandDecayFilter);
+};
+
+} // namespace Zen
+#endif // ZEN_MULTIBAND_DECAY_FILTER_H_INCLUDED
@@ -0,0 +1,489 @@
+/*==============================================================================
+//  NonUniformConvolver.cpp
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Non-uniformly partitioned convolution - small head partitions on
+//  the audio thread, doubling tail partitions handed to a ConvolutionWorker
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#include "NonUniformConvolver.h"
+#include "ConvolutionWorker.h"
+#include <limits>
+
+namespace Zen
+{
+
+/// Everything belonging to one segment.  Fields are grouped by the thread that owns them.
+struct NonUniformConvolver::SegmentState
+{
+	Segment layout;
+	PartitionedConvolver convolver;
+	HeapBlock<float> inputRing, outputRing;	///< numRingBlocks * partitionSize per channel, channel-major
+
+	// Audio thread only
+	int inputFill = 0;			///< Samples written into the block currently being filled
+	int outputDelay = 0;		///< Head steps left before the first output block is due
+	int outputPosition = 0;		///< Read position inside the block being mixed
+	int readBlock = 0;			///< Index of the block being mixed
+	bool readBlockReady = false;
+	bool inputLost = false;		///< The block being filled overlaps the one the worker is reading
+
+	// Computing thread only (worker, or audio thread for inline segments)
+	int appliedReset = -1;
+
+	// Shared
+	Atomic<int> postedBlocks;		///< Input blocks completed by the audio thread
+	Atomic<int> completedBlocks;	///< Output blocks completed by the computing thread
+	Atomic<int> resetBlock;			///< First block that must start from a cleared history
+	Atomic<int> workingBlock { -1 };	///< Block the worker is reading, -1 while it is idle
+	Atomic<int> lostBlock { -1 };		///< Latest block whose input the audio thread could not store
+	Atomic<int> blocksProcessed, deadlineMisses;
+	Atomic<int64> lastTicks, maxTicks;
+};
+
+NonUniformConvolver::NonUniformConvolver()
+{
+}
+
+NonUniformConvolver::~NonUniformConvolver()
+{
+	release();
+}
+
+Array<NonUniformConvolver::Segment> NonUniformConvolver::createPartitionLayout(int inBlockSize, int impulseLength, int maxPartitionSize, int minWorkerPartitionSize)
+{
+	Array<Segment> layout;
+	const int headSize = nextPowerOfTwo(jmax(1, inBlockSize));
+	maxPartitionSize = jmax(headSize, nextPowerOfTwo(maxPartitionSize));
+
+	// The head covers everything before the first tail segment's offset
+	int partitionSize = headSize * 2;
+	int offset = (partitionSize * 2) - headSize;
+
+	if (partitionSize > maxPartitionSize || offset >= impulseLength)
+		offset = impulseLength;
+
+	const Segment head = { 0, headSize, jmax(1, (jmin(offset, impulseLength) + headSize - 1) / headSize), false };
+	layout.add(head);
+
+	while (offset < impulseLength)
+	{
+		const int remaining = impulseLength - offset;
+		const bool isLast = (partitionSize >= maxPartitionSize);
+		const int numPartitions = isLast ? (remaining + partitionSize - 1) / partitionSize
+										 : jmin(2, (remaining + partitionSize - 1) / partitionSize);
+
+		const Segment segment = { offset, partitionSize, numPartitions, partitionSize >= minWorkerPartitionSize };
+		layout.add(segment);
+
+		// Keeps offset == 2 * partitionSize - headSize for every segment
+		offset += numPartitions * partitionSize;
+		partitionSize *= 2;
+	}
+
+	return layout;
+}
+
+void NonUniformConvolver::prepare(double inSampleRate, int inBlockSize, const float* impulseResponse, int impulseLength, ConvolutionWorker* inWorker,
+	int maxPartitionSize, int minWorkerPartitionSize)
+{
+	prepare(inSampleRate, inBlockSize, &impulseResponse, impulseLength, 1, 1, inWorker, maxPartitionSize, minWorkerPartitionSize);
+}
+
+void NonUniformConvolver::prepare(double inSampleRate, int inBlockSize, const float* const* impulseResponses, int impulseLength, int inNumInputs, int inNumOutputs,
+	ConvolutionWorker* inWorker, int maxPartitionSize, int minWorkerPartitionSize)
+{
+	jassert(inSampleRate > 0 && impulseResponses != nullptr && impulseLength > 0);
+	jassert(inNumInputs > 0 && inNumInputs <= maxChannels && inNumOutputs > 0 && inNumOutputs <= maxChannels);
+
+	release();
+
+	sampleRate = inSampleRate;
+	worker = inWorker;
+	numInputs = inNumInputs;
+	numOutputs = inNumOutputs;
+	blockSize = nextPowerOfTwo(jmax(1, inBlockSize));
+
+	inputBlock.allocate(static_cast<size_t>(numInputs * blockSize), true);
+	outputBlock.allocate(static_cast<size_t>(numOutputs * blockSize), true);
+
+	// Without a worker every segment is computed inline
+	if (worker == nullptr)
+		minWorkerPartitionSize = std::numeric_limits<int>::max();
+
+	const Array<Segment> layout(createPartitionLayout(blockSize, impulseLength, maxPartitionSize, minWorkerPartitionSize));
+
+	for (int i = 0; i < layout.size(); ++i)
+	{
+		SegmentState* const segment = segments.add(new SegmentState());
+		segment->layout = layout.getReference(i);
+
+		const Segment& s = segment->layout;
+		const int segmentLength = jmin(s.numPartitions * s.partitionSize, impulseLength - s.offset);
+
+		const float* segmentImpulses[maxChannels * maxChannels];
+
+		for (int path = 0; path < numInputs * numOutputs; ++path)
+			segmentImpulses[path] = impulseResponses[path] + s.offset;
+
+		segment->convolver.prepare(s.partitionSize, segmentImpulses, segmentLength, numInputs, numOutputs);
+
+		if (i > 0)
+		{
+			segment->inputRing.allocate(static_cast<size_t>(numInputs * numRingBlocks * s.partitionSize), true);
+			segment->outputRing.allocate(static_cast<size_t>(numOutputs * numRingBlocks * s.partitionSize), true);
+		}
+	}
+
+	reset();
+}
+
+void NonUniformConvolver::release()
+{
+	segments.clear();
+	inputBlock.free();
+	outputBlock.free();
+	worker = nullptr;
+	blockSize = blockFill = 0;
+	numInputs = numOutputs = 0;
+}
+
+void NonUniformConvolver::reset() noexcept
+{
+	if (!isPrepared()) return;
+
+	FloatVectorOperations::clear(inputBlock, numInputs * blockSize);
+	FloatVectorOperations::clear(outputBlock, numOutputs * blockSize);
+	blockFill = 0;
+
+	segments.getUnchecked(0)->convolver.reset();
+
+	for (int i = 1; i < segments.size(); ++i)
+	{
+		SegmentState& segment = *segments.getUnchecked(i);
+
+		// Blocks already posted may still be computed, but they are never read.  Whoever computes
+		// the segment clears its history before the first block posted from here on.
+		segment.resetBlock.set(segment.postedBlocks.get());
+		segment.inputFill = 0;
+		segment.outputDelay = segment.layout.offset / blockSize;
+		segment.outputPosition = 0;
+		segment.readBlock = segment.postedBlocks.get();
+		segment.readBlockReady = false;
+	}
+}
+
+void NonUniformConvolver::process(const float* input, float* output, int numSamples) noexcept
+{
+	jassert(!isPrepared() || (numInputs == 1 && numOutputs == 1));
+	process(&input, &output, numSamples);
+}
+
+void NonUniformConvolver::process(const float* const* inputs, float* const* outputs, int numSamples) noexcept
+{
+	if (!isPrepared())
+	{
+		if (inputs[0] != outputs[0]) FloatVectorOperations::copy(outputs[0], inputs[0], numSamples);
+		return;
+	}
+
+	int position = 0;
+
+	while (position < numSamples)
+	{
+		const int numToDo = jmin(numSamples - position, blockSize - blockFill);
+
+		// Every input is taken before any output is written so in-place processing is safe
+		for (int input = 0; input < numInputs; ++input)
+			FloatVectorOperations::copy(inputBlock + input * blockSize + blockFill, inputs[input] + position, numToDo);
+
+		for (int output = 0; output < numOutputs; ++output)
+			FloatVectorOperations::copy(outputs[output] + position, outputBlock + output * blockSize + blockFill, numToDo);
+
+		blockFill += numToDo;
+		position += numToDo;
+
+		if (blockFill == blockSize)
+		{
+			processStep();
+			blockFill = 0;
+		}
+	}
+}
+
+void NonUniformConvolver::processStep() noexcept
+{
+	SegmentState& head = *segments.getUnchecked(0);
+
+	const float* headInputs[maxChannels];
+	float* headOutputs[maxChannels];
+
+	for (int input = 0; input < numInputs; ++input)
+		headInputs[input] = inputBlock + input * blockSize;
+
+	for (int output = 0; output < numOutputs; ++output)
+		headOutputs[output] = outputBlock + output * blockSize;
+
+	const int64 startTicks = Time::getHighResolutionTicks();
+	head.convolver.processBlock(headInputs, headOutputs);
+	const int64 elapsed = Time::getHighResolutionTicks() - startTicks;
+
+	head.lastTicks.set(elapsed);
+	if (elapsed > head.maxTicks.get()) head.maxTicks.set(elapsed);
+	head.blocksProcessed += 1;
+
+	bool workPosted = false;
+
+	for (int i = 1; i < segments.size(); ++i)
+	{
+		SegmentState& segment = *segments.getUnchecked(i);
+		mixSegmentOutput(segment);
+
+		if (pushSegmentInput(segment))
+			workPosted = true;
+	}
+
+	if (workPosted)
+		worker->notify();
+}
+
+void NonUniformConvolver::mixSegmentOutput(SegmentState& segment) noexcept
+{
+	if (segment.outputDelay > 0)
+	{
+		--segment.outputDelay;
+		return;
+	}
+
+	const int partitionSize = segment.layout.partitionSize;
+
+	// Deadline check, once per segment block.  In real time never wait, a late block is simply skipped.
+	// Offline the worker gets as long as it needs, unless the block was lost or the thread is gone.
+	if (segment.outputPosition == 0)
+	{
+		if (nonRealtime && segment.layout.onWorkerThread && worker != nullptr)
+		{
+			while ((segment.completedBlocks.get() - segment.readBlock) <= 0
+				&& (segment.postedBlocks.get() - segment.readBlock) > 0
+				&& (segment.readBlock - segment.lostBlock.get()) > 0
+				&& worker->isThreadRunning())
+			{
+				worker->notify();
+				Thread::yield();
+			}
+		}
+
+		segment.readBlockReady = (segment.completedBlocks.get() - segment.readBlock) > 0
+			&& (segment.readBlock - segment.lostBlock.get()) > 0;
+
+		if (!segment.readBlockReady)
+			segment.deadlineMisses += 1;
+	}
+
+	if (segment.readBlockReady)
+	{
+		const int slot = segment.readBlock % numRingBlocks;
+
+		for (int output = 0; output < numOutputs; ++output)
+		{
+			const float* const source = segment.outputRing + (output * numRingBlocks + slot) * partitionSize + segment.outputPosition;
+			FloatVectorOperations::add(outputBlock + output * blockSize, source, blockSize);
+		}
+	}
+
+	segment.outputPosition += blockSize;
+
+	if (segment.outputPosition >= partitionSize)
+	{
+		segment.outputPosition = 0;
+		++segment.readBlock;
+	}
+}
+
+bool NonUniformConvolver::pushSegmentInput(SegmentState& segment) noexcept
+{
+	const int partitionSize = segment.layout.partitionSize;
+	const int block = segment.postedBlocks.get();
+
+	const int slot = block % numRingBlocks;
+
+	// Decided once per block: the worker only moves forward, so a slot that is free now stays free
+	if (segment.inputFill == 0 && segment.layout.onWorkerThread && worker != nullptr)
+	{
+		const int working = segment.workingBlock.get();
+		segment.inputLost = working >= 0 && (block - working) >= numRingBlocks;
+
+		if (segment.inputLost)
+			segment.lostBlock.set(block);
+	}
+
+	if (!segment.inputLost)
+	{
+		for (int input = 0; input < numInputs; ++input)
+			FloatVectorOperations::copy(segment.inputRing + (input * numRingBlocks + slot) * partitionSize + segment.inputFill,
+				inputBlock + input * blockSize, blockSize);
+	}
+
+	segment.inputFill += blockSize;
+
+	if (segment.inputFill < partitionSize)
+		return false;
+
+	segment.inputFill = 0;
+	segment.postedBlocks.set(block + 1);
+
+	if (segment.layout.onWorkerThread && worker != nullptr)
+		return true;
+
+	processSegmentBlock(segment, block);
+	return false;
+}
+
+bool NonUniformConvolver::processPendingWork(int segmentIndex) noexcept
+{
+	if (!isPositiveAndBelow(segmentIndex, segments.size()) || segmentIndex == 0)
+		return false;
+
+	SegmentState& segment = *segments.getUnchecked(segmentIndex);
+
+	if (!segment.layout.onWorkerThread)
+		return false;
+
+	bool didWork = false;
+
+	for (;;)
+	{
+		const int block = segment.completedBlocks.get();
+
+		// Claimed before posted is read, so either this pass sees the block the audio thread is
+		// filling as too far ahead, or the audio thread sees the claim and doesn't touch the slot
+		segment.workingBlock.set(block);
+
+		const int posted = segment.postedBlocks.get();
+
+		if (block == posted)
+			break;
+
+		// So far behind that the oldest inputs were overwritten, or one of them could not be stored.
+		// Their deadlines have long passed, so restart after them with a clean history.
+		int restartBlock = block;
+
+		if (posted - block >= numRingBlocks)
+			restartBlock = posted - (numRingBlocks - 1);
+
+		const int lost = segment.lostBlock.get();
+
+		if (lost >= restartBlock && lost < posted)
+			restartBlock = lost + 1;
+
+		if (restartBlock != block)
+		{
+			segment.convolver.reset();
+			segment.completedBlocks.set(restartBlock);
+			continue;
+		}
+
+		processSegmentBlock(segment, block);
+		didWork = true;
+	}
+
+	segment.workingBlock.set(-1);
+	return didWork;
+}
+
+void NonUniformConvolver::processSegmentBlock(SegmentState& segment, int block) noexcept
+{
+	const int resetAt = segment.resetBlock.get();
+
+	if (resetAt != segment.appliedReset && block >= resetAt)
+	{
+		segment.convolver.reset();
+		segment.appliedReset = resetAt;
+	}
+
+	const int partitionSize = segment.layout.partitionSize;
+	const int slot = block % numRingBlocks;
+	const float* blockInputs[maxChannels];
+	float* blockOutputs[maxChannels];
+
+	for (int input = 0; input < numInputs; ++input)
+		blockInputs[input] = segment.inputRing + (input * numRingBlocks + slot) * partitionSize;
+
+	for (int output = 0; output < numOutputs; ++output)
+		blockOutputs[output] = segment.outputRing + (output * numRingBlocks + slot) * partitionSize;
+
+	const int64 startTicks = Time::getHighResolutionTicks();
+	segment.convolver.processBlock(blockInputs, blockOutputs);
+	const int64 elapsed = Time::getHighResolutionTicks() - startTicks;
+
+	segment.lastTicks.set(elapsed);
+	if (elapsed > segment.maxTicks.get()) segment.maxTicks.set(elapsed);
+	segment.blocksProcessed += 1;
+
+	segment.completedBlocks.set(block + 1);
+}
+
+const NonUniformConvolver::Segment& NonUniformConvolver::getSegment(int segmentIndex) const
+{
+	return segments.getUnchecked(segmentIndex)->layout;
+}
+
+NonUniformConvolver::SegmentTiming NonUniformConvolver::getSegmentTiming(int segmentIndex) const
+{
+	const SegmentState& segment = *segments.getUnchecked(segmentIndex);
+	const double microsecondsPerTick = 1.0e6 / static_cast<double>(Time::getHighResolutionTicksPerSecond());
+
+	// Head and inline segments must finish inside one head block, worker segments have a full period
+	const int budgetSamples = segment.layout.onWorkerThread ? segment.layout.partitionSize : blockSize;
+
+	SegmentTiming timing;
+	timing.lastMicroseconds = segment.lastTicks.get() * microsecondsPerTick;
+	timing.maxMicroseconds = segment.maxTicks.get() * microsecondsPerTick;
+	timing.budgetMicroseconds = budgetSamples * 1.0e6 / sampleRate;
+	timing.blocksProcessed = segment.blocksProcessed.get();
+	timing.deadlineMisses = segment.deadlineMisses.get();
+	return timing;
+}
+
+int NonUniformConvolver::getTotalDeadlineMisses() const
+{
+	int total = 0;
+
+	for (int i = 0; i < segments.size(); ++i)
+		total += segments.getUnchecked(i)->deadlineMisses.get();
+
+	return total;
+}
+
+String NonUniformConvolver::getScheduleDescription() const
+{
+	String description;
+
+	for (int i = 0; i < segments.size(); ++i)
+	{
+		const Segment& s = getSegment(i);
+		const SegmentTiming timing = getSegmentTiming(i);
+
+		description << "  segment " << i
+			<< ": offset " << s.offset
+			<< ", " << s.numPartitions << " x " << s.partitionSize
+			<< (s.onWorkerThread ? ", worker" : ", audio")
+			<< ", posted every " << s.partitionSize << " due " << (i == 0 ? 0 : s.offset - s.partitionSize + blockSize) << " later"
+			<< ", last " << String(timing.lastMicroseconds, 1) << "us"
+			<< ", max " << String(timing.maxMicroseconds, 1) << "us"
+			<< " (" << String(timing.maxMicroseconds / s.numPartitions, 2) << "us/partition)"
+			<< " of " << String(timing.budgetMicroseconds, 1) << "us"
+			<< ", misses " << timing.deadlineMisses << "\n";
+	}
+
+	return description;
+}
+
+} // namespace Zen
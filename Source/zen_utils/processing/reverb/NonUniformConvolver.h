@@ -0,0 +1,152 @@
+/*==============================================================================
+//  NonUniformConvolver.h
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Non-uniformly partitioned convolution - small head partitions on
+//  the audio thread, doubling tail partitions handed to a ConvolutionWorker
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#ifndef ZEN_NON_UNIFORM_CONVOLVER_H_INCLUDED
+#define ZEN_NON_UNIFORM_CONVOLVER_H_INCLUDED
+
+#include "JuceHeader.h"
+#include "PartitionedConvolver.h"
+
+namespace Zen
+{
+
+class ConvolutionWorker;
+
+/// <summary> Non-uniformly partitioned convolver, mono or multichannel (see PartitionedConvolver).
+///
+/// The impulse response is cut into segments.  The head segment uses partitions of blockSize
+/// and runs on the audio thread every block.  Each following segment doubles the partition size
+/// (up to maxPartitionSize, where the last segment takes the rest of the impulse) and starts at
+/// offset 2 * partitionSize - blockSize.  That offset leaves exactly one partition period between
+/// a segment's input block being complete and its output being needed, which is the compute
+/// budget for that block.
+///
+/// Segments with partitions of at least minWorkerPartitionSize are computed on the worker thread,
+/// smaller ones inline on the audio thread.  In real time the audio thread never waits for the
+/// worker: if a block is not finished when its output is due it is dropped and counted as a
+/// deadline miss.  In non-realtime mode (offline bounces) it waits for the block instead.
+///
+/// A worker more than numRingBlocks behind would read an input slot the audio thread is refilling.
+/// The audio thread sees that through the block the worker has claimed and leaves the slot alone;
+/// the block is lost, the worker restarts after it with a clean history and it is never mixed.
+/// Output is delayed by getLatencySamples() (one head partition), exactly like PartitionedConvolver. </summary>
+class NonUniformConvolver
+{
+public:
+	enum
+	{
+		numRingBlocks = 4,	///< Input/output blocks buffered per tail segment
+		maxChannels = PartitionedConvolver::maxChannels,
+		defaultMaxPartitionSize = 8192,
+		defaultMinWorkerPartitionSize = 512
+	};
+
+	/// <summary> One entry of the partition layout.  Segment 0 is always the head. </summary>
+	struct Segment
+	{
+		int offset;				///< First impulse sample covered by this segment
+		int partitionSize;		///< FFT block size is twice this
+		int numPartitions;
+		bool onWorkerThread;
+	};
+
+	/// <summary> Snapshot of a segment's timing, safe to read from any thread </summary>
+	struct SegmentTiming
+	{
+		double lastMicroseconds;	///< Cost of the most recent block
+		double maxMicroseconds;		///< Worst block since prepare()
+		double budgetMicroseconds;	///< Time available per block before the output is late
+		int blocksProcessed;
+		int deadlineMisses;
+	};
+
+	NonUniformConvolver();
+	~NonUniformConvolver();
+
+	/// <summary> Builds the partition layout, FFTW plans and every buffer.  Never call this from the audio thread. </summary>
+	/// <param name="inSampleRate">            Only used to convert timings into microsecond budgets </param>
+	/// <param name="inBlockSize">             Head partition size, rounded up to a power of two </param>
+	/// <param name="impulseResponse">         Impulse response samples (copied) </param>
+	/// <param name="impulseLength">           Number of impulse response samples </param>
+	/// <param name="inWorker">                Thread that services the large segments, or nullptr to compute everything inline </param>
+	/// <param name="maxPartitionSize">        Largest tail partition </param>
+	/// <param name="minWorkerPartitionSize">  Smallest partition handed to the worker </param>
+	void prepare(double inSampleRate, int inBlockSize, const float* impulseResponse, int impulseLength, ConvolutionWorker* inWorker,
+		int maxPartitionSize = defaultMaxPartitionSize, int minWorkerPartitionSize = defaultMinWorkerPartitionSize);
+
+	/// <summary> Multichannel prepare().  impulseResponses holds numInputs * numOutputs impulses, the path
+	/// from input i to output o at index i * numOutputs + o, all impulseLength long. </summary>
+	void prepare(double inSampleRate, int inBlockSize, const float* const* impulseResponses, int impulseLength, int inNumInputs, int inNumOutputs,
+		ConvolutionWorker* inWorker, int maxPartitionSize = defaultMaxPartitionSize, int minWorkerPartitionSize = defaultMinWorkerPartitionSize);
+
+	/// <summary> Frees everything.  The convolver must already be removed from its worker. </summary>
+	void release();
+
+	/// <summary> Clears all history.  Safe on the audio thread; worker segments reset themselves before their next block. </summary>
+	void reset() noexcept;
+
+	/// <summary> Convolves any number of samples.  Input and output may be the same buffer. </summary>
+	void process(const float* input, float* output, int numSamples) noexcept;
+
+	/// <summary> Multichannel process().  Outputs may be the same buffers as the inputs. </summary>
+	void process(const float* const* inputs, float* const* outputs, int numSamples) noexcept;
+
+	/// <summary> Audio thread side.  When true, a worker block that is not ready when its output is due
+	/// is waited for rather than dropped, so offline renders running faster than real time lose nothing.
+	/// Can change between any two process() calls. </summary>
+	void setNonRealtime(bool isNonRealtime) noexcept { nonRealtime = isNonRealtime; }
+
+	/// <summary> Worker thread side: computes every posted block of one segment. </summary>
+	/// <returns> true if at least one block was computed </returns>
+	bool processPendingWork(int segmentIndex) noexcept;
+
+	int getLatencySamples() const { return blockSize; }
+	int getBlockSize() const { return blockSize; }
+	bool isPrepared() const { return segments.size() > 0; }
+	int getNumInputs() const { return numInputs; }
+	int getNumOutputs() const { return numOutputs; }
+
+	int getNumSegments() const { return segments.size(); }
+	const Segment& getSegment(int segmentIndex) const;
+	SegmentTiming getSegmentTiming(int segmentIndex) const;
+	int getTotalDeadlineMisses() const;
+
+	/// <summary> Human readable partition layout, worker schedule and timing, one line per segment </summary>
+	String getScheduleDescription() const;
+
+	/// <summary> Computes the segment layout prepare() would use, without allocating anything </summary>
+	static Array<Segment> createPartitionLayout(int blockSize, int impulseLength, int maxPartitionSize, int minWorkerPartitionSize);
+
+private:
+	struct SegmentState;
+
+	void processStep() noexcept;
+	void mixSegmentOutput(SegmentState& segment) noexcept;
+	bool pushSegmentInput(SegmentState& segment) noexcept;
+	void processSegmentBlock(SegmentState& segment, int block) noexcept;
+
+	OwnedArray<SegmentState> segments;	///< Index 0 is the head
+	ConvolutionWorker* worker = nullptr;
+	HeapBlock<float> inputBlock, outputBlock;	///< Channel-major, blockSize per channel
+	double sampleRate = 44100.0;
+	int blockSize = 0, blockFill = 0;
+	int numInputs = 0, numOutputs = 0;
+	bool nonRealtime = false;	///< Audio thread only
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(NonUniformConvolver);
+};
+
+} // namespace Zen
+#endif // ZEN_NON_UNIFORM_CONVOLVER_H_INCLUDED
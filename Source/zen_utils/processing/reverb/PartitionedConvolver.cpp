@@ -0,0 +1,230 @@
+/*==============================================================================
+//  PartitionedConvolver.cpp
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Uniformly partitioned FFT convolution (overlap-save) built on FFTW
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#include "PartitionedConvolver.h"
+
+namespace Zen
+{
+
+PartitionedConvolver::PartitionedConvolver()
+{
+}
+
+PartitionedConvolver::~PartitionedConvolver()
+{
+	release();
+}
+
+void PartitionedConvolver::prepare(int inBlockSize, const float* impulseResponse, int impulseLength)
+{
+	prepare(inBlockSize, &impulseResponse, impulseLength, 1, 1);
+}
+
+void PartitionedConvolver::prepare(int inBlockSize, const float* const* impulseResponses, int impulseLength, int inNumInputs, int inNumOutputs)
+{
+	jassert(inBlockSize > 0 && impulseLength > 0 && impulseResponses != nullptr);
+	jassert(inNumInputs > 0 && inNumInputs <= maxChannels && inNumOutputs > 0 && inNumOutputs <= maxChannels);
+
+	release();
+
+	numInputs = inNumInputs;
+	numOutputs = inNumOutputs;
+	blockSize = nextPowerOfTwo(jmax(1, inBlockSize));
+	fftSize = blockSize * 2;
+	numBins = fftSize / 2 + 1;
+	numPartitions = jmax(1, (impulseLength + blockSize - 1) / blockSize);
+
+	for (int input = 0; input < numInputs; ++input)
+		forwardFFTs.add(new FFTW(fftSize, true));
+
+	inverseFFT = new FFTW(fftSize, false);
+
+	filterSpectra.allocate(static_cast<size_t>(numInputs * numOutputs * numPartitions * numBins), true);
+	inputSpectra.allocate(static_cast<size_t>(numInputs * numPartitions * numBins), true);
+	inputBlocks.allocate(static_cast<size_t>(numInputs * blockSize), true);
+	outputBlocks.allocate(static_cast<size_t>(numOutputs * blockSize), true);
+
+	// Each partition is zero padded to the FFT size, and the 1/N inverse FFT scale is folded in here
+	FFTW& fft = *forwardFFTs.getUnchecked(0);
+	float* const fftInput = fft.getRealBuffer();
+	const float scale = 1.0f / fftSize;
+
+	for (int input = 0; input < numInputs; ++input)
+	{
+		for (int output = 0; output < numOutputs; ++output)
+		{
+			const float* const impulseResponse = impulseResponses[input * numOutputs + output];
+
+			for (int p = 0; p < numPartitions; ++p)
+			{
+				const int start = p * blockSize;
+				const int numToCopy = jmin(blockSize, impulseLength - start);
+
+				FloatVectorOperations::clear(fftInput, fftSize);
+				FloatVectorOperations::copyWithMultiply(fftInput, impulseResponse + start, scale, numToCopy);
+				fft.execute();
+
+				memcpy(getFilterSpectrum(input, output, p), fft.getComplexBuffer(), sizeof(FFT::Complex) * numBins);
+			}
+		}
+	}
+
+	reset();
+}
+
+void PartitionedConvolver::release()
+{
+	forwardFFTs.clear();
+	inverseFFT = nullptr;
+	filterSpectra.free();
+	inputSpectra.free();
+	inputBlocks.free();
+	outputBlocks.free();
+	blockSize = fftSize = numBins = numPartitions = 0;
+	numInputs = numOutputs = 0;
+	fdlPosition = blockFill = 0;
+}
+
+void PartitionedConvolver::reset() noexcept
+{
+	if (!isPrepared()) return;
+
+	for (int input = 0; input < numInputs; ++input)
+		FloatVectorOperations::clear(forwardFFTs.getUnchecked(input)->getRealBuffer(), fftSize);
+
+	FloatVectorOperations::clear(reinterpret_cast<float*>(inputSpectra.getData()), numInputs * numPartitions * numBins * 2);
+	FloatVectorOperations::clear(inputBlocks, numInputs * blockSize);
+	FloatVectorOperations::clear(outputBlocks, numOutputs * blockSize);
+	fdlPosition = 0;
+	blockFill = 0;
+}
+
+FFT::Complex* PartitionedConvolver::getFilterSpectrum(int input, int output, int partition) const noexcept
+{
+	return filterSpectra + ((input * numOutputs + output) * numPartitions + partition) * numBins;
+}
+
+FFT::Complex* PartitionedConvolver::getInputSpectrum(int input, int slot) const noexcept
+{
+	return inputSpectra + (input * numPartitions + slot) * numBins;
+}
+
+void PartitionedConvolver::process(const float* input, float* output, int numSamples) noexcept
+{
+	jassert(!isPrepared() || (numInputs == 1 && numOutputs == 1));
+	process(&input, &output, numSamples);
+}
+
+void PartitionedConvolver::process(const float* const* inputs, float* const* outputs, int numSamples) noexcept
+{
+	if (!isPrepared())
+	{
+		if (inputs[0] != outputs[0]) FloatVectorOperations::copy(outputs[0], inputs[0], numSamples);
+		return;
+	}
+
+	int position = 0;
+
+	while (position < numSamples)
+	{
+		const int numToDo = jmin(numSamples - position, blockSize - blockFill);
+
+		// Every input is taken before any output is written so in-place processing is safe
+		for (int input = 0; input < numInputs; ++input)
+			FloatVectorOperations::copy(inputBlocks + input * blockSize + blockFill, inputs[input] + position, numToDo);
+
+		for (int output = 0; output < numOutputs; ++output)
+			FloatVectorOperations::copy(outputs[output] + position, outputBlocks + output * blockSize + blockFill, numToDo);
+
+		blockFill += numToDo;
+		position += numToDo;
+
+		if (blockFill == blockSize)
+		{
+			const float* blockInputs[maxChannels];
+			float* blockOutputs[maxChannels];
+
+			for (int input = 0; input < numInputs; ++input)
+				blockInputs[input] = inputBlocks + input * blockSize;
+
+			for (int output = 0; output < numOutputs; ++output)
+				blockOutputs[output] = outputBlocks + output * blockSize;
+
+			processBlock(blockInputs, blockOutputs);
+			blockFill = 0;
+		}
+	}
+}
+
+void PartitionedConvolver::processBlock(const float* input, float* output) noexcept
+{
+	jassert(numInputs == 1 && numOutputs == 1);
+	processBlock(&input, &output);
+}
+
+void PartitionedConvolver::processBlock(const float* const* inputs, float* const* outputs) noexcept
+{
+	// One forward FFT per input: overlap-save window [previous block | current block]
+	for (int input = 0; input < numInputs; ++input)
+	{
+		FFTW& fft = *forwardFFTs.getUnchecked(input);
+		float* const window = fft.getRealBuffer();
+
+		FloatVectorOperations::copy(window, window + blockSize, blockSize);
+		FloatVectorOperations::copy(window + blockSize, inputs[input], blockSize);
+		fft.execute();
+
+		memcpy(getInputSpectrum(input, fdlPosition), fft.getComplexBuffer(), sizeof(FFT::Complex) * numBins);
+	}
+
+	// One inverse FFT per output, every input path summed in the frequency domain first
+	FFT::Complex* const accumulator = inverseFFT->getComplexBuffer();
+
+	for (int output = 0; output < numOutputs; ++output)
+	{
+		FloatVectorOperations::clear(reinterpret_cast<float*>(accumulator), numBins * 2);
+
+		for (int input = 0; input < numInputs; ++input)
+		{
+			int slot = fdlPosition;
+
+			for (int p = 0; p < numPartitions; ++p)
+			{
+				complexMultiplyAccumulate(accumulator, getInputSpectrum(input, slot), getFilterSpectrum(input, output, p), numBins);
+
+				if (--slot < 0) slot = numPartitions - 1;
+			}
+		}
+
+		inverseFFT->execute();
+
+		// The second half of the circular convolution is the linear part
+		FloatVectorOperations::copy(outputs[output], inverseFFT->getRealBuffer() + blockSize, blockSize);
+	}
+
+	if (++fdlPosition >= numPartitions) fdlPosition = 0;
+}
+
+void PartitionedConvolver::complexMultiplyAccumulate(FFT::Complex* acc, const FFT::Complex* a, const FFT::Complex* b, int numBins) noexcept
+{
+	for (int k = 0; k < numBins; ++k)
+	{
+		const float ar = a[k].r, ai = a[k].i;
+		const float br = b[k].r, bi = b[k].i;
+		acc[k].r += ar * br - ai * bi;
+		acc[k].i += ar * bi + ai * br;
+	}
+}
+
+} // namespace Zen
@@ -0,0 +1,107 @@
+/*==============================================================================
+//  PartitionedConvolver.h
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Uniformly partitioned FFT convolution (overlap-save) built on FFTW
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#ifndef ZEN_PARTITIONED_CONVOLVER_H_INCLUDED
+#define ZEN_PARTITIONED_CONVOLVER_H_INCLUDED
+
+#include "JuceHeader.h"
+#include "../FFTW.h"
+
+namespace Zen
+{
+
+/// <summary> Uniformly partitioned convolver.  The impulse response is split into
+/// blockSize segments whose spectra are computed once in prepare().  Every block the input
+/// spectrum is pushed into a frequency-domain delay line and the output spectrum is one
+/// complex multiply-accumulate per partition, followed by a single inverse FFT.
+/// Output is delayed by getLatencySamples() (one partition).
+///
+/// With several inputs and outputs (true stereo is 2 x 2) each input is transformed once per
+/// block and its delay line is shared by every output.  Each output accumulates the products of
+/// all its input paths in the frequency domain and needs a single inverse FFT, so true stereo
+/// costs 2 forward + 2 inverse FFTs per block rather than 4 + 4. </summary>
+class PartitionedConvolver
+{
+public:
+	enum
+	{
+		maxChannels = 2
+	};
+
+	PartitionedConvolver();
+	~PartitionedConvolver();
+
+	/// <summary> Mono version of prepare(), one input and one output. </summary>
+	void prepare(int inBlockSize, const float* impulseResponse, int impulseLength);
+
+	/// <summary> Creates the FFTW plans, partitions every impulse response and allocates every
+	/// buffer used by process().  Never call this from the audio thread. </summary>
+	/// <param name="inBlockSize">      Partition size in samples, rounded up to a power of two </param>
+	/// <param name="impulseResponses"> numInputs * numOutputs impulses, the path from input i to output o
+	///                                 at index i * numOutputs + o (LL, LR, RL, RR for true stereo).
+	///                                 Copied, need not outlive this call. </param>
+	/// <param name="impulseLength">    Number of samples in each impulse response </param>
+	/// <param name="inNumInputs">      1 to maxChannels </param>
+	/// <param name="inNumOutputs">     1 to maxChannels </param>
+	void prepare(int inBlockSize, const float* const* impulseResponses, int impulseLength, int inNumInputs, int inNumOutputs);
+
+	/// <summary> Frees all FFTW plans and buffers. </summary>
+	void release();
+
+	/// <summary> Clears all input history and pending output without reallocating. </summary>
+	void reset() noexcept;
+
+	/// <summary> Mono version of process(). </summary>
+	void process(const float* input, float* output, int numSamples) noexcept;
+
+	/// <summary> Convolves any number of samples.  Outputs may be the same buffers as the inputs. </summary>
+	void process(const float* const* inputs, float* const* outputs, int numSamples) noexcept;
+
+	/// <summary> Mono version of processBlock(). </summary>
+	void processBlock(const float* input, float* output) noexcept;
+
+	/// <summary> Convolves exactly getBlockSize() samples with no added latency: outputs receive the
+	/// convolution result for the same time span as the inputs.  Used when the caller does its own
+	/// block buffering (NonUniformConvolver).  Do not mix with process() without a reset(). </summary>
+	void processBlock(const float* const* inputs, float* const* outputs) noexcept;
+
+	int getLatencySamples() const { return blockSize; }
+	int getBlockSize() const { return blockSize; }
+	int getNumPartitions() const { return numPartitions; }
+	int getNumInputs() const { return numInputs; }
+	int getNumOutputs() const { return numOutputs; }
+	bool isPrepared() const { return inverseFFT != nullptr; }
+
+	/// <summary> acc += a * b for numBins interleaved complex values </summary>
+	static void complexMultiplyAccumulate(FFT::Complex* acc, const FFT::Complex* a, const FFT::Complex* b, int numBins) noexcept;
+
+private:
+	FFT::Complex* getFilterSpectrum(int input, int output, int partition) const noexcept;
+	FFT::Complex* getInputSpectrum(int input, int slot) const noexcept;
+
+	OwnedArray<FFTW> forwardFFTs;	///< One per input, each real buffer holds that input's overlap-save window
+	ScopedPointer<FFTW> inverseFFT;	///< Shared by every output
+	HeapBlock<FFT::Complex> filterSpectra;	///< numInputs * numOutputs * numPartitions * numBins
+	HeapBlock<FFT::Complex> inputSpectra;	///< Frequency-domain delay lines, numInputs * numPartitions * numBins
+	HeapBlock<float> inputBlocks, outputBlocks;	///< Channel-major, blockSize per channel
+
+	int blockSize = 0, fftSize = 0, numBins = 0, numPartitions = 0;
+	int numInputs = 0, numOutputs = 0;
+	int fdlPosition = 0, blockFill = 0;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PartitionedConvolver);
+};
+
+} // namespace Zen
+#endif // ZEN_PARTITIONED_CONVOLVER_H_INCLUDED
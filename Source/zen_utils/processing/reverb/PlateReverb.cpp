@@ -0,0 +1,443 @@
+/*==============================================================================
+//  PlateReverb.cpp
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Dattorro figure-eight plate reverb processed in blocks, with
+//  control-rate modulation of the tank allpasses
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#include "PlateReverb.h"
+#include "FDNReverb.h"
+#include "../../utilities/ZenUtils.hpp"
+#include <cmath>
+
+namespace Zen
+{
+
+namespace
+{
+// Line indices: four input diffusers, then per tank half a modulated allpass, delay, allpass, delay
+enum
+{
+	leftTank = PlateReverb::numInputDiffusers,
+	rightTank = leftTank + PlateReverb::numTankLines,
+	modulatedAllPass = 0, firstDelay, tankAllPass, secondDelay
+};
+
+// Dattorro's tunings in samples at his 29761Hz reference rate
+const int baseLineLengths[PlateReverb::numLines] = {
+	142, 107, 379, 277,
+	672, 4453, 1800, 3720,
+	908, 4217, 2656, 3163 };
+
+const float inputDiffusion[PlateReverb::numInputDiffusers] = { 0.75f, 0.75f, 0.625f, 0.625f };
+const float decayDiffusion1 = -0.7f;	// Opposite sign to the input diffusers, as in the paper
+const float decayDiffusion2 = 0.5f;
+const float bandwidth = 0.9995f;
+const float outputGain = 0.6f;
+
+const double baseExcursion = 16.0;	// Peak modulation in samples at the reference rate
+const double lfoFrequency = 1.0;
+
+const double baseSampleRate = 29761.0;
+const float minSizeScale = 0.25f;
+
+struct TapTuning
+{
+	int line, offset;
+	float sign;
+};
+
+// Left output listens mostly to the right half of the tank and vice versa
+const TapTuning tapTunings[2][PlateReverb::numOutputTaps] = {
+	{ { rightTank + firstDelay, 266, 1.0f }, { rightTank + firstDelay, 2974, 1.0f }, { rightTank + tankAllPass, 1913, -1.0f },
+	  { rightTank + secondDelay, 1996, 1.0f }, { leftTank + firstDelay, 1990, -1.0f }, { leftTank + tankAllPass, 187, -1.0f },
+	  { leftTank + secondDelay, 1066, -1.0f } },
+	{ { leftTank + firstDelay, 353, 1.0f }, { leftTank + firstDelay, 3627, 1.0f }, { leftTank + tankAllPass, 1228, -1.0f },
+	  { leftTank + secondDelay, 2673, 1.0f }, { rightTank + firstDelay, 2111, -1.0f }, { rightTank + tankAllPass, 335, -1.0f },
+	  { rightTank + secondDelay, 121, -1.0f } } };
+}
+
+PlateReverb::PlateReverb()
+{
+	for (int i = 0; i < numLines; ++i)
+	{
+		lines[i].data = nullptr;
+		lines[i].mask = 0;
+		lines[i].length = 1;
+	}
+
+	for (int channel = 0; channel < 2; ++channel)
+	{
+		for (int i = 0; i < numOutputTaps; ++i)
+		{
+			outputTaps[channel][i].line = tapTunings[channel][i].line;
+			outputTaps[channel][i].offset = 0;
+			outputTaps[channel][i].gain = tapTunings[channel][i].sign * outputGain;
+		}
+
+		wetChunks[channel] = nullptr;
+		dampingStates[channel] = 0.0f;
+	}
+}
+
+PlateReverb::~PlateReverb()
+{
+	release();
+}
+
+void PlateReverb::prepare(double inSampleRate)
+{
+	jassert(inSampleRate > 0);
+
+	sampleRate = inSampleRate;
+
+	const double rateScale = sampleRate / baseSampleRate;
+	excursion = static_cast<float>(baseExcursion * rateScale);
+	lfoIncrement = static_cast<float>(2.0 * double_Pi * lfoFrequency / sampleRate);
+
+	// Each line gets its own power of two capacity, big enough for its longest delay plus a chunk
+	// and the modulation span.  The shared write position wraps at the largest capacity, which
+	// every smaller capacity divides.
+	int capacities[numLines];
+	int totalCapacity = 0;
+	writeMask = 0;
+
+	for (int i = 0; i < numLines; ++i)
+	{
+		const int maxLength = static_cast<int>(std::ceil(baseLineLengths[i] * rateScale)) + static_cast<int>(std::ceil(excursion));
+		capacities[i] = nextPowerOfTwo(maxLength + maxChunkSize + spanPadding);
+		lines[i].mask = capacities[i] - 1;
+		totalCapacity += capacities[i];
+		writeMask = jmax(writeMask, lines[i].mask);
+	}
+
+	delayMemory.allocate(static_cast<size_t>(totalCapacity), true);
+
+	float* memory = delayMemory;
+
+	for (int i = 0; i < numLines; ++i)
+	{
+		lines[i].data = memory;
+		memory += capacities[i];
+	}
+
+	// Input diffusers only depend on the sample rate
+	for (int i = 0; i < numInputDiffusers; ++i)
+		lines[i].length = jmax(1, roundToInt(baseLineLengths[i] * rateScale));
+
+	scratchMemory.allocate(static_cast<size_t>(7 * maxChunkSize + spanPadding), true);
+
+	float* scratch = scratchMemory;
+	diffused = scratch;			scratch += maxChunkSize;
+	tankChunk = scratch;		scratch += maxChunkSize;
+	readChunk = scratch;		scratch += maxChunkSize;
+	allPassChunk = scratch;		scratch += maxChunkSize;
+	wetChunks[0] = scratch;		scratch += maxChunkSize;
+	wetChunks[1] = scratch;		scratch += maxChunkSize;
+	spanChunk = scratch;
+
+	// Force every coefficient to be recalculated for the new rate
+	const float lastSize = (size < 0.0f) ? 0.5f : size;
+	const float lastDecay = (decay < 0.0f) ? 0.5f : decay;
+	const float lastDamping = (damping < 0.0f) ? 0.5f : damping;
+	const float lastMix = (mix < 0.0f) ? 0.0f : mix;
+	size = decay = damping = mix = -1.0f;
+	setParameters(lastSize, lastDecay, lastDamping, lastMix);
+
+	reset();
+}
+
+void PlateReverb::release()
+{
+	delayMemory.free();
+	scratchMemory.free();
+
+	for (int i = 0; i < numLines; ++i)
+	{
+		lines[i].data = nullptr;
+		lines[i].mask = 0;
+	}
+
+	diffused = tankChunk = readChunk = spanChunk = allPassChunk = nullptr;
+	wetChunks[0] = wetChunks[1] = nullptr;
+	writeMask = writePosition = 0;
+}
+
+void PlateReverb::reset() noexcept
+{
+	if (delayMemory == nullptr) return;
+
+	for (int i = 0; i < numLines; ++i)
+		FloatVectorOperations::clear(lines[i].data, lines[i].mask + 1);
+
+	bandwidthState = dampingStates[0] = dampingStates[1] = 0.0f;
+	lfoPhase = 0.0f;
+	writePosition = 0;
+}
+
+void PlateReverb::setParameters(float inSize, float inDecay, float inDamping, float inMix) noexcept
+{
+	bool lengthsChanged = false, gainsChanged = false;
+
+	if (inSize != size)
+	{
+		size = getClamped(inSize, 0.0f, 1.0f);
+		lengthsChanged = true;
+	}
+
+	if (inDecay != decay)
+	{
+		decay = getClamped(inDecay, 0.0f, 1.0f);
+		rt60 = FDNReverb::convertDecayToRT60(decay);
+		gainsChanged = true;
+	}
+
+	if (inDamping != damping)
+	{
+		damping = getClamped(inDamping, 0.0f, 1.0f);
+		dampingCoeff = damping * 0.9f;
+	}
+
+	if (inMix != mix)
+	{
+		mix = getClamped(inMix, 0.0f, 1.0f);
+		dryGain = 1.0f - mix;
+		wetGain = mix;
+	}
+
+	if (lengthsChanged)
+		updateDelayLengths();	// also updates the decay gain, since it depends on the lengths
+	else if (gainsChanged)
+		updateDecayGain();
+}
+
+void PlateReverb::updateDelayLengths() noexcept
+{
+	if (delayMemory == nullptr) return;
+
+	const double scale = (minSizeScale + (1.0f - minSizeScale) * size) * sampleRate / baseSampleRate;
+	const int minModulatedLength = static_cast<int>(std::ceil(excursion)) + 2;
+
+	chunkLimit = maxChunkSize;
+
+	for (int i = 0; i < numInputDiffusers; ++i)
+		chunkLimit = jmin(chunkLimit, lines[i].length);
+
+	for (int i = leftTank; i < numLines; ++i)
+	{
+		const int maxLength = lines[i].mask + 1 - maxChunkSize - spanPadding;
+		const bool isModulated = ((i - leftTank) % numTankLines) == modulatedAllPass;
+
+		lines[i].length = jlimit(isModulated ? minModulatedLength + 1 : 1, maxLength, roundToInt(baseLineLengths[i] * scale));
+
+		// Modulated reads must stay behind this chunk's writes at the deepest excursion
+		chunkLimit = jmin(chunkLimit, isModulated ? lines[i].length - minModulatedLength : lines[i].length);
+	}
+
+	for (int channel = 0; channel < 2; ++channel)
+	{
+		for (int i = 0; i < numOutputTaps; ++i)
+		{
+			OutputTap& tap = outputTaps[channel][i];
+			tap.offset = jlimit(0, lines[tap.line].length, roundToInt(tapTunings[channel][i].offset * scale));
+		}
+	}
+
+	chunkLimit = jmax(1, chunkLimit);
+
+	updateDecayGain();
+}
+
+void PlateReverb::updateDecayGain() noexcept
+{
+	// A full trip round the figure eight passes both halves and four decay gains
+	int loopLength = 0;
+
+	for (int i = leftTank; i < numLines; ++i)
+		loopLength += lines[i].length;
+
+	decayGain = static_cast<float>(std::pow(10.0, -3.0 * loopLength / (4.0 * rt60 * sampleRate)));
+}
+
+void PlateReverb::processStereo(float* leftData, float* rightData, int numSamples) noexcept
+{
+	if (delayMemory == nullptr) return;
+
+	while (numSamples > 0)
+	{
+		const int chunkSize = jmin(numSamples, chunkLimit);
+		processChunk(leftData, rightData, chunkSize);
+
+		leftData += chunkSize;
+		rightData += chunkSize;
+		numSamples -= chunkSize;
+	}
+}
+
+void PlateReverb::processChunk(float* leftData, float* rightData, int numSamples) noexcept
+{
+	// Mono input through the bandwidth lowpass
+	FloatVectorOperations::copy(diffused, leftData, numSamples);
+	FloatVectorOperations::add(diffused, rightData, numSamples);
+	FloatVectorOperations::multiply(diffused, 0.5f, numSamples);
+
+	float state = bandwidthState;
+
+	for (int i = 0; i < numSamples; ++i)
+		diffused[i] = state += bandwidth * (diffused[i] - state);
+
+	if (!(state < -1.0e-8f || state > 1.0e-8f)) state = 0.0f;
+	bandwidthState = state;
+
+	for (int i = 0; i < numInputDiffusers; ++i)
+	{
+		readLine(i, lines[i].length, readChunk, numSamples);
+		processAllPass(i, inputDiffusion[i], readChunk, diffused, numSamples);
+	}
+
+	// The LFO only runs at control rate, the modulated delays ramp linearly between chunk boundaries.
+	// The halves use quadrature phases.
+	const float endPhase = lfoPhase + lfoIncrement * numSamples;
+	const float halfPi = static_cast<float>(double_Pi * 0.5);
+
+	processTankHalf(0, excursion * std::sin(lfoPhase), excursion * std::sin(endPhase), numSamples);
+	processTankHalf(1, excursion * std::sin(lfoPhase + halfPi), excursion * std::sin(endPhase + halfPi), numSamples);
+
+	lfoPhase = (endPhase >= float_Pi * 2.0f) ? endPhase - float_Pi * 2.0f : endPhase;
+
+	// Taps read behind this chunk's writes, so any offset shorter than the chunk is valid too
+	processOutputTaps(0, wetChunks[0], numSamples);
+	processOutputTaps(1, wetChunks[1], numSamples);
+
+	writePosition = (writePosition + numSamples) & writeMask;
+
+	FloatVectorOperations::multiply(leftData, dryGain, numSamples);
+	FloatVectorOperations::addWithMultiply(leftData, wetChunks[0], wetGain, numSamples);
+	FloatVectorOperations::multiply(rightData, dryGain, numSamples);
+	FloatVectorOperations::addWithMultiply(rightData, wetChunks[1], wetGain, numSamples);
+}
+
+void PlateReverb::processTankHalf(int half, float startOffset, float endOffset, int numSamples) noexcept
+{
+	const int base = (half == 0) ? leftTank : rightTank;
+	const int crossLine = ((half == 0) ? rightTank : leftTank) + secondDelay;
+
+	// Input is the diffused signal plus the decayed output of the other half.  Every tank line is
+	// longer than a chunk, so it makes no difference which half runs first.
+	readLine(crossLine, lines[crossLine].length, tankChunk, numSamples);
+	FloatVectorOperations::multiply(tankChunk, decayGain, numSamples);
+	FloatVectorOperations::add(tankChunk, diffused, numSamples);
+
+	const int modulatedLine = base + modulatedAllPass;
+	const float length = static_cast<float>(lines[modulatedLine].length);
+	readModulated(modulatedLine, length + startOffset, length + endOffset, readChunk, numSamples);
+	processAllPass(modulatedLine, decayDiffusion1, readChunk, tankChunk, numSamples);
+
+	readLine(base + firstDelay, lines[base + firstDelay].length, readChunk, numSamples);
+	writeLine(base + firstDelay, tankChunk, numSamples);
+
+	// Damping lowpass, then the decay gain
+	const float dampingGain = 1.0f - dampingCoeff;
+	float state = dampingStates[half];
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		state = readChunk[i] * dampingGain + state * dampingCoeff;
+		tankChunk[i] = state * decayGain;
+	}
+
+	if (!(state < -1.0e-8f || state > 1.0e-8f)) state = 0.0f;
+	dampingStates[half] = state;
+
+	readLine(base + tankAllPass, lines[base + tankAllPass].length, readChunk, numSamples);
+	processAllPass(base + tankAllPass, decayDiffusion2, readChunk, tankChunk, numSamples);
+
+	writeLine(base + secondDelay, tankChunk, numSamples);
+}
+
+void PlateReverb::processOutputTaps(int channel, float* dest, int numSamples) noexcept
+{
+	FloatVectorOperations::clear(dest, numSamples);
+
+	for (int i = 0; i < numOutputTaps; ++i)
+	{
+		const OutputTap& tap = outputTaps[channel][i];
+
+		readLine(tap.line, tap.offset, readChunk, numSamples);
+		FloatVectorOperations::addWithMultiply(dest, readChunk, tap.gain, numSamples);
+	}
+}
+
+void PlateReverb::processAllPass(int lineIndex, float gain, const float* delayed, float* data, int numSamples) noexcept
+{
+	FloatVectorOperations::copy(allPassChunk, data, numSamples);
+	FloatVectorOperations::addWithMultiply(allPassChunk, delayed, gain, numSamples);
+	writeLine(lineIndex, allPassChunk, numSamples);
+
+	FloatVectorOperations::copy(data, delayed, numSamples);
+	FloatVectorOperations::addWithMultiply(data, allPassChunk, -gain, numSamples);
+}
+
+void PlateReverb::readLine(int lineIndex, int delay, float* dest, int numSamples) const noexcept
+{
+	const DelayLine& line = lines[lineIndex];
+	const int capacity = line.mask + 1;
+	const int readPosition = (writePosition - delay) & line.mask;
+	const int firstPart = jmin(numSamples, capacity - readPosition);
+
+	FloatVectorOperations::copy(dest, line.data + readPosition, firstPart);
+
+	if (firstPart < numSamples)
+		FloatVectorOperations::copy(dest + firstPart, line.data, numSamples - firstPart);
+}
+
+void PlateReverb::writeLine(int lineIndex, const float* src, int numSamples) noexcept
+{
+	const DelayLine& line = lines[lineIndex];
+	const int capacity = line.mask + 1;
+	const int position = writePosition & line.mask;
+	const int firstPart = jmin(numSamples, capacity - position);
+
+	FloatVectorOperations::copy(line.data + position, src, firstPart);
+
+	if (firstPart < numSamples)
+		FloatVectorOperations::copy(line.data, src + firstPart, numSamples - firstPart);
+}
+
+void PlateReverb::readModulated(int lineIndex, float startDelay, float endDelay, float* dest, int numSamples) const noexcept
+{
+	// Sample i reads at writePosition + i - delay(i).  Over one chunk those positions only cover
+	// numSamples plus the delay change, so copy that span once and interpolate without any wrapping.
+	const float delayStep = (endDelay - startDelay) / numSamples;
+	const float firstPosition = -startDelay;
+	const float lastPosition = (numSamples - 1) - (startDelay + delayStep * (numSamples - 1));
+	const int spanStart = static_cast<int>(std::floor(jmin(firstPosition, lastPosition)));
+	const int spanLength = static_cast<int>(std::floor(jmax(firstPosition, lastPosition))) + 2 - spanStart;
+
+	jassert(spanLength <= maxChunkSize + spanPadding);
+	jassert(spanStart + spanLength <= 0);	// Never reads samples this chunk has not written yet
+
+	readLine(lineIndex, -spanStart, spanChunk, spanLength);
+
+	const float positionStep = 1.0f - delayStep;
+	float position = firstPosition - spanStart;
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		const int index = jlimit(0, spanLength - 2, static_cast<int>(position));
+		const float fraction = position - index;
+
+		dest[i] = spanChunk[index] + fraction * (spanChunk[index + 1] - spanChunk[index]);
+		position += positionStep;
+	}
+}
+
+} // namespace Zen
@@ -0,0 +1,133 @@
+/*==============================================================================
+//  PlateReverb.h
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Dattorro figure-eight plate reverb processed in blocks, with
+//  control-rate modulation of the tank allpasses
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#ifndef ZEN_PLATE_REVERB_H_INCLUDED
+#define ZEN_PLATE_REVERB_H_INCLUDED
+
+#include "JuceHeader.h"
+
+namespace Zen
+{
+
+/// <summary> Plate reverb after Dattorro, "Effect Design Part 1" (JAES, 1997): input bandwidth filter,
+/// four input diffusers, then a figure-eight tank of two halves (modulated allpass, delay, damping,
+/// allpass, delay) each feeding the other, with seven output taps per channel.
+///
+/// Everything runs on chunks no longer than the shortest delay in the signal path, so each stage reads
+/// its delayed samples for the whole chunk as one contiguous segment before writing, and every stage
+/// except the two one-pole filters is a vector operation over the chunk.  The tank LFO is evaluated once
+/// per chunk; the modulated delays are interpolated linearly between those control points and read from
+/// one contiguous span per chunk. </summary>
+class PlateReverb
+{
+public:
+	enum
+	{
+		numInputDiffusers = 4,
+		numTankLines = 4,	///< Per tank half: modulated allpass, delay, allpass, delay
+		numLines = numInputDiffusers + 2 * numTankLines,
+		numOutputTaps = 7,
+		maxChunkSize = 128,	///< Internal sub-block size and LFO control period; also bounded by the shortest delay
+		spanPadding = 8		///< Extra samples a modulated read may span beyond the chunk length
+	};
+
+	PlateReverb();
+	~PlateReverb();
+
+	/// <summary> Allocates all delay and scratch memory for the largest size.  Must be called before
+	/// processing, and is the only place this class allocates. </summary>
+	void prepare(double inSampleRate);
+
+	/// <summary> Frees all delay memory. </summary>
+	void release();
+
+	/// <summary> Clears the delay lines, filter states and LFO without reallocating. </summary>
+	void reset() noexcept;
+
+	/// <summary> Sets the normalized (0.0 to 1.0) engine parameters.  Cheap to call every block,
+	/// coefficients are only recomputed when a value actually changes. </summary>
+	/// <param name="inSize">    Scales the tank delays and output taps </param>
+	/// <param name="inDecay">   Decay time, same RT60 mapping as FDNReverb </param>
+	/// <param name="inDamping"> High frequency damping inside the tank </param>
+	/// <param name="inMix">     Dry/Wet mix, 0.0 -> dry only, 1.0 -> wet only </param>
+	void setParameters(float inSize, float inDecay, float inDamping, float inMix) noexcept;
+
+	/// <summary> Processes a stereo block in place.  The input is summed to mono, the plate output is stereo. </summary>
+	void processStereo(float* leftData, float* rightData, int numSamples) noexcept;
+
+	/// <summary> Returns the current RT60 in seconds </summary>
+	double getTailLengthSeconds() const { return rt60; }
+
+private:
+	struct DelayLine
+	{
+		float* data;
+		int mask;
+		int length;		///< Current delay in samples, scaled by size
+	};
+
+	struct OutputTap
+	{
+		int line;
+		int offset;		///< Samples behind the write position, scaled by size
+		float gain;
+	};
+
+	void updateDelayLengths() noexcept;
+	void updateDecayGain() noexcept;
+	void processChunk(float* leftData, float* rightData, int numSamples) noexcept;
+	void processTankHalf(int half, float startOffset, float endOffset, int numSamples) noexcept;
+	void processOutputTaps(int channel, float* dest, int numSamples) noexcept;
+
+	void readLine(int lineIndex, int delay, float* dest, int numSamples) const noexcept;
+	void writeLine(int lineIndex, const float* src, int numSamples) noexcept;
+
+	/// <summary> Reads with a delay that moves linearly from startDelay to endDelay across the chunk </summary>
+	void readModulated(int lineIndex, float startDelay, float endDelay, float* dest, int numSamples) const noexcept;
+
+	/// <summary> v = x + g * delayed;  y = delayed - g * v.  delayed must already hold the line's
+	/// output for this chunk, data holds x on entry and y on return. </summary>
+	void processAllPass(int lineIndex, float gain, const float* delayed, float* data, int numSamples) noexcept;
+
+	HeapBlock<float> delayMemory;	///< Every line, each with its own power of two capacity
+	HeapBlock<float> scratchMemory;
+	float* diffused = nullptr;		///< Input after bandwidth filter and diffusers
+	float* tankChunk = nullptr;		///< Working buffer for one tank half
+	float* readChunk = nullptr;		///< Delayed samples read from a line
+	float* spanChunk = nullptr;		///< Contiguous span behind a modulated read
+	float* allPassChunk = nullptr;
+	float* wetChunks[2];
+
+	DelayLine lines[numLines];
+	OutputTap outputTaps[2][numOutputTaps];
+	int writePosition = 0, writeMask = 0;
+	int chunkLimit = 1;
+
+	float bandwidthState = 0.0f;
+	float dampingStates[2];
+	float lfoPhase = 0.0f, lfoIncrement = 0.0f;	///< Phase advance per chunk sample, radians
+	float excursion = 0.0f;		///< Modulation depth in samples
+
+	float dampingCoeff = 0.0f, decayGain = 0.5f;
+	float dryGain = 1.0f, wetGain = 0.0f;
+
+	float size = -1.0f, decay = -1.0f, damping = -1.0f, mix = -1.0f;
+	double sampleRate = 44100.0, rt60 = 0.0;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PlateReverb);
+};
+
+} // namespace Zen
+#endif // ZEN_PLATE_REVERB_H_INCLUDED
@@ -0,0 +1,506 @@
+/*==============================================================================
+//  VectorFreeverb.cpp
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Freeverb-class room reverb with the comb bank run as SIMD lanes
+//  and the allpasses vectorised over time
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#include "VectorFreeverb.h"
+#include "../../utilities/ZenUtils.hpp"
+#include "../../utilities/ZenSIMD.hpp"
+#include <cmath>
+
+namespace Zen
+{
+
+namespace
+{
+// Freeverb tunings at 44100Hz, identical to juce::Reverb
+const short combTunings[VectorFreeverb::numCombs] = { 1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617 };
+const short allPassTunings[VectorFreeverb::numAllPasses] = { 556, 441, 341, 225 };
+const int stereoSpread = 23;
+
+const float wetScaleFactor = 3.0f;
+const float dryScaleFactor = 2.0f;
+const float roomScaleFactor = 0.28f;
+const float roomOffset = 0.7f;
+const float dampScaleFactor = 0.4f;
+const float allPassFeedback = 0.5f;
+const double smoothTime = 0.01;
+
+bool isFrozen(float freezeMode) noexcept { return freezeMode >= 0.5f; }
+}
+
+//==============================================================================
+void VectorFreeverb::SmoothedValue::reset(double inSampleRate, double fadeLengthSeconds) noexcept
+{
+	stepsToTarget = static_cast<int>(std::floor(fadeLengthSeconds * inSampleRate));
+	currentValue = target;
+	countdown = 0;
+}
+
+void VectorFreeverb::SmoothedValue::setValue(float newValue) noexcept
+{
+	if (target == newValue) return;
+
+	target = newValue;
+	countdown = stepsToTarget;
+
+	if (countdown <= 0)
+		currentValue = target;
+	else
+		step = (target - currentValue) / static_cast<float>(countdown);
+}
+
+void VectorFreeverb::SmoothedValue::fill(float* dest, int numSamples) noexcept
+{
+	int i = 0;
+
+	for (; i < numSamples && countdown > 0; ++i)
+	{
+		--countdown;
+		currentValue += step;
+		dest[i] = currentValue;
+	}
+
+	if (i < numSamples)
+		FloatVectorOperations::fill(dest + i, target, numSamples - i);
+}
+
+//==============================================================================
+VectorFreeverb::VectorFreeverb()
+{
+	for (int i = 0; i < numCombLanes; ++i)
+		combLengths[i] = 1;
+
+	for (int i = 0; i < numAllPassLines; ++i)
+		allPassLengths[i] = 1;
+
+	for (int channel = 0; channel < numChannels; ++channel)
+		wetChunks[channel] = nullptr;
+
+	for (int i = 0; i < 3; ++i)
+		gainChunks[i] = nullptr;
+
+	setParameters(Reverb::Parameters());
+}
+
+VectorFreeverb::~VectorFreeverb()
+{
+	release();
+}
+
+void VectorFreeverb::prepare(double inSampleRate)
+{
+	jassert(inSampleRate > 0);
+
+	release();
+	sampleRate = inSampleRate;
+
+	// Same integer rounding as juce::Reverb::setSampleRate() so the two sound identical
+	const int intSampleRate = static_cast<int>(sampleRate);
+
+	for (int channel = 0; channel < numChannels; ++channel)
+	{
+		const int spread = channel * stereoSpread;
+
+		for (int i = 0; i < numCombs; ++i)
+			combLengths[channel * numCombs + i] = jmax(1, (intSampleRate * (combTunings[i] + spread)) / 44100);
+
+		for (int i = 0; i < numAllPasses; ++i)
+			allPassLengths[channel * numAllPasses + i] = jmax(1, (intSampleRate * (allPassTunings[i] + spread)) / 44100);
+	}
+
+	// The last right channel comb is the longest delay, the last left allpass the shortest
+	chunkLimit = jmin(static_cast<int>(maxChunkSize), allPassLengths[numAllPasses - 1]);
+	lineCapacity = nextPowerOfTwo(combLengths[numCombLanes - 1] + maxChunkSize);
+	lineMask = lineCapacity - 1;
+
+	combMemoryBlock.allocate(static_cast<size_t>((lineCapacity + maxChunkSize) * numCombLanes + 8), true);
+	combMemory = getAligned32(combMemoryBlock);
+	allPassMemory.allocate(static_cast<size_t>(numAllPassLines * lineCapacity), true);
+
+	// Comb states first so they stay 16 byte aligned, then the plain chunk buffers
+	scratchMemory.allocate(static_cast<size_t>(numCombLanes + 10 * maxChunkSize + 4), true);
+
+	float* scratch = getAligned16(scratchMemory);
+	combStates = scratch;			scratch += numCombLanes;
+	lineTemp = scratch;				scratch += maxChunkSize;
+	allPassTemp = scratch;			scratch += maxChunkSize;
+	inputChunk = scratch;			scratch += maxChunkSize;
+	dampingChunk = scratch;			scratch += maxChunkSize;
+	feedbackChunk = scratch;		scratch += maxChunkSize;
+
+	for (int channel = 0; channel < numChannels; ++channel)
+	{
+		wetChunks[channel] = scratch;
+		scratch += maxChunkSize;
+	}
+
+	for (int i = 0; i < 3; ++i)
+	{
+		gainChunks[i] = scratch;
+		scratch += maxChunkSize;
+	}
+
+	damping.reset(sampleRate, smoothTime);
+	feedback.reset(sampleRate, smoothTime);
+	dryGain.reset(sampleRate, smoothTime);
+	wetGain1.reset(sampleRate, smoothTime);
+	wetGain2.reset(sampleRate, smoothTime);
+
+	reset();
+}
+
+void VectorFreeverb::release()
+{
+	combMemoryBlock.free();
+	allPassMemory.free();
+	scratchMemory.free();
+	combMemory = combStates = nullptr;
+	lineTemp = allPassTemp = inputChunk = dampingChunk = feedbackChunk = nullptr;
+
+	for (int channel = 0; channel < numChannels; ++channel)
+		wetChunks[channel] = nullptr;
+
+	for (int i = 0; i < 3; ++i)
+		gainChunks[i] = nullptr;
+
+	lineCapacity = lineMask = writePosition = 0;
+}
+
+void VectorFreeverb::reset() noexcept
+{
+	if (combMemory == nullptr) return;
+
+	FloatVectorOperations::clear(combMemory, (lineCapacity + maxChunkSize) * numCombLanes);
+	FloatVectorOperations::clear(allPassMemory, numAllPassLines * lineCapacity);
+	FloatVectorOperations::clear(combStates, numCombLanes);
+	writePosition = 0;
+}
+
+void VectorFreeverb::setParameters(const Reverb::Parameters& newParameters) noexcept
+{
+	const float wet = newParameters.wetLevel * wetScaleFactor;
+	dryGain.setValue(newParameters.dryLevel * dryScaleFactor);
+	wetGain1.setValue(0.5f * wet * (1.0f + newParameters.width));
+	wetGain2.setValue(0.5f * wet * (1.0f - newParameters.width));
+	inputGain = isFrozen(newParameters.freezeMode) ? 0.0f : 0.015f;
+	parameters = newParameters;
+
+	if (isFrozen(parameters.freezeMode))
+	{
+		damping.setValue(0.0f);
+		feedback.setValue(1.0f);
+	}
+	else
+	{
+		damping.setValue(parameters.damping * dampScaleFactor);
+		feedback.setValue(parameters.roomSize * roomScaleFactor + roomOffset);
+	}
+}
+
+void VectorFreeverb::setParameters(float inSize, float inDecay, float inDamping, float inMix) noexcept
+{
+	const float mix = getClamped(inMix, 0.0f, 1.0f);
+
+	Reverb::Parameters newParameters;
+	newParameters.roomSize = getClamped(inDecay, 0.0f, 1.0f);
+	newParameters.damping = getClamped(inDamping, 0.0f, 1.0f);
+	newParameters.width = getClamped(inSize, 0.0f, 1.0f);
+	newParameters.wetLevel = mix / wetScaleFactor;
+	newParameters.dryLevel = (1.0f - mix) / dryScaleFactor;
+
+	// Ramps only restart for values that actually changed
+	setParameters(newParameters);
+}
+
+double VectorFreeverb::getTailLengthSeconds() const
+{
+	const double longestComb = combLengths[numCombLanes - 1] / sampleRate;
+	const double gain = jmin(0.9999, static_cast<double>(feedback.getTarget()));
+
+	// Each trip round the longest comb loses -20log10(gain) dB
+	return 3.0 * longestComb / -std::log10(gain);
+}
+
+void VectorFreeverb::processStereo(float* leftData, float* rightData, int numSamples) noexcept
+{
+	if (combMemory == nullptr) return;
+
+	while (numSamples > 0)
+	{
+		const int chunkSize = jmin(numSamples, chunkLimit);
+		processChunk(leftData, rightData, chunkSize);
+
+		leftData += chunkSize;
+		rightData += chunkSize;
+		numSamples -= chunkSize;
+	}
+}
+
+void VectorFreeverb::processChunk(float* leftData, float* rightData, int numSamples) noexcept
+{
+	FloatVectorOperations::copy(inputChunk, leftData, numSamples);
+	FloatVectorOperations::add(inputChunk, rightData, numSamples);
+	FloatVectorOperations::multiply(inputChunk, inputGain, numSamples);
+
+	damping.fill(dampingChunk, numSamples);
+	feedback.fill(feedbackChunk, numSamples);
+
+	processCombLanes(numSamples);
+
+	for (int channel = 0; channel < numChannels; ++channel)
+		processAllPasses(channel, wetChunks[channel], numSamples);
+
+	writePosition = (writePosition + numSamples) & lineMask;
+
+	mixOutput(leftData, rightData, numSamples);
+}
+
+void VectorFreeverb::processCombLanes(int numSamples) noexcept
+{
+	// Comb output is the delayed sample, summed per channel.  Then per lane:
+	// last = delayed * (1 - damp) + last * damp;  written = input + last * feedback
+	float* const wetLeft = wetChunks[0];
+	float* const wetRight = wetChunks[1];
+
+	// Each lane reads its own delay.  Thanks to the mirrored frames a lane's reads never wrap in a chunk.
+	const float* reads[numCombLanes];
+
+	for (int lane = 0; lane < numCombLanes; ++lane)
+		reads[lane] = combMemory + ((writePosition - combLengths[lane]) & lineMask) * numCombLanes + lane;
+
+#if ZEN_USE_AVX_INTRINSICS
+	static_assert(numCombLanes == 16, "The AVX comb loop is unrolled for 16 lanes");
+
+	// Every lane reads the same frame of its own delay, so one set of offsets from each step's frame serves the
+	// whole chunk and a channel's reads are a single gather
+	int laneOffsets[numCombLanes];
+
+	for (int lane = 0; lane < numCombLanes; ++lane)
+		laneOffsets[lane] = static_cast<int>(reads[lane] - combMemory);
+
+	const __m256i offsets0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(laneOffsets));
+	const __m256i offsets1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(laneOffsets + 8));
+
+	const __m256 one = _mm256_set1_ps(1.0f);
+	__m256 state0 = _mm256_loadu_ps(combStates);
+	__m256 state1 = _mm256_loadu_ps(combStates + 8);
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		const float* const frame = combMemory + i * numCombLanes;
+		const int writeFrame = (writePosition + i) & lineMask;
+		float* const writes = combMemory + writeFrame * numCombLanes;
+
+		// Lanes 0-7 are the left combs, 8-15 the right
+		const __m256 read0 = _mm256_i32gather_ps(frame, offsets0, 4);
+		const __m256 read1 = _mm256_i32gather_ps(frame, offsets1, 4);
+
+		__m128 left = _mm_add_ps(_mm256_castps256_ps128(read0), _mm256_extractf128_ps(read0, 1));
+		__m128 right = _mm_add_ps(_mm256_castps256_ps128(read1), _mm256_extractf128_ps(read1, 1));
+		left = _mm_add_ps(left, _mm_movehl_ps(left, left));
+		right = _mm_add_ps(right, _mm_movehl_ps(right, right));
+		wetLeft[i] = _mm_cvtss_f32(_mm_add_ss(left, _mm_shuffle_ps(left, left, 1)));
+		wetRight[i] = _mm_cvtss_f32(_mm_add_ss(right, _mm_shuffle_ps(right, right, 1)));
+
+		const __m256 damp = _mm256_set1_ps(dampingChunk[i]);
+		const __m256 undamp = _mm256_sub_ps(one, damp);
+		const __m256 gain = _mm256_set1_ps(feedbackChunk[i]);
+		const __m256 input = _mm256_set1_ps(inputChunk[i]);
+
+		state0 = _mm256_add_ps(_mm256_mul_ps(read0, undamp), _mm256_mul_ps(state0, damp));
+		state1 = _mm256_add_ps(_mm256_mul_ps(read1, undamp), _mm256_mul_ps(state1, damp));
+
+		const __m256 write0 = _mm256_add_ps(input, _mm256_mul_ps(state0, gain));
+		const __m256 write1 = _mm256_add_ps(input, _mm256_mul_ps(state1, gain));
+
+		_mm256_store_ps(writes, write0);
+		_mm256_store_ps(writes + 8, write1);
+
+		if (writeFrame < maxChunkSize)
+		{
+			float* const mirror = writes + lineCapacity * numCombLanes;
+			_mm256_store_ps(mirror, write0);
+			_mm256_store_ps(mirror + 8, write1);
+		}
+	}
+
+	_mm256_storeu_ps(combStates, state0);
+	_mm256_storeu_ps(combStates + 8, state1);
+#elif ZEN_USE_SSE_INTRINSICS
+	static_assert(numCombLanes == 16, "The SSE comb loop is unrolled for 16 lanes");
+
+	const __m128 one = _mm_set1_ps(1.0f);
+	__m128 state0 = _mm_load_ps(combStates);
+	__m128 state1 = _mm_load_ps(combStates + 4);
+	__m128 state2 = _mm_load_ps(combStates + 8);
+	__m128 state3 = _mm_load_ps(combStates + 12);
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		const int frame = i * numCombLanes;
+		const int writeFrame = (writePosition + i) & lineMask;
+		float* const writes = combMemory + writeFrame * numCombLanes;
+
+		const __m128 read0 = _mm_setr_ps(reads[0][frame], reads[1][frame], reads[2][frame], reads[3][frame]);
+		const __m128 read1 = _mm_setr_ps(reads[4][frame], reads[5][frame], reads[6][frame], reads[7][frame]);
+		const __m128 read2 = _mm_setr_ps(reads[8][frame], reads[9][frame], reads[10][frame], reads[11][frame]);
+		const __m128 read3 = _mm_setr_ps(reads[12][frame], reads[13][frame], reads[14][frame], reads[15][frame]);
+
+		// Lanes 0-7 are the left combs, 8-15 the right
+		__m128 left = _mm_add_ps(read0, read1);
+		__m128 right = _mm_add_ps(read2, read3);
+		left = _mm_add_ps(left, _mm_movehl_ps(left, left));
+		right = _mm_add_ps(right, _mm_movehl_ps(right, right));
+		wetLeft[i] = _mm_cvtss_f32(_mm_add_ss(left, _mm_shuffle_ps(left, left, 1)));
+		wetRight[i] = _mm_cvtss_f32(_mm_add_ss(right, _mm_shuffle_ps(right, right, 1)));
+
+		const __m128 damp = _mm_set1_ps(dampingChunk[i]);
+		const __m128 undamp = _mm_sub_ps(one, damp);
+		const __m128 gain = _mm_set1_ps(feedbackChunk[i]);
+		const __m128 input = _mm_set1_ps(inputChunk[i]);
+
+		state0 = _mm_add_ps(_mm_mul_ps(read0, undamp), _mm_mul_ps(state0, damp));
+		state1 = _mm_add_ps(_mm_mul_ps(read1, undamp), _mm_mul_ps(state1, damp));
+		state2 = _mm_add_ps(_mm_mul_ps(read2, undamp), _mm_mul_ps(state2, damp));
+		state3 = _mm_add_ps(_mm_mul_ps(read3, undamp), _mm_mul_ps(state3, damp));
+
+		const __m128 write0 = _mm_add_ps(input, _mm_mul_ps(state0, gain));
+		const __m128 write1 = _mm_add_ps(input, _mm_mul_ps(state1, gain));
+		const __m128 write2 = _mm_add_ps(input, _mm_mul_ps(state2, gain));
+		const __m128 write3 = _mm_add_ps(input, _mm_mul_ps(state3, gain));
+
+		_mm_store_ps(writes, write0);
+		_mm_store_ps(writes + 4, write1);
+		_mm_store_ps(writes + 8, write2);
+		_mm_store_ps(writes + 12, write3);
+
+		if (writeFrame < maxChunkSize)
+		{
+			float* const mirror = writes + lineCapacity * numCombLanes;
+			_mm_store_ps(mirror, write0);
+			_mm_store_ps(mirror + 4, write1);
+			_mm_store_ps(mirror + 8, write2);
+			_mm_store_ps(mirror + 12, write3);
+		}
+	}
+
+	_mm_store_ps(combStates, state0);
+	_mm_store_ps(combStates + 4, state1);
+	_mm_store_ps(combStates + 8, state2);
+	_mm_store_ps(combStates + 12, state3);
+#else
+	for (int i = 0; i < numSamples; ++i)
+	{
+		const int frame = i * numCombLanes;
+		const int writeFrame = (writePosition + i) & lineMask;
+		float* const writes = combMemory + writeFrame * numCombLanes;
+		const float damp = dampingChunk[i];
+		const float undamp = 1.0f - damp;
+
+		wetLeft[i] = wetRight[i] = 0.0f;
+
+		for (int lane = 0; lane < numCombLanes; ++lane)
+		{
+			const float delayed = reads[lane][frame];
+			(lane < numCombs ? wetLeft : wetRight)[i] += delayed;
+			combStates[lane] = delayed * undamp + combStates[lane] * damp;
+			writes[lane] = inputChunk[i] + combStates[lane] * feedbackChunk[i];
+		}
+
+		if (writeFrame < maxChunkSize)
+			FloatVectorOperations::copy(writes + lineCapacity * numCombLanes, writes, numCombLanes);
+	}
+#endif
+
+	// Flush states that decayed into the denormal range once per chunk instead of every sample
+	for (int lane = 0; lane < numCombLanes; ++lane)
+		if (!(combStates[lane] < -1.0e-8f || combStates[lane] > 1.0e-8f)) combStates[lane] = 0.0f;
+}
+
+void VectorFreeverb::processAllPasses(int channel, float* data, int numSamples) noexcept
+{
+	// Chunks are no longer than any allpass delay, so each one is a pure vector operation:
+	// written = input + delayed * 0.5, output = delayed - input
+	for (int i = 0; i < numAllPasses; ++i)
+	{
+		const int lineIndex = channel * numAllPasses + i;
+
+		readAllPass(lineIndex, lineTemp, numSamples);
+
+		FloatVectorOperations::copy(allPassTemp, data, numSamples);
+		FloatVectorOperations::addWithMultiply(allPassTemp, lineTemp, allPassFeedback, numSamples);
+		writeAllPass(lineIndex, allPassTemp, numSamples);
+
+		FloatVectorOperations::subtract(data, lineTemp, data, numSamples);
+	}
+}
+
+void VectorFreeverb::mixOutput(float* leftData, float* rightData, int numSamples) noexcept
+{
+	const float* const wetLeft = wetChunks[0];
+	const float* const wetRight = wetChunks[1];
+
+	if (!dryGain.isSmoothing() && !wetGain1.isSmoothing() && !wetGain2.isSmoothing())
+	{
+		const float dry = dryGain.getTarget(), wet1 = wetGain1.getTarget(), wet2 = wetGain2.getTarget();
+
+		FloatVectorOperations::multiply(leftData, dry, numSamples);
+		FloatVectorOperations::addWithMultiply(leftData, wetLeft, wet1, numSamples);
+		FloatVectorOperations::addWithMultiply(leftData, wetRight, wet2, numSamples);
+
+		FloatVectorOperations::multiply(rightData, dry, numSamples);
+		FloatVectorOperations::addWithMultiply(rightData, wetRight, wet1, numSamples);
+		FloatVectorOperations::addWithMultiply(rightData, wetLeft, wet2, numSamples);
+		return;
+	}
+
+	float* const dry = gainChunks[0];
+	float* const wet1 = gainChunks[1];
+	float* const wet2 = gainChunks[2];
+
+	dryGain.fill(dry, numSamples);
+	wetGain1.fill(wet1, numSamples);
+	wetGain2.fill(wet2, numSamples);
+
+	for (int i = 0; i < numSamples; ++i)
+	{
+		leftData[i] = wetLeft[i] * wet1[i] + wetRight[i] * wet2[i] + leftData[i] * dry[i];
+		rightData[i] = wetRight[i] * wet1[i] + wetLeft[i] * wet2[i] + rightData[i] * dry[i];
+	}
+}
+
+void VectorFreeverb::readAllPass(int lineIndex, float* dest, int numSamples) const noexcept
+{
+	const float* const line = allPassMemory + lineIndex * lineCapacity;
+	const int readPosition = (writePosition - allPassLengths[lineIndex]) & lineMask;
+	const int firstPart = jmin(numSamples, lineCapacity - readPosition);
+
+	FloatVectorOperations::copy(dest, line + readPosition, firstPart);
+
+	if (firstPart < numSamples)
+		FloatVectorOperations::copy(dest + firstPart, line, numSamples - firstPart);
+}
+
+void VectorFreeverb::writeAllPass(int lineIndex, const float* src, int numSamples) noexcept
+{
+	float* const line = allPassMemory + lineIndex * lineCapacity;
+	const int firstPart = jmin(numSamples, lineCapacity - writePosition);
+
+	FloatVectorOperations::copy(line + writePosition, src, firstPart);
+
+	if (firstPart < numSamples)
+		FloatVectorOperations::copy(line, src + firstPart, numSamples - firstPart);
+}
+
+} // namespace Zen
@@ -0,0 +1,133 @@
+/*==============================================================================
+//  VectorFreeverb.h
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Freeverb-class room reverb with the comb bank run as SIMD lanes
+//  and the allpasses vectorised over time
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#ifndef ZEN_VECTOR_FREEVERB_H_INCLUDED
+#define ZEN_VECTOR_FREEVERB_H_INCLUDED
+
+#include "JuceHeader.h"
+
+namespace Zen
+{
+
+/// <summary> Same tunings, gains and parameter smoothing as juce::Reverb (Freeverb), processed in chunks.
+///
+/// Chunks are never longer than the shortest delay, so every sample a chunk reads from a delay line
+/// was written by an earlier chunk.  The 16 combs (8 per channel) are structure-of-arrays lanes
+/// sharing one interleaved delay memory, one 16 float frame per sample.  Each sample step gathers
+/// the 16 delayed samples, then runs the damping lowpass and feedback across all lanes at once and
+/// writes the new frame with aligned vector stores.  The first maxChunkSize frames are mirrored past
+/// the end of the memory so no lane's reads ever wrap inside a chunk.  The series allpasses run as
+/// plain vector operations over the whole chunk.
+///
+/// AVX2 builds hold each channel's 8 combs in one 8 lane register and fetch them with a hardware
+/// gather; SSE builds use four 4 lane registers and load the delayed samples one by one, as SSE has
+/// no gather. </summary>
+class VectorFreeverb
+{
+public:
+	enum
+	{
+		numCombs = 8,
+		numAllPasses = 4,
+		numChannels = 2,
+		numCombLanes = numCombs * numChannels,
+		numAllPassLines = numAllPasses * numChannels,
+		maxChunkSize = 256	///< Internal sub-block size; also bounded by the shortest delay line
+	};
+
+	VectorFreeverb();
+	~VectorFreeverb();
+
+	/// <summary> Allocates all delay and scratch memory.  The only place this class allocates. </summary>
+	void prepare(double inSampleRate);
+
+	/// <summary> Frees all delay memory. </summary>
+	void release();
+
+	/// <summary> Clears every delay line and filter state without reallocating. </summary>
+	void reset() noexcept;
+
+	/// <summary> Applies parameters with exactly the meaning they have in juce::Reverb. </summary>
+	void setParameters(const Reverb::Parameters& newParameters) noexcept;
+
+	/// <summary> Sets the normalized (0.0 to 1.0) plugin parameters.  Cheap to call every block,
+	/// unchanged values keep their ramps. </summary>
+	/// <param name="inSize">    Stereo width, bigger rooms sound wider </param>
+	/// <param name="inDecay">   Freeverb room size, i.e. the comb feedback </param>
+	/// <param name="inDamping"> High frequency damping inside the comb feedback </param>
+	/// <param name="inMix">     Dry/Wet mix, 0.0 -> dry only, 1.0 -> wet only </param>
+	void setParameters(float inSize, float inDecay, float inDamping, float inMix) noexcept;
+
+	/// <summary> Processes a stereo block in place. </summary>
+	void processStereo(float* leftData, float* rightData, int numSamples) noexcept;
+
+	/// <summary> Approximate RT60 of the longest comb at the current feedback </summary>
+	double getTailLengthSeconds() const;
+
+	const Reverb::Parameters& getParameters() const noexcept { return parameters; }
+
+private:
+	/// <summary> Linear ramp with the same stepping as juce::Reverb's internal smoother, so both engines
+	/// produce the same gains sample for sample. </summary>
+	struct SmoothedValue
+	{
+		void reset(double inSampleRate, double fadeLengthSeconds) noexcept;
+		void setValue(float newValue) noexcept;
+		bool isSmoothing() const noexcept { return countdown > 0; }
+		float getTarget() const noexcept { return target; }
+
+		/// <summary> Writes the next numSamples values into dest </summary>
+		void fill(float* dest, int numSamples) noexcept;
+
+		float currentValue = 0.0f, target = 0.0f, step = 0.0f;
+		int countdown = 0, stepsToTarget = 0;
+	};
+
+	void processChunk(float* leftData, float* rightData, int numSamples) noexcept;
+	void processCombLanes(int numSamples) noexcept;
+	void processAllPasses(int channel, float* data, int numSamples) noexcept;
+	void mixOutput(float* leftData, float* rightData, int numSamples) noexcept;
+
+	void readAllPass(int lineIndex, float* dest, int numSamples) const noexcept;
+	void writeAllPass(int lineIndex, const float* src, int numSamples) noexcept;
+
+	HeapBlock<float> combMemoryBlock;	///< lineCapacity + maxChunkSize frames of numCombLanes samples
+	HeapBlock<float> allPassMemory;		///< numAllPassLines * lineCapacity samples, one contiguous block
+	HeapBlock<float> scratchMemory;		///< Chunk buffers, see prepare()
+	float* combMemory = nullptr;	///< combMemoryBlock aligned to 32 bytes, and so is every frame
+	float* combStates = nullptr;	///< numCombLanes damping lowpass states, 16 byte aligned
+	float* lineTemp = nullptr;
+	float* allPassTemp = nullptr;
+	float* inputChunk = nullptr;
+	float* dampingChunk = nullptr;
+	float* feedbackChunk = nullptr;
+	float* wetChunks[numChannels];
+	float* gainChunks[3];			///< dry, wet1, wet2 ramps
+
+	int lineCapacity = 0, lineMask = 0, writePosition = 0;
+	int combLengths[numCombLanes];
+	int allPassLengths[numAllPassLines];
+	int chunkLimit = 1;
+
+	Reverb::Parameters parameters;
+	SmoothedValue damping, feedback, dryGain, wetGain1, wetGain2;
+	float inputGain = 0.015f;
+	double sampleRate = 44100.0;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VectorFreeverb);
+};
+
+} // namespace Zen
+#endif // ZEN_VECTOR_FREEVERB_H_INCLUDED
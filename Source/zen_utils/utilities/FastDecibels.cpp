@@ -0,0 +1,187 @@
+/* ==============================================================================
+//  FastDecibels.cpp
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Fast decibel to gain conversion for the audio path
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#include "FastDecibels.h"
+#include "ZenSIMD.hpp"
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace Zen
+{
+
+namespace
+{
+const float decibelsToExponent = 0.16609640474436813f;	// log2(10) / 20
+const float minExponent = -126.0f, maxExponent = 127.0f;
+
+// Taylor coefficients ln(2)^k / k! of 2^f; on |f| <= 0.5 the first dropped term is below 1.2e-7
+const float exp2Coefficient1 = 0.69314718055994531f;
+const float exp2Coefficient2 = 0.24022650695910071f;
+const float exp2Coefficient3 = 0.05550410866482158f;
+const float exp2Coefficient4 = 0.00961812910762848f;
+const float exp2Coefficient5 = 0.00133335581464284f;
+const float exp2Coefficient6 = 0.00015403530393381f;
+
+//==============================================================================
+// The exp2 table is built by the compiler: e^x by its Taylor series, one single-return constexpr step per term
+constexpr double exponentialSeries(double x, double term = 1.0, int order = 1)
+{
+	return (order > 24) ? term : term + exponentialSeries(x, term * x / order, order + 1);
+}
+
+constexpr float exp2OfTableIndex(int index)
+{
+	return static_cast<float>(exponentialSeries(0.69314718055994531 * index / FastDecibels::tableSize));
+}
+
+template <int... Indices>
+struct Exp2Table
+{
+	static constexpr float values[sizeof...(Indices)] = { exp2OfTableIndex(Indices)... };
+};
+
+template <int... Indices>
+constexpr float Exp2Table<Indices...>::values[sizeof...(Indices)];
+
+template <int... Indices>
+constexpr const float* getExp2TableValues(std::integer_sequence<int, Indices...>)
+{
+	return Exp2Table<Indices...>::values;
+}
+
+/// <summary> 2^(i / tableSize) for i in 0 - tableSize </summary>
+const float* const exp2Table = getExp2TableValues(std::make_integer_sequence<int, FastDecibels::tableSize + 1>());
+
+//==============================================================================
+/// <summary> 2^exponent for an integer exponent inside the normal float range, straight from the bits </summary>
+inline float makePowerOfTwo(int exponent) noexcept
+{
+	const int32 bits = static_cast<int32>(exponent + 127) << 23;
+	float result;
+	std::memcpy(&result, &bits, sizeof(result));
+	return result;
+}
+
+/// <summary> 2^x from the polynomial, x already clamped </summary>
+inline float exp2Polynomial(float x) noexcept
+{
+	const float whole = std::floor(x + 0.5f);
+	const float f = x - whole;
+	const float p = 1.0f + f * (exp2Coefficient1 + f * (exp2Coefficient2 + f * (exp2Coefficient3
+		+ f * (exp2Coefficient4 + f * (exp2Coefficient5 + f * exp2Coefficient6)))));
+
+	return p * makePowerOfTwo(static_cast<int>(whole));
+}
+
+#if ZEN_USE_SSE_INTRINSICS
+/// <summary> The same polynomial four values at a time, x already clamped </summary>
+inline __m128 exp2Polynomial(__m128 x) noexcept
+{
+	// Rounds to nearest under the default MXCSR mode, which keeps the fraction in [-0.5, 0.5]
+	const __m128i whole = _mm_cvtps_epi32(x);
+	const __m128 f = _mm_sub_ps(x, _mm_cvtepi32_ps(whole));
+
+	__m128 p = _mm_add_ps(_mm_set1_ps(exp2Coefficient5), _mm_mul_ps(f, _mm_set1_ps(exp2Coefficient6)));
+	p = _mm_add_ps(_mm_set1_ps(exp2Coefficient4), _mm_mul_ps(f, p));
+	p = _mm_add_ps(_mm_set1_ps(exp2Coefficient3), _mm_mul_ps(f, p));
+	p = _mm_add_ps(_mm_set1_ps(exp2Coefficient2), _mm_mul_ps(f, p));
+	p = _mm_add_ps(_mm_set1_ps(exp2Coefficient1), _mm_mul_ps(f, p));
+	p = _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(f, p));
+
+	const __m128 scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(whole, _mm_set1_epi32(127)), 23));
+	return _mm_mul_ps(p, scale);
+}
+#endif
+}
+
+//==============================================================================
+float FastDecibels::exp2(float x) noexcept
+{
+	x = jlimit(minExponent, maxExponent, x);
+
+	const float whole = std::floor(x);
+	const float position = (x - whole) * tableSize;
+	const int index = jmin(static_cast<int>(position), static_cast<int>(tableSize) - 1);
+	const float fraction = position - index;
+	const float value = exp2Table[index] + fraction * (exp2Table[index + 1] - exp2Table[index]);
+
+	return value * makePowerOfTwo(static_cast<int>(whole));
+}
+
+float FastDecibels::decibelsToGain(float decibels, float minusInfinityDb) noexcept
+{
+	return (decibels > minusInfinityDb) ? exp2(decibels * decibelsToExponent) : 0.0f;
+}
+
+void FastDecibels::exp2(float* dest, const float* source, int numValues) noexcept
+{
+	int i = 0;
+
+#if ZEN_USE_SSE_INTRINSICS
+	const __m128 lowest = _mm_set1_ps(minExponent);
+	const __m128 highest = _mm_set1_ps(maxExponent);
+
+	for (; i + 4 <= numValues; i += 4)
+	{
+		const __m128 x = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + i), lowest), highest);
+		_mm_storeu_ps(dest + i, exp2Polynomial(x));
+	}
+#endif
+
+	for (; i < numValues; ++i)
+		dest[i] = exp2Polynomial(jlimit(minExponent, maxExponent, source[i]));
+}
+
+void FastDecibels::decibelsToGain(float* gains, const float* decibels, int numValues, float minusInfinityDb) noexcept
+{
+	int i = 0;
+
+#if ZEN_USE_SSE_INTRINSICS
+	const __m128 scale = _mm_set1_ps(decibelsToExponent);
+	const __m128 minusInfinity = _mm_set1_ps(minusInfinityDb);
+	const __m128 lowest = _mm_set1_ps(minExponent);
+	const __m128 highest = _mm_set1_ps(maxExponent);
+
+	for (; i + 4 <= numValues; i += 4)
+	{
+		const __m128 decibel = _mm_loadu_ps(decibels + i);
+		const __m128 x = _mm_min_ps(_mm_max_ps(_mm_mul_ps(decibel, scale), lowest), highest);
+		const __m128 audible = _mm_cmpgt_ps(decibel, minusInfinity);
+		_mm_storeu_ps(gains + i, _mm_and_ps(exp2Polynomial(x), audible));
+	}
+#endif
+
+	for (; i < numValues; ++i)
+	{
+		const float decibel = decibels[i];
+		gains[i] = (decibel > minusInfinityDb) ? exp2Polynomial(jlimit(minExponent, maxExponent, decibel * decibelsToExponent)) : 0.0f;
+	}
+}
+
+void FastDecibels::convertNormalizedToRange(float* dest, const float* source, int numValues,
+											float minOfRange, float maxOfRange, float midpointOfRange) noexcept
+{
+	// Both halves are straight lines through the midpoint, so one select per value and no branches
+	const float lowerSlope = 2.0f * (midpointOfRange - minOfRange);
+	const float upperSlope = 2.0f * (maxOfRange - midpointOfRange);
+
+	for (int i = 0; i < numValues; ++i)
+	{
+		const float offset = jlimit(0.0f, 1.0f, source[i]) - 0.5f;
+		dest[i] = midpointOfRange + offset * (offset > 0.0f ? upperSlope : lowerSlope);
+	}
+}
+
+} // namespace Zen
@@ -0,0 +1,71 @@
+/* ==============================================================================
+//  TripleBuffer.hpp
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Wait-free hand-over of a whole table from one writer thread to
+//  one reader thread, without allocating or locking
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#ifndef ZEN_TRIPLE_BUFFER_H_INCLUDED
+#define ZEN_TRIPLE_BUFFER_H_INCLUDED
+
+#include "JuceHeader.h"
+#include <atomic>
+
+namespace Zen
+{
+
+/// <summary> Publishes immutable copies of a T from a writer (normally the message thread) to a reader (normally the
+/// audio thread).  Three copies live inside the object: the writer fills its own, then swaps it into the middle
+/// slot with one atomic exchange; the reader swaps the middle slot with its own whenever something new is there.
+/// Neither side ever waits for the other, and the reader always sees a complete table, the latest one published.
+/// T is copied by assignment, so keep it to fixed-size data. </summary>
+template <typename T>
+class TripleBuffer
+{
+public:
+	TripleBuffer() noexcept
+		: middle(1), writeIndex(0), readIndex(2)
+	{
+	}
+
+	/// <summary> Makes newValue the table the reader gets next.  Writer thread only. </summary>
+	void publish(const T& newValue)
+	{
+		slots[writeIndex] = newValue;
+		writeIndex = middle.exchange(writeIndex | freshFlag, std::memory_order_acq_rel) & indexMask;
+	}
+
+	/// <summary> The latest published table.  Reader thread only; the reference stays valid, and unchanged, until
+	/// the reader's next call. </summary>
+	const T& read() noexcept
+	{
+		if ((middle.load(std::memory_order_relaxed) & freshFlag) != 0)
+			readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & indexMask;
+
+		return slots[readIndex];
+	}
+
+private:
+	enum
+	{
+		indexMask = 3,
+		freshFlag = 4
+	};
+
+	T slots[3];
+	std::atomic<int> middle;
+	int writeIndex, readIndex;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TripleBuffer)
+};
+
+} // namespace Zen
+#endif // ZEN_TRIPLE_BUFFER_H_INCLUDED
@@ -0,0 +1,119 @@
+/* ==============================================================================
+//  WorkStealingDeque.hpp
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Lock-free Chase-Lev deque of task indices, one owner pushing and
+//  popping at the bottom, any number of thieves stealing from the top
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#ifndef ZEN_WORK_STEALING_DEQUE_H_INCLUDED
+#define ZEN_WORK_STEALING_DEQUE_H_INCLUDED
+
+#include "JuceHeader.h"
+#include <atomic>
+
+namespace Zen
+{
+
+/// <summary> Chase-Lev work-stealing deque (Le, Pop, Cohen and Zappa Nardelli's C11 formulation) holding int task
+/// indices.  The owner thread push()es and pop()s at the bottom, LIFO; other threads steal() from the top, FIFO.
+/// None of them ever lock or allocate.
+///
+/// The capacity is fixed between setCapacity() calls and must cover the most tasks outstanding at once: push() on
+/// a full deque is a bug, not a resize. </summary>
+class WorkStealingDeque
+{
+public:
+	explicit WorkStealingDeque(int initialCapacity = 64)
+		: top(0), bottom(0)
+	{
+		setCapacity(initialCapacity);
+	}
+
+	/// <summary> Reallocates for at least minCapacity tasks and empties the deque.  Only while no thread is using it. </summary>
+	void setCapacity(int minCapacity)
+	{
+		capacity = nextPowerOfTwo(jmax(2, minCapacity));
+		items.calloc(static_cast<size_t>(capacity));
+		top.store(0, std::memory_order_relaxed);
+		bottom.store(0, std::memory_order_relaxed);
+	}
+
+	int getCapacity() const noexcept { return capacity; }
+
+	/// <summary> Adds a task at the bottom.  Owner only. </summary>
+	void push(int task) noexcept
+	{
+		const int64 b = bottom.load(std::memory_order_relaxed);
+		jassert(b - top.load(std::memory_order_acquire) < capacity);
+
+		items[b & (capacity - 1)].store(task, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		bottom.store(b + 1, std::memory_order_relaxed);
+	}
+
+	/// <summary> Takes the most recently pushed task.  Owner only. </summary>
+	bool pop(int& task) noexcept
+	{
+		const int64 b = bottom.load(std::memory_order_relaxed) - 1;
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64 t = top.load(std::memory_order_relaxed);
+
+		if (t > b)
+		{
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		task = items[b & (capacity - 1)].load(std::memory_order_relaxed);
+
+		if (t == b)
+		{
+			// Last task, race the thieves for it
+			const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return won;
+		}
+
+		return true;
+	}
+
+	/// <summary> Takes the oldest task.  Any thread; false when the deque is empty or another thread got there first. </summary>
+	bool steal(int& task) noexcept
+	{
+		int64 t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		const int64 b = bottom.load(std::memory_order_acquire);
+
+		if (t >= b)
+			return false;
+
+		task = items[t & (capacity - 1)].load(std::memory_order_relaxed);
+		return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+	}
+
+	/// <summary> Whether the deque held no tasks at the moment it was looked at.  Any thread, only a snapshot:
+	/// steal() failing on a deque that isn't empty means another thread won the race for the task. </summary>
+	bool isEmpty() const noexcept
+	{
+		return top.load(std::memory_order_acquire) >= bottom.load(std::memory_order_acquire);
+	}
+
+private:
+	HeapBlock<std::atomic<int>> items;
+	int capacity = 0;
+	std::atomic<int64> top, bottom;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WorkStealingDeque)
+};
+
+} // namespace Zen
+#endif // ZEN_WORK_STEALING_DEQUE_H_INCLUDED
@@ -0,0 +1,57 @@
+/* ==============================================================================
+//  ZenSIMD.hpp
+//  Part of the Zentropia JUCE Collection
+//  @author Casey Bailey (<a href="SonicZentropy@gmail.com">email</a>)
+//  @version 0.1
+//  @date 2026/10/16
+//  Copyright (C) 2015 by Casey Bailey
+//  Provided under the [GNU license]
+//
+//  Details: Selects the SSE code paths used by the DSP engines.  Define
+//  ZEN_USE_SSE_INTRINSICS to 0 to force the scalar fallbacks.  Builds that
+//  target AVX2 (/arch:AVX2, -mavx2) also get the AVX paths; define
+//  ZEN_USE_AVX_INTRINSICS to 0 to keep those on SSE.
+//
+//  Zentropia is hosted on Github at [https://github.com/SonicZentropy]
+===============================================================================*/
+
+#ifndef ZEN_SIMD_H_INCLUDED
+#define ZEN_SIMD_H_INCLUDED
+
+#include "JuceHeader.h"
+
+#if JUCE_INTEL && ! defined (ZEN_USE_SSE_INTRINSICS)
+ #define ZEN_USE_SSE_INTRINSICS 1
+#endif
+
+#if ZEN_USE_SSE_INTRINSICS && defined (__AVX2__) && ! defined (ZEN_USE_AVX_INTRINSICS)
+ #define ZEN_USE_AVX_INTRINSICS 1
+#endif
+
+#if ZEN_USE_SSE_INTRINSICS
+ #include <emmintrin.h>
+#endif
+
+#if ZEN_USE_AVX_INTRINSICS
+ #include <immintrin.h>
+#endif
+
+namespace Zen
+{
+
+/// <summary> Rounds a pointer up to the next 16 byte boundary, for aligned SSE loads.
+/// Allocate 3 extra floats to leave room for the shift. </summary>
+inline float* getAligned16(float* data) noexcept
+{
+	return reinterpret_cast<float*>((reinterpret_cast<pointer_sized_int>(data) + 15) & ~static_cast<pointer_sized_int>(15));
+}
+
+/// <summary> Rounds a pointer up to the next 32 byte boundary, for aligned AVX stores.
+/// Allocate 7 extra floats to leave room for the shift. </summary>
+inline float* getAligned32(float* data) noexcept
+{
+	return reinterpret_cast<float*>((reinterpret_cast<pointer_sized_int>(data) + 31) & ~static_cast<pointer_sized_int>(31));
+}
+
+} // namespace Zen
+#endif // ZEN_SIMD_H_INCLUDED